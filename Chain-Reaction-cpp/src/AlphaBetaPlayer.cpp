@@ -0,0 +1,143 @@
+#include "AlphaBetaPlayer.h"
+#include <algorithm>
+
+//*************************************** Public methods ****************************************
+
+AlphaBetaPlayer::AlphaBetaPlayer(unsigned int timeBudgetMilliseconds, size_t transpositionTableBytes, unsigned int maximumDepth) {
+	this->_timeBudget = std::chrono::milliseconds(timeBudgetMilliseconds);
+	this->_maximumDepth = std::max(1u, maximumDepth);
+	//The table size is rounded down to a power of two, so that a hash is mapped to a slot by masking.
+	size_t tableSize = 1;
+	while (2 * tableSize * sizeof(TableEntry) <= transpositionTableBytes) tableSize *= 2;
+	this->_table.assign(tableSize, TableEntry());
+	this->_moveBuffers.resize(this->_maximumDepth + 1);
+}
+bool AlphaBetaPlayer::findMove(const GameEngine& game, uint32_t& cellIndex) {
+	this->_stopRequested.store(false, std::memory_order_relaxed);
+	this->_deadline = std::chrono::steady_clock::now() + this->_timeBudget;
+	this->_nodeCount = 0;
+	this->_completedDepth = 0;
+	this->_searchAborted = false;
+	if (game.hasGameEnded() || game.hasPendingBlast()) return false;
+	GameEngine position = game; //The search plays and undoes moves on its own copy of the position.
+	this->_rootPlayer = position.getCurrentPlayer();
+	//With more than two players the stored scores depend on the team split, hence they cannot be reused for another root player.
+	if (position.getNumberOfPlayers() > 2 && this->_rootPlayer != this->_tablePlayer) std::fill(this->_table.begin(), this->_table.end(), TableEntry());
+	this->_tablePlayer = this->_rootPlayer;
+	const uint32_t cellCount = (uint32_t)position.getBoard().size();
+	for (auto& buffer : this->_moveBuffers) buffer.reserve(cellCount);
+	this->_generateMoves(position, 0, UINT32_MAX);
+	if (this->_moveBuffers[0].empty()) return false;
+	uint32_t bestMove = this->_moveBuffers[0][0].second; //Fallback in case not even the first iteration completes.
+	for (unsigned int depth = 1; depth <= this->_maximumDepth; depth++) {
+		this->_negamax(position, (int)depth, -2 * AlphaBetaPlayer::_WIN_SCORE, 2 * AlphaBetaPlayer::_WIN_SCORE, 0);
+		if (this->_searchAborted) break;
+		const TableEntry& entry = this->_probe(position.getHash());
+		if (entry.key == position.getHash() && entry.move != UINT32_MAX) bestMove = entry.move;
+		this->_completedDepth = depth;
+		//A forced win or loss has been found, searching deeper does not change the result.
+		if (std::abs(entry.score) >= AlphaBetaPlayer::_WIN_SCORE - (int32_t)this->_maximumDepth) break;
+	}
+	cellIndex = bestMove;
+	return true;
+}
+//******************************************* Private methods ************************************
+
+int32_t AlphaBetaPlayer::_evaluate(const GameEngine& game) const {
+	const auto& board = game.getBoard();
+	const unsigned int columns = game.getNumberOfColumns();
+	int32_t score = 0;
+	//Material: every owned cell counts twice as much as a single orb.
+	for (uint8_t player = 0; player < game.getNumberOfPlayers(); player++) {
+		const int32_t material = 2 * (int32_t)game.getCellCount(player) + (int32_t)game.getOrbCount(player);
+		score += this->_isRootTeam(player) ? material : -material;
+	}
+	//Vulnerability: a cell next to an opponent's cell that is one orb short of exploding is likely to be captured.
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) {
+		const auto& cell = board[cellIndex];
+		if (!cell.level || cell.level + 1 != game.getCriticalMass(cellIndex)) continue;
+		const uint32_t x = cellIndex % columns, y = cellIndex / columns;
+		const uint32_t neighbours[4] = { x + 1 < columns ? cellIndex + 1 : UINT32_MAX, x ? cellIndex - 1 : UINT32_MAX, cellIndex + columns < board.size() ? cellIndex + columns : UINT32_MAX, y ? cellIndex - columns : UINT32_MAX };
+		for (const auto& neighbourIndex : neighbours) {
+			if (neighbourIndex == UINT32_MAX || !board[neighbourIndex].level) continue;
+			if (this->_isRootTeam(board[neighbourIndex].owner) != this->_isRootTeam(cell.owner)) score += this->_isRootTeam(cell.owner) ? board[neighbourIndex].level : -(int32_t)board[neighbourIndex].level;
+		}
+	}
+	return this->_isRootTeam(game.getCurrentPlayer()) ? score : -score;
+}
+void AlphaBetaPlayer::_generateMoves(const GameEngine& game, unsigned int ply, uint32_t tableMove) {
+	auto& moves = this->_moveBuffers[ply];
+	moves.clear();
+	const auto& board = game.getBoard();
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) {
+		if (!game.isLegalMove(cellIndex)) continue;
+		//Ordering: best move of the transposition table first, then moves that trigger an explosion, then cells with a lower critical mass (corners and edges).
+		int32_t orderScore = 8 - game.getCriticalMass(cellIndex);
+		if (board[cellIndex].level + 1 >= game.getCriticalMass(cellIndex)) orderScore += 16;
+		if (cellIndex == tableMove) orderScore += 64;
+		moves.push_back({ orderScore, cellIndex });
+	}
+	std::stable_sort(moves.begin(), moves.end(), [](const std::pair<int32_t, uint32_t>& a, const std::pair<int32_t, uint32_t>& b) { return a.first > b.first; });
+}
+int32_t AlphaBetaPlayer::_negamax(GameEngine& game, int depth, int32_t alpha, int32_t beta, unsigned int ply) {
+	if ((++this->_nodeCount & 255) == 0 && this->_shouldAbort()) this->_searchAborted = true;
+	if (this->_searchAborted) return 0;
+	if (game.hasGameEnded()) {
+		const bool rootWins = this->_isRootTeam((uint8_t)(game.getWinnerIndex() - 1));
+		const int32_t score = AlphaBetaPlayer::_WIN_SCORE - (int32_t)ply;
+		return (rootWins == this->_isRootTeam(game.getCurrentPlayer())) ? score : -score;
+	}
+	if (depth <= 0 || ply >= this->_maximumDepth) return this->_evaluate(game);
+	const uint64_t key = game.getHash();
+	const int32_t originalAlpha = alpha;
+	uint32_t tableMove = UINT32_MAX;
+	{
+		const TableEntry& entry = this->_probe(key);
+		if (entry.key == key) {
+			tableMove = entry.move;
+			if (entry.depth >= depth && ply > 0) {
+				if (entry.bound == EXACT) return entry.score;
+				if (entry.bound == LOWER) alpha = std::max(alpha, entry.score);
+				else beta = std::min(beta, entry.score);
+				if (alpha >= beta) return entry.score;
+			}
+		}
+	}
+	this->_generateMoves(game, ply, tableMove);
+	const bool rootTeam = this->_isRootTeam(game.getCurrentPlayer());
+	int32_t bestScore = -2 * AlphaBetaPlayer::_WIN_SCORE;
+	uint32_t bestMove = UINT32_MAX;
+	for (size_t i = 0; i < this->_moveBuffers[ply].size(); i++) {
+		const uint32_t move = this->_moveBuffers[ply][i].second;
+		AlphaBetaPlayer::_playMove(game, move);
+		//Negate the score (and swap the window) only if the next player is on the other team, e.g., not between two opponents of a paranoid search.
+		const int32_t score = (this->_isRootTeam(game.getCurrentPlayer()) == rootTeam) ? this->_negamax(game, depth - 1, alpha, beta, ply + 1) : -this->_negamax(game, depth - 1, -beta, -alpha, ply + 1);
+		game.undo();
+		if (this->_searchAborted) return 0;
+		if (score > bestScore) {
+			bestScore = score;
+			bestMove = move;
+		}
+		if (score > alpha) alpha = score;
+		if (alpha >= beta) break;
+	}
+	TableEntry& entry = this->_probe(key);
+	//Always replace, except for deeper results of the same position.
+	if (entry.key != key || entry.depth <= depth) {
+		entry.key = key;
+		entry.score = bestScore;
+		entry.move = bestMove;
+		entry.depth = (int16_t)depth;
+		entry.bound = bestScore <= originalAlpha ? UPPER : (bestScore >= beta ? LOWER : EXACT);
+	}
+	return bestScore;
+}
+bool AlphaBetaPlayer::_playMove(GameEngine& game, uint32_t cellIndex) {
+	const uint32_t columns = game.getNumberOfColumns();
+	if (!game.processPlayerInput(cellIndex % columns, cellIndex / columns)) return false;
+	game.resolveChainReaction();
+	return true;
+}
+bool AlphaBetaPlayer::_shouldAbort(void) {
+	return this->_stopRequested.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= this->_deadline;
+}
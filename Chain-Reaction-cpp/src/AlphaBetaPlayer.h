@@ -0,0 +1,86 @@
+#pragma once
+#ifndef ALPHA_BETA_PLAYER_H
+#define ALPHA_BETA_PLAYER_H
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ComputerPlayer.h"
+
+/*
+* @brief A computer player based on negamax search with alpha-beta pruning.
+* @brief The search deepens iteratively until the time budget is used up and keeps the best move of the last completed iteration.
+* @brief Moves are ordered by the best move stored in a transposition table (keyed by the Zobrist hash of the position), followed by moves that trigger an explosion.
+* @brief With more than two players the search is paranoid, i.e., all other players are treated as a single opponent of the player who is to move at the root.
+*/
+class AlphaBetaPlayer : public ComputerPlayer {
+public:
+	/*
+	* @param {unsigned int} timeBudgetMilliseconds: time budget of a single search.
+	* @param {size_t} transpositionTableBytes: upper bound of the memory used by the transposition table.
+	* @param {unsigned int} maximumDepth: depth at which iterative deepening stops even if there is time left.
+	*/
+	AlphaBetaPlayer(unsigned int timeBudgetMilliseconds = 1000, size_t transpositionTableBytes = 32 * 1024 * 1024, unsigned int maximumDepth = 64);
+	bool findMove(const GameEngine& game, uint32_t& cellIndex) override;
+	/*
+	* @brief Returns the depth of the last completed iteration of the last search.
+	*/
+	inline unsigned int getCompletedDepth() const { return this->_completedDepth; }
+	/*
+	* @brief Returns the number of positions visited by the last search.
+	*/
+	inline uint64_t getNodeCount() const override { return this->_nodeCount; }
+	inline void setTimeBudget(unsigned int timeBudgetMilliseconds) { this->_timeBudget = std::chrono::milliseconds(timeBudgetMilliseconds); }
+private:
+	/*
+	* @brief Entry of the transposition table.
+	* @brief Member variables:
+	* @brief	1. {uint64_t} key: Zobrist hash of the position.
+	* @brief	2. {int32_t} score: score of the position from the point of view of the player who is to move.
+	* @brief	3. {uint32_t} move: best move found in the position.
+	* @brief	4. {int16_t} depth: remaining search depth for which the score is valid.
+	* @brief	5. {uint8_t} bound: one of EXACT, LOWER, UPPER.
+	*/
+	typedef struct TableEntry {
+		uint64_t key = 0;
+		int32_t score = 0;
+		uint32_t move = UINT32_MAX;
+		int16_t depth = -1;
+		uint8_t bound = 0;
+	} TableEntry;
+	enum { EXACT = 0, LOWER = 1, UPPER = 2 };
+	static const int32_t _WIN_SCORE = 1000000;
+
+	unsigned int _completedDepth = 0;
+	std::chrono::steady_clock::time_point _deadline;
+	unsigned int _maximumDepth;
+	std::vector<std::vector<std::pair<int32_t, uint32_t>>> _moveBuffers; //Preallocated (score, move) list for every ply of the search.
+	uint64_t _nodeCount = 0;
+	uint8_t _rootPlayer = 0;
+	bool _searchAborted = false;
+	std::vector<TableEntry> _table;
+	uint8_t _tablePlayer = UINT8_MAX; //Root player of the search that filled the transposition table.
+	std::chrono::milliseconds _timeBudget;
+
+	/*
+	* @brief Static evaluation of a position from the point of view of the player who is to move.
+	*/
+	int32_t _evaluate(const GameEngine& game) const;
+	/*
+	* @brief Fills the move buffer of a ply with the legal moves of the player who is to move, sorted by their expected quality.
+	*/
+	void _generateMoves(const GameEngine& game, unsigned int ply, uint32_t tableMove);
+	inline bool _isRootTeam(uint8_t player) const { return player == this->_rootPlayer; }
+	int32_t _negamax(GameEngine& game, int depth, int32_t alpha, int32_t beta, unsigned int ply);
+	/*
+	* @brief Applies a move and resolves its chain reaction. Returns false if the move is illegal.
+	*/
+	static bool _playMove(GameEngine& game, uint32_t cellIndex);
+	inline TableEntry& _probe(uint64_t key) { return this->_table[key & (this->_table.size() - 1)]; }
+	/*
+	* @brief Checks the time budget and the stop request. Called regularly during the search.
+	*/
+	bool _shouldAbort(void);
+};
+#endif //!ALPHA_BETA_PLAYER_H
@@ -1,6 +1,9 @@
 #include "PrecompiledHeader.h"
 #include "AppGLCanvas.h"
 #include "MainGame.h"
+#if defined(__WXGTK__)
+#include <dlfcn.h> //The GLX/EGL functions which wxWidgets does not wrap (e.g., swap control) are looked up at runtime.
+#endif
 
 //******************** Public method definitions
 AppGLCanvas::AppGLCanvas(wxWindow* parent, wxSize size, int* attribList) : wxGLCanvas(parent, wxID_ANY, attribList, wxDefaultPosition, size, wxFULL_REPAINT_ON_RESIZE | wxWS_EX_PROCESS_UI_UPDATES) {
@@ -17,10 +20,14 @@ AppGLCanvas::AppGLCanvas(wxWindow* parent, wxSize size, int* attribList) : wxGLC
 	Bind(wxEVT_LEFT_DOWN, &AppGLCanvas::OnMouseEvents, this, wxID_ANY);
 	Bind(wxEVT_KEY_UP, &AppGLCanvas::OnKeyUp, this, wxID_ANY);
 	Bind(wxEVT_SIZE, &AppGLCanvas::OnResize, this, wxID_ANY);
+	this->_frameTimer.SetOwner(this);
+	Bind(wxEVT_TIMER, &AppGLCanvas::OnFrameTimer, this, this->_frameTimer.GetId());
 	wxLogDebug("[Chain-Reaction] Dynamic event-bindings to the wxGLCanvas object is completed ...");
 	//*********************************************************************************************************
 }
 AppGLCanvas::~AppGLCanvas() {
+	this->_stopRenderThread(); //The render thread must not draw on a destroyed window.
+	this->_frameTimer.Stop();
 	wxLogDebug("[Chain-Reaction] Freeing memory allocated to the Mesh (characters) objects ...");
 	ResourceUtilities::clearMeshStorage(this->_characterSet); //Free memory allocated to create Mesh (characters) objects.
 	if (this->_context) {
@@ -34,13 +41,13 @@ void AppGLCanvas::ApplyDefaultCameraSetup(void) {
 		wxLogDebug("[Chain-Reaction] wxGLCanvas task failed. OpenGL context does not exist yet ...");
 		return;
 	}
+	if (!this->_renderThread.joinable()) return; //The size of the canvas is sent once the render thread is started.
 	wxSize size = this->GetClientSize();
-	glViewport(0, 0, (int) this->_contentScalingFactor * size.x, (int) this->_contentScalingFactor * size.y);
-	this->_context->SetCurrent(*this);
-	//******************* Default projection matrix
-	this->defaultProj = glm::perspective((float)glm::radians(45.0f), (float)size.x / size.y, 1.0f, 100.0f);
-	//******************* Default camera view matrix
-	this->_updateCameraView();
+	RenderCommand command;
+	command.type = RenderCommand::RESIZE;
+	command.width = (int)(this->_contentScalingFactor * size.x);
+	command.height = (int)(this->_contentScalingFactor * size.y);
+	this->_postRenderCommand(command); //The viewport, projection matrix and camera view are updated by the render thread.
 }
 bool AppGLCanvas::InitGLEW() {
 	if (this->_isGlewInitialized) return true;
@@ -84,18 +91,31 @@ bool AppGLCanvas::InitOpenGLContext(){
 		this->_context->SetCurrent(*this);
 		this->_contentScalingFactor = this->GetContentScaleFactor();
 		wxLogDebug(wxString::Format("[Chain-Reaction] Pixel scaling factor of the current operating system: %f", this->_contentScalingFactor));
+		this->_mBeginFrame = this->_mLastFrame = std::chrono::steady_clock::now();
 	}
 	return success;
 }
+void AppGLCanvas::OnFrameTimer(wxTimerEvent& event) {
+	wxWakeUpIdle();
+}
 void AppGLCanvas::OnIdle(wxIdleEvent& event) {
-	if (!this->_context) return;
-	unsigned long deltaTime = (this->_mBeginFrame - this->_mLastFrame).ToLong();
-	this->_mBeginFrame = wxGetLocalTimeMillis();
-	unsigned long desiredFrameTime = (1000.0 / FPS_RATE);
-	if (deltaTime < desiredFrameTime) { event.RequestMore(); return; }
-	bool taskCompleted = this->_finishIdleTask(deltaTime);
+	if (!this->_renderThread.joinable()) return; //The application is still loading its resources.
+	this->_mBeginFrame = std::chrono::steady_clock::now();
+	double deltaTime = std::chrono::duration<double, std::milli>(this->_mBeginFrame - this->_mLastFrame).count();
+	//The game loop runs if the scene has changed or the next update of an animated game is due. Otherwise the application waits for the next event
+	//(e.g., the frame timer) instead of spinning. The frames are drawn by the render thread.
+	double updateRate = this->_getUpdateRate();
+	if (!this->_isRedrawRequested && (updateRate <= 0.0 || deltaTime < 1000.0 / updateRate)) {
+		if (this->_scheduleUpdate(updateRate, deltaTime)) event.RequestMore();
+		return;
+	}
+	bool isRedrawRequested = this->_isRedrawRequested;
+	this->_isRedrawRequested = false;
+	//A game which was not animated has not advanced in the meantime, e.g., a blast started by a mouse click begins with the next update.
+	this->_finishIdleTask(updateRate > 0.0 ? (std::min)(deltaTime, AppGLCanvas::_MAX_FRAME_TIME) : 0.0, isRedrawRequested);
 	this->_mLastFrame = this->_mBeginFrame;
-	event.RequestMore();
+	if (this->_isRedrawRequested) event.RequestMore(); //The scene was changed while the game loop was running, e.g., a new game was requested.
+	else if (this->_scheduleUpdate(this->_getUpdateRate(), 0.0)) event.RequestMore();
 }
 void AppGLCanvas::OnKeyUp(wxKeyEvent& event) {
 	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->GetClientData();
@@ -113,9 +133,17 @@ void AppGLCanvas::OnKeyUp(wxKeyEvent& event) {
 		}
 		game->undo();
 		break;
+	case ((int)'R'):
+		if (gameInfo->isOnline) {
+			event.Skip();
+			return;
+		}
+		game->redo();
+		break;
 	default:
 		return;
 	}
+	this->RequestRedraw();
 }
 void AppGLCanvas::OnMouseEvents(wxMouseEvent& event) {
 	if ((event.Entering() || event.ButtonUp()) && this->_mouseCursorHidden) {
@@ -131,7 +159,7 @@ void AppGLCanvas::OnMouseEvents(wxMouseEvent& event) {
 		return;
 	}
 	if (event.Dragging()) { //Handle camera rotation
-		unsigned long delta_t = (this->_mBeginFrame - this->_mLastFrame).ToLong();
+		double delta_t = 1000.0 / this->GetTargetFrameRate(); //The camera turns by the angle of one frame per mouse increment, independently of the rate of mouse events.
 		wxPoint newPos = event.GetPosition();
 		int delta_x = newPos.x - this->_currentMouseX;
 		int delta_y = newPos.y - this->_currentMouseY;
@@ -146,70 +174,69 @@ void AppGLCanvas::OnMouseEvents(wxMouseEvent& event) {
 					SetCursor(myCursor);
 					this->_mouseCursorHidden = true;
 				}
-				this->_updateCameraView();
+				RenderCommand command;
+				command.type = RenderCommand::ROTATE_CAMERA;
+				command.latitude = this->_cameraLatitude;
+				command.longitude = this->_cameraLongitude;
+				this->_postRenderCommand(command);
 			}
 		}
 	}
 }
 void AppGLCanvas::OnPaint(wxPaintEvent& event) {
+	wxPaintDC dc(this); //Validates the exposed area. The frame itself is drawn and presented by the render thread.
 	if (!this->_context){
 		wxLogDebug(wxString::Format("[Chain-Reaction] No OpenGL context was found while processing paint event of wxGLCanvas instance %p ...", this));
 		return;
 	}
-	this->_context->SetCurrent(*this);
-	if (!this->_isGlewInitialized) {//If glew is not initialized yet, try to initialize glew.
-		this->_isGlewInitialized = this->InitGLEW();
-		if (this->_isGlewInitialized) { //Apply some default OpenGL settings
-			glClearColor(0.0, 0.0, 0.0, 0.0);
-			glClearDepth(1.0);
-			glEnable(GL_DEPTH_TEST);
-			glEnable(GL_CULL_FACE);
-			this->_initDefaultVariables();
-			wxLogDebug("[Chain-Reaction] All member variables of wxGLCanvas were successfully initialized ...");
-			glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-		}
-	}
-	if (this->_isPendingResourceData && this->_isGlewInitialized) { //Process pending resource data once glew is initialized.
-		bool success = this->_processPendingResourceData();
-		if (success){
-			this->_isPendingResourceData = false;
-			wxLogDebug("[Chain-Reaction] Updating camera view ...");
-			this->_updateCameraView();
-		}
-	}
-	this->SwapBuffers();
+	if (!this->_renderThread.joinable()) return; //The canvas is drawn once the render thread is started.
+	this->_postRenderCommand(RenderCommand()); //The window was exposed, e.g., after being covered. The frame on screen may be stale.
 }
 void AppGLCanvas::OnResize(wxSizeEvent& event) {
+	this->ApplyDefaultCameraSetup(); //The welcome screen follows the size of the canvas, even while a game is running.
+	this->RequestRedraw();
 	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->GetClientData();
 	if (gameInfo != nullptr) {
-		if (gameInfo->game_started) {
-			if (!gameInfo->isOnline) {
-				MainGame* game = (MainGame*)gameInfo->game;
-				wxSize size = event.GetSize();
-				double scalingFactor = this->GetContentScaleFactor();
-				game->setPixelScaling(scalingFactor);
-				game->setCanvasSize(size.x, size.y);
-				game->setupCamera();
-			}
-		}
-		else {
-			this->ApplyDefaultCameraSetup();
+		if (gameInfo->game_started && !gameInfo->isOnline) {
+			//The camera of the board is published with the next board (see `_offlineGameLoop`).
+			MainGame* game = (MainGame*)gameInfo->game;
+			wxSize size = event.GetSize();
+			double scalingFactor = this->GetContentScaleFactor();
+			game->setPixelScaling(scalingFactor);
+			game->setCanvasSize(size.x, size.y);
+			game->setupCamera();
 		}
 		return;
 	}
 	event.Skip();
 }
+void AppGLCanvas::RequestRedraw(void) {
+	this->_isRedrawRequested = true;
+	wxWakeUpIdle();
+}
 bool AppGLCanvas::SetMouseData(int x, int y, bool userInput) {
 	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->GetClientData();
 	if ((gameInfo != nullptr) && (gameInfo->game_started) && (gameInfo->mouse_data_processed)) {
 		this->_mouseX = x;
 		this->_mouseY = y;
 		gameInfo->mouse_data_processed = false;
+		this->RequestRedraw();
 		return true;
 	}
 	return false;
 }
+void AppGLCanvas::SetRandomGenerator(const RandomGenerator& generator) {
+	if (this->_renderThread.joinable()) {
+		wxLogDebug("[Chain-Reaction] Error: the random number generator of the canvas cannot be replaced while the render thread is running ...");
+		return;
+	}
+	this->_random = generator;
+}
 void AppGLCanvas::SetResourceData(const ResourceUtilities::ResourceData* source) {
+	if (this->_renderThread.joinable()) {
+		wxLogDebug("[Chain-Reaction] Error: resource data cannot be passed to the canvas while the render thread is running ...");
+		return;
+	}
 	for (auto entry : this->_resourceData.listOfObjectFiles) {
 		delete[] entry;
 	}
@@ -242,6 +269,15 @@ void AppGLCanvas::SetResourceData(const ResourceUtilities::ResourceData* source)
 	}
 	this->_isPendingResourceData = true;
 }
+void AppGLCanvas::StartRenderThread(void) {
+	if (this->_renderThread.joinable() || !this->_context) return;
+	//A context can be current on a single thread only, hence the UI thread gives it up for good.
+	if (!this->_releaseCurrentContext()) wxLogDebug("[Chain-Reaction] OpenGL context could not be released from the UI thread ...");
+	wxLogDebug("[Chain-Reaction] Starting the render thread ...");
+	this->_isRenderThreadRunning.store(true);
+	this->_renderThread = std::thread(&AppGLCanvas::_runRenderThread, this);
+	this->ApplyDefaultCameraSetup();
+}
 AppGLContext::AppGLContext(wxGLCanvas* canvas, bool& success) : wxGLContext(canvas) {
 	wxLogDebug(wxString::Format("[Chain-Reaction] Creating OpenGL context on wxGLCanvas instance %p ...", canvas));
 	this->SetCurrent(*canvas);
@@ -254,31 +290,23 @@ void AppGLCanvas::_applyParticleShaderSettings(void) {
 	//Vertex shader for rendering brownian particles
 	wxLogDebug("[Chain-Reaction] Compiling shaders for rendering Brownian particles ...");
 	this->_particleShader.compileShaders(this->_particleShaderVertexSource.c_str(), this->_particleShaderFragmentSource.c_str(), true);
+	this->_particleAngle = this->_particleShader.getUniform("angle");
+	this->_particleModelTransform = this->_particleShader.getUniform("modelTransform");
+	this->_particleColor = this->_particleShader.getUniform("particleColor");
+	this->_particleIsFlickering = this->_particleShader.getUniform("isFlickering");
 	this->_particleShader.use();
 	//Update uniform variable (modelView matrix) in shader
-	GLint location = _particleShader.getUniformLocation("modelTransform");
-	glm::mat4 _model = glm::mat4(1.0f);
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &_model[0][0]);
+	this->_particleModelTransform.set(glm::mat4(1.0f));
 	//**********************************************
 	//Update uniform variable (default color for particles) in shader
-	location = this->_particleShader.getUniformLocation("particleColor");
-	if (location != -1) glUniform4f(location, 1, 1, 0, 1);
-	//**********************************************
-	//Update Lightdirection calculated from latitude and longitude in OpenGL coordinate system
-	glm::vec3 lightDir = this->getGlCompatibleCoordinate(1.0f, this->_lightDirLatitude, this->_lightDirLongitude); //direction determined by lattitude and longitude
-	location = this->_particleShader.getUniformLocation("lightDirection");
-	if (location != -1) glUniform3f(location, lightDir.x, lightDir.y, lightDir.z); //Update uniform variable (lightDirection) in shader
-	//***********************************************
-	//Update camera position 
-	glm::vec3 cameraPosition = this->getGlCompatibleCoordinate(this->_cameraDistance, this->_cameraLatitude, this->_cameraLongitude);
-	location = this->_particleShader.getUniformLocation("cameraPosition");
-	if (location != -1) glUniform3f(location, cameraPosition.x, cameraPosition.y, cameraPosition.z); //Update uniform variable (camera position) in shader
+	this->_particleColor.set(glm::vec4(1.0f, 1.0f, 0.0f, 1.0f));
+	//Projection, camera position and light direction are read from the uniform block FrameState (see `_updateCameraView`).
 	//*************************************************************
 	if (!this->_isPendingResourceData) {
 		this->_particleShader.applyMaterial(this->_resourceData.defaultSphereMaterial, "vDiffuse", "vSpecular", "vSpExp");
 	}
 	else {
-		location = this->_particleShader.getUniformLocation("vDiffuse");
+		GLint location = this->_particleShader.getUniformLocation("vDiffuse");
 		if (location != -1) glUniform3f(location, 0.8f, 0.8f, 0.8f); //Update uniform variable (vDiffuse) in shader
 		location = this->_particleShader.getUniformLocation("vSpecular");
 		if (location != -1) glUniform3f(location, 1.0f, 1.0f, 1.0f); //Update uniform variable (vSpecular) in shader
@@ -288,30 +316,39 @@ void AppGLCanvas::_applyParticleShaderSettings(void) {
 	this->_particleShader.unuse();
 	//***************************************************************************************
 }
+bool AppGLCanvas::_applySwapInterval(int interval) {
+	if (!(this->_context && this->_isGlewInitialized)) return false;
+#if defined(_WIN32)
+	typedef BOOL(WINAPI* SwapIntervalProcedure)(int);
+	SwapIntervalProcedure swapInterval = (SwapIntervalProcedure)wglGetProcAddress("wglSwapIntervalEXT");
+	return swapInterval != nullptr && swapInterval(interval);
+#elif defined(__WXGTK__) && !(defined(wxUSE_GLCANVAS_EGL) && wxUSE_GLCANVAS_EGL)
+	typedef void (*GlxProcedure)(void);
+	typedef GlxProcedure(*GetProcAddressProcedure)(const GLubyte*);
+	typedef int (*SwapIntervalProcedure)(unsigned int);
+	GetProcAddressProcedure getProcAddress = (GetProcAddressProcedure)dlsym(RTLD_DEFAULT, "glXGetProcAddressARB");
+	if (getProcAddress == nullptr || interval < 0) return false;
+	SwapIntervalProcedure swapInterval = (SwapIntervalProcedure)getProcAddress((const GLubyte*)"glXSwapIntervalMESA");
+	if (swapInterval == nullptr && interval > 0) swapInterval = (SwapIntervalProcedure)getProcAddress((const GLubyte*)"glXSwapIntervalSGI"); //GLX_SGI_swap_control cannot disable vsync.
+	return swapInterval != nullptr && swapInterval((unsigned int)interval) == 0;
+#else
+	return false;
+#endif
+}
 void AppGLCanvas::_applyTextShaderSettings(void) {
 
 	//******************************** Text-processsing-shader setup
 	wxLogDebug("[Chain-Reaction] Compiling shaders for rendering 3D texts ...");
 	this->_textShader.compileShaders(this->_textShaderVertexSource.c_str(), this->_textShaderFragmentSource.c_str(), true);
+	this->_textModelTransform = this->_textShader.getUniform("modelTransform");
 	this->_textShader.use();
 	//Update uniform variable (modelView matrix) in shader
-	GLint location = this->_textShader.getUniformLocation("modelTransform");
-	glm::mat4 _model = glm::mat4(1.0f);
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &_model[0][0]);
+	this->_textModelTransform.set(glm::mat4(1.0f));
 	//**************************************************************************
 	//Update uniform variable (angle) in shader
-	location = this->_textShader.getUniformLocation("angle");
+	GLint location = this->_textShader.getUniformLocation("angle");
 	if (location != -1) glUniform1f(location, this->_angle);
-	//****************************************************************************
-	//Update Lightdirection calculated from latitude and longitude in OpenGL coordinate system
-	glm::vec3 lightDir = this->getGlCompatibleCoordinate(1.0f, this->_lightDirLatitude, this->_lightDirLongitude); //direction determined by lattitude and longitude
-	location = this->_textShader.getUniformLocation("lightDirection");
-	if (location != -1) glUniform3f(location, lightDir.x, lightDir.y, lightDir.z); //Update uniform variable (lightDirection) in shader
-	//*******************************************************************************
-	//Update camera position
-	location = this->_textShader.getUniformLocation("cameraPosition");
-	glm::vec3 cameraPosition = this->getGlCompatibleCoordinate(this->_cameraDistance, this->_cameraLatitude, this->_cameraLongitude);
-	if (location != -1) glUniform3f(location, cameraPosition.x, cameraPosition.y, cameraPosition.z); //Update uniform variable (camera position) in shader
+	//Projection, camera position and light direction are read from the uniform block FrameState (see `_updateCameraView`).
 	//*********************************************************************************
 	if (!this->_isPendingResourceData) this->_textShader.applyMaterial(this->_resourceData.defaultSphereMaterial, "vDiffuse", "vSpecular", "vSpExp");
 	else {
@@ -325,25 +362,18 @@ void AppGLCanvas::_applyTextShaderSettings(void) {
 	this->_textShader.unuse();
 	//*****************************************************************************
 }
-bool AppGLCanvas::_finishIdleTask(unsigned long deltaTime) {
-	if (!this->_isGlewInitialized && this->_isPendingResourceData) {
-		this->Refresh();
-		this->Update();
-		return true;
-	}
+bool AppGLCanvas::_finishIdleTask(double deltaTime, bool isRedrawRequested) {
 	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->GetClientData(); //Recover information on the current game state.
 	if (gameInfo == nullptr) {
-		this->_renderDefaultScene(); //This function renders the default background at the start of the application.
-		this->Refresh(true);
+		this->_showScene(nullptr); //The render thread renders the default background at the start of the application.
 		return true;
 	}
 	if (gameInfo->game_started && !(gameInfo->new_game || gameInfo->go_back_main)) {
 		bool completed = false;
 		if (!gameInfo->isOnline) {
 			//An offline game has started. Run main game loop.
-			completed = this->_offlineGameLoop(gameInfo, deltaTime);
+			completed = this->_offlineGameLoop(gameInfo, deltaTime, isRedrawRequested);
 		}
-		if (completed) this->Refresh(true);
 		return completed;
 	}
 	else if (gameInfo->game_started && gameInfo->new_game) {
@@ -354,6 +384,7 @@ bool AppGLCanvas::_finishIdleTask(unsigned long deltaTime) {
 		gameInfo->game_ended = false;
 		gameInfo->mouse_data_processed = true;
 		game->updateTurn();
+		this->_isRedrawRequested = true;
 		return false;
 	}
 	else if (gameInfo->game_started && gameInfo->go_back_main != 0) {
@@ -368,44 +399,47 @@ bool AppGLCanvas::_finishIdleTask(unsigned long deltaTime) {
 			AppGUIFrame* frame = game->getFrame();
 			if (frame != nullptr) frame->ShowGamePanel(false);
 		}
-		this->ApplyDefaultCameraSetup();
+		this->_showScene(nullptr);
 		gameInfo->go_back_main = 0;
+		this->_isRedrawRequested = true;
 		return false;
 	}
 	else {
-		this->_renderDefaultScene(); //This function renders the default background at the start of the application.
-		this->Refresh(true);
+		this->_showScene(nullptr); //The render thread renders the default background at the start of the application.
 		return true;
 	}
 }
+double AppGLCanvas::_getUpdateRate(void) const {
+	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->GetClientData();
+	if (gameInfo == nullptr || !gameInfo->game_started || gameInfo->isOnline) return 0.0; //The welcome screen is animated by the render thread.
+	MainGame* game = (MainGame*)gameInfo->game;
+	if (game == nullptr || !game->isAnimating()) return 0.0; //The orbs of a board are rotated by the render thread.
+	return this->_targetFrameRate.load();
+}
 void AppGLCanvas::_initDefaultVariables(void) {
 	wxLogDebug("[Chain-Reaction] Initializing default variables of wxGLCanvas instance ...");
 	this->_angle = 0.0f;
 	wxLogDebug("[Chain-Reaction] Processing vertex data and shaders for 3D sphere rendering ...");
 	this->_sampleUvSphere.init(0, 0, 0, 1.0f);
-	this->_mouseCursorHidden = false;
-	this->_mouseX = this->_mouseY = 0;
-	this->_mBeginFrame = this->_mLastFrame = wxGetLocalTimeMillis();
 	//************************************************* Particle-data setup *******************
 	this->_skyboxSize = 30.0f; //size of bounding box
 	this->_mNumParticle = 100; //Total number of particles in the bounding box
 	for (unsigned int i = 0; i < this->_mNumParticle; i++) {
 		GameUtilities::Particle entry;
-		entry.position = glm::vec3(this->_skyboxSize * Random::random(-1, 1), this->_skyboxSize * Random::random(-1, 1), this->_skyboxSize * Random::random(-1, 1));
-		entry.color = glm::vec3(Random::random(0, 1), Random::random(0, 1), Random::random(0, 1));
+		entry.position = glm::vec3(this->_skyboxSize * this->_random.random(-1, 1), this->_skyboxSize * this->_random.random(-1, 1), this->_skyboxSize * this->_random.random(-1, 1));
+		entry.color = glm::vec3(this->_random.random(0, 1), this->_random.random(0, 1), this->_random.random(0, 1));
 		entry.level = 1;
-		entry.isFlickering = Random::random(0, 1) > 0.75 ? true : false; // 25% chance that a particle is of flickering type.
+		entry.isFlickering = this->_random.random(0, 1) > 0.75 ? true : false; // 25% chance that a particle is of flickering type.
 		this->_particleData.push_back(entry);
 	}
 	this->_lightDirLatitude = 0.0f;
 	this->_lightDirLongitude = 180.0f;
 	//******************************** Set default camera properties
 	this->_cameraDistance = this->_skyboxSize; //Camera is located at the furthest point of the skybox (which is a sphere).
-	this->_cameraLatitude = 0;
-	this->_cameraLongitude = 0;
+	this->_viewLatitude = 0;
+	this->_viewLongitude = 0;
 	this->_cameraTarget = glm::vec3(0, 0, 0); // looks at origin which is the center of the spherical skybox.
 	this->_cameraUp = glm::vec3(0, 1, 0);
-	this->_cameraRotationSpeed = 360.0f;
 	//******************************** Apply default shader settings for particle rendering
 	wxLogDebug("[Chain-Reaction] Processing shader-settings for rendering Brownian particles ...");
 	this->_applyParticleShaderSettings();
@@ -414,36 +448,75 @@ void AppGLCanvas::_initDefaultVariables(void) {
 	wxLogDebug("[Chain-Reaction] Processing shader-settings for rendering 3D texts ...");
 	this->_applyTextShaderSettings();
 	//******************************** Light direction specification
-	//************* Apply default camera settings
-	this->ApplyDefaultCameraSetup();
+	//************* Apply default camera settings. The projection matrix follows once the size of the canvas is received (see `ApplyDefaultCameraSetup`).
+	this->_updateCameraView(this->_viewLatitude, this->_viewLongitude);
 	//*******************************************************************
 }
-bool AppGLCanvas::_offlineGameLoop(GameUtilities::GameState* gameInfo, unsigned long deltaTime) {
+bool AppGLCanvas::_initRendering(void) {
+	if (!this->InitGLEW()) return false;
+	//Apply some default OpenGL settings
+	glClearColor(0.0, 0.0, 0.0, 0.0);
+	glClearDepth(1.0);
+	glEnable(GL_DEPTH_TEST);
+	glEnable(GL_CULL_FACE);
+	if (!this->_applySwapInterval(this->_swapInterval.load())) wxLogDebug("[Chain-Reaction] Swap interval of the OpenGL context could not be set. Frames are paced by the render thread only ...");
+	this->_initDefaultVariables();
+	wxLogDebug("[Chain-Reaction] All member variables of wxGLCanvas were successfully initialized ...");
+	if (this->_isPendingResourceData && this->_processPendingResourceData()) { //Process pending resource data once glew is initialized.
+		this->_isPendingResourceData = false;
+		wxLogDebug("[Chain-Reaction] Updating camera view ...");
+		this->_updateCameraView(this->_viewLatitude, this->_viewLongitude);
+	}
+	this->_isRenderingReady.store(!this->_isPendingResourceData, std::memory_order_release);
+	return true;
+}
+bool AppGLCanvas::_offlineGameLoop(GameUtilities::GameState* gameInfo, double deltaTime, bool isRedrawRequested) {
 	MainGame* game = (MainGame*)gameInfo->game;
 	if (!gameInfo->game_ended) {
 		bool isInputProcessedByGame = false;
 		if (!gameInfo->mouse_data_processed) {
 			glm::vec2 boardCoordinate = game->getBoardCoordinates(this->_mouseX, this->_mouseY);
-			if (boardCoordinate.x >= 0 && boardCoordinate.y >= 0) {
+			//Mouse inputs are ignored while a computer player is to move.
+			if (boardCoordinate.x >= 0 && boardCoordinate.y >= 0 && !game->isComputerTurn()) {
 				isInputProcessedByGame = game->processPlayerInput((uint32_t)boardCoordinate.x, (uint32_t)boardCoordinate.y);
 			}
 			gameInfo->mouse_data_processed = true;
 		}
-		bool gameHasEnded = game->drawBoard(deltaTime);
+		if (!isInputProcessedByGame) isInputProcessedByGame = game->updateComputerPlayer();
+		bool gameHasEnded = game->updateBoard(deltaTime);
+		//The board is published only if it has changed, i.e., once per blast wave and not while a computer player is searching. The render thread is woken up
+		//for a changed scene; while a blast is running, it moves the orbs on and redraws the board at the full frame rate anyway.
+		const bool isRedrawNeeded = isRedrawRequested || isInputProcessedByGame || gameHasEnded;
+		if (isRedrawNeeded || game->hasUnpublishedBoard()) game->publishBoard();
+		this->_showScene(game);
+		if (isRedrawNeeded) this->_postRenderCommand(RenderCommand());
 		if (gameHasEnded) {
+			//Idle events of the message box below must not run the game loop again. The render thread keeps drawing the final board while the winner is announced.
+			gameInfo->game_ended = true;
 			unsigned int winnerIndex = game->getWinnerIndex();
 			const char* winnerName = game->getWinnerName();
 			wxMessageBox(wxString::Format("Player %d (%s) won! Game Over!", winnerIndex, winnerName), wxT("Information"), wxOK | wxICON_EXCLAMATION);
+			game->resetGameVariables();
 			gameInfo->game_started = false;
-			gameInfo->game_ended = true;
 			AppGUIFrame* frame = game->getFrame();
 			if (frame != nullptr) frame->ShowGamePanel(false);
-			this->ApplyDefaultCameraSetup();
+			this->_showScene(nullptr);
 			return false;
 		}
 	}
 	return true;
 }
+void AppGLCanvas::_postRenderCommand(const RenderCommand& command) {
+	while (!this->_renderCommands.push(command)) {
+		if (!this->_isRenderThreadRunning.load()) { //Nobody takes commands off the queue.
+			wxLogDebug("[Chain-Reaction] Error: the render thread is not running and its command queue is full. The command is dropped ...");
+			return;
+		}
+		this->_wakeRenderThread();
+		std::this_thread::yield();
+	}
+	this->_wakeRenderThread();
+}
 bool AppGLCanvas::_processPendingResourceData(void) {
 	if (!this->_isGlewInitialized) return false; //If glew is not yet initialized, abort further resource processing.
 	wxLogDebug("[Chain-Reaction] Processing extracted resource files to upload in GPU and initializing shaders ...");
@@ -461,7 +534,7 @@ bool AppGLCanvas::_processPendingResourceData(void) {
 		bool meshLoadSuccess = mesh->LoadFromMemory((unsigned char*)entryData->data, entryData->size);
 		std::string meshName = fileName.substr(0, fileName.size() - 4); //Get the file name without extension.
 		if (!meshLoadSuccess) { //MeshData conversion failed. Handle error.
-			wxMessageBox(wxT("Could not parse 'obj' data! Mesh loading failed."), wxT("Mesh loading Error"), wxOK | wxICON_ERROR);
+			wxLogError(wxT("Could not parse 'obj' data! Mesh loading failed.")); //Message boxes can only be shown on the UI thread, which flushes the log.
 			//********** Delete previously allocated memory ****************
 			delete mesh;
 			//*************************************************************
@@ -480,43 +553,168 @@ bool AppGLCanvas::_processPendingResourceData(void) {
 	wxLogDebug("[Chain-Reaction] All resources were successfully processed ...");
 	return true;
 }
+bool AppGLCanvas::_releaseCurrentContext(void) {
+#if defined(_WIN32)
+	return wglMakeCurrent(NULL, NULL) == TRUE;
+#elif defined(__WXGTK__) && !(defined(wxUSE_GLCANVAS_EGL) && wxUSE_GLCANVAS_EGL)
+	typedef void* (*GetCurrentDisplayProcedure)(void);
+	typedef int (*MakeCurrentProcedure)(void*, unsigned long, void*);
+	GetCurrentDisplayProcedure getCurrentDisplay = (GetCurrentDisplayProcedure)dlsym(RTLD_DEFAULT, "glXGetCurrentDisplay");
+	MakeCurrentProcedure makeCurrent = (MakeCurrentProcedure)dlsym(RTLD_DEFAULT, "glXMakeCurrent");
+	if (getCurrentDisplay == nullptr || makeCurrent == nullptr) return false;
+	void* display = getCurrentDisplay();
+	return display == nullptr || makeCurrent(display, 0, nullptr) != 0; //No display means that no context is current.
+#elif defined(__WXGTK__)
+	typedef void* (*GetCurrentDisplayProcedure)(void);
+	typedef unsigned int (*MakeCurrentProcedure)(void*, void*, void*, void*);
+	GetCurrentDisplayProcedure getCurrentDisplay = (GetCurrentDisplayProcedure)dlsym(RTLD_DEFAULT, "eglGetCurrentDisplay");
+	MakeCurrentProcedure makeCurrent = (MakeCurrentProcedure)dlsym(RTLD_DEFAULT, "eglMakeCurrent");
+	if (getCurrentDisplay == nullptr || makeCurrent == nullptr) return false;
+	void* display = getCurrentDisplay();
+	return display == nullptr || makeCurrent(display, nullptr, nullptr, nullptr) != 0; //EGL_NO_SURFACE and EGL_NO_CONTEXT
+#else
+	return false; //Other platforms (e.g., macOS) allow making the context current on another thread without releasing it.
+#endif
+}
 void AppGLCanvas::_renderDefaultScene(void) {
+	glViewport(0, 0, this->_viewportSize[0], this->_viewportSize[1]); //The viewport is shared with the scene of the game board.
+	this->_frameStateBuffer.bindBase(Shaders::FRAME_STATE_BINDING); //The binding point is shared with the scene of the game board.
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); //Clear color and depth buffer before rendering new frame.
 	this->_angle = (this->_angle + 1) % 360; //Increase global angle variable
 	//*************************** Draw background text
 
 	if (this->_textObject.get()) {
 		this->_textShader.use();
-		GLint location = this->_textShader.getUniformLocation("modelTransform");
-		if (location != -1) this->_textObject->DrawLine(this->_textShader, location, "WELCOME TO THE WORLD\nOF\nCHAIN REACTION", glm::vec3(0, 0, 0), glm::vec3(0, (float)this->_angle, 0), "center", "center");
+		if (this->_textModelTransform.isActive()) this->_textObject->DrawLine(this->_textShader, this->_textModelTransform.getLocation(), "WELCOME TO THE WORLD\nOF\nCHAIN REACTION", glm::vec3(0, 0, 0), glm::vec3(0, (float)this->_angle, 0), "center", "center");
 		this->_textShader.unuse();
 	}//***************************
 
 	//*************************** Draw brownian particles
 	this->_particleShader.use();
-	GLint location = this->_particleShader.getUniformLocation("angle");
-	if (location != -1) glUniform1f(location, this->_angle);
+	this->_particleAngle.set((GLfloat)this->_angle);
 	this->_updateBrownianParticleMotion();
 }
+void AppGLCanvas::_runRenderThread(void) {
+	this->_context->SetCurrent(*this);
+	if (!this->_initRendering()) {
+		wxLogDebug("[Chain-Reaction] Error: the render thread could not initialize the OpenGL context. No frames are drawn ...");
+		this->_isRenderThreadRunning.store(false);
+		this->_releaseGraphics({});
+		this->_releaseCurrentContext();
+		return;
+	}
+	MainGame* game = nullptr; //Game object whose published boards are drawn, or null for the welcome screen.
+	std::vector<MainGame*> drawnGames; //Game objects which hold OpenGL objects of this context.
+	int swapInterval = this->_swapInterval.load();
+	double frameRate = 0.0; //Frame rate which the scene drawn last needs.
+	bool isRedrawRequested = true;
+	std::chrono::steady_clock::time_point lastFrame = std::chrono::steady_clock::now();
+	while (this->_isRenderThreadRunning.load(std::memory_order_acquire)) {
+		RenderCommand command;
+		while (this->_renderCommands.pop(command)) {
+			switch (command.type) {
+			case RenderCommand::RESIZE:
+				this->_viewportSize[0] = command.width;
+				this->_viewportSize[1] = command.height;
+				if (command.height > 0) this->defaultProj = glm::perspective((float)glm::radians(45.0f), (float)command.width / command.height, 1.0f, 100.0f);
+				this->_updateCameraView(this->_viewLatitude, this->_viewLongitude);
+				break;
+			case RenderCommand::ROTATE_CAMERA:
+				this->_updateCameraView(command.latitude, command.longitude);
+				break;
+			case RenderCommand::SHOW_BOARD:
+				game = command.game;
+				if (game != nullptr && std::find(drawnGames.begin(), drawnGames.end(), game) == drawnGames.end()) drawnGames.push_back(game);
+				break;
+			case RenderCommand::SHOW_WELCOME_SCREEN:
+				game = nullptr;
+				break;
+			default:
+				break;
+			}
+			isRedrawRequested = true;
+		}
+		if (swapInterval != this->_swapInterval.load()) {
+			swapInterval = this->_swapInterval.load();
+			if (!this->_applySwapInterval(swapInterval)) wxLogDebug("[Chain-Reaction] Swap interval of the OpenGL context could not be set. Frames are paced by the render thread only ...");
+		}
+		std::chrono::steady_clock::time_point beginFrame = std::chrono::steady_clock::now();
+		double deltaTime = std::chrono::duration<double, std::milli>(beginFrame - lastFrame).count();
+		if (isRedrawRequested || (frameRate > 0.0 && deltaTime >= 1000.0 / frameRate)) {
+			isRedrawRequested = false;
+			if (game != nullptr) {
+				MainGame::BoardMotion motion = game->drawBoard((std::min)(deltaTime, AppGLCanvas::_MAX_FRAME_TIME));
+				if (motion == MainGame::RUNNING_BLAST) frameRate = this->_targetFrameRate.load();
+				else if (motion == MainGame::ROTATING_ORBS) frameRate = this->_idleFrameRate.load();
+				else frameRate = 0.0;
+			}
+			else {
+				this->_renderDefaultScene();
+				frameRate = this->_targetFrameRate.load();
+			}
+			this->SwapBuffers(); //With vsync, the swap waits for the display, which paces the frames.
+			lastFrame = beginFrame;
+		}
+		//Waits until the next frame is due or, for a static scene, until the UI thread sends a command.
+		bool isWokenUp = true;
+		if (frameRate > 0.0) isWokenUp = this->_renderWakeUp.try_acquire_until(lastFrame + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<double, std::milli>(1000.0 / frameRate)));
+		else this->_renderWakeUp.acquire();
+		if (isWokenUp) this->_isRenderWakeUpPending.store(false); //The commands sent from now on wake up the next wait.
+	}
+	this->_releaseGraphics(drawnGames);
+	this->_releaseCurrentContext();
+}
+void AppGLCanvas::_releaseGraphics(const std::vector<MainGame*>& games) {
+	//The OpenGL objects are freed while the context is still current on the render thread, as the destructors of their owners run without a current context.
+	for (MainGame* game : games) game->releaseGraphics();
+	this->_textObject.reset();
+	ResourceUtilities::clearMeshStorage(this->_characterSet);
+	this->_sampleUvSphere.deleteBuffers();
+	this->_sampleIcoSphere.deleteBuffers();
+	this->_textShader.deleteProgram();
+	this->_particleShader.deleteProgram();
+	this->_frameStateBuffer.deleteBuffer();
+}
+bool AppGLCanvas::_scheduleUpdate(double updateRate, double elapsedTime) {
+	if (updateRate <= 0.0) {
+		this->_frameTimer.Stop();
+		return false;
+	}
+	double remainingTime = 1000.0 / updateRate - elapsedTime;
+	if (remainingTime < 1.0) return true;
+	this->_frameTimer.StartOnce((int)remainingTime); //Rounded down, hence the timer never fires late because of rounding.
+	return false;
+}
+void AppGLCanvas::_showScene(MainGame* game) {
+	if (game == this->_shownGame) return;
+	this->_shownGame = game;
+	RenderCommand command;
+	command.type = game ? RenderCommand::SHOW_BOARD : RenderCommand::SHOW_WELCOME_SCREEN;
+	command.game = game;
+	this->_postRenderCommand(command);
+}
+void AppGLCanvas::_stopRenderThread(void) {
+	if (!this->_renderThread.joinable()) return;
+	wxLogDebug("[Chain-Reaction] Stopping the render thread ...");
+	this->_isRenderThreadRunning.store(false, std::memory_order_release);
+	this->_wakeRenderThread();
+	this->_renderThread.join();
+}
 void AppGLCanvas::_updateBrownianParticleMotion(void) {
 	//***************** Draw brownian particles
-	GLint location = this->_particleShader.getUniformLocation("modelTransform");
-	GLint colorLocation = this->_particleShader.getUniformLocation("particleColor");
-	GLint flickeringLocation = this->_particleShader.getUniformLocation("isFlickering");
 	for (unsigned int i = 0; i < this->_mNumParticle; i++) {
-		glm::mat4 model = glm::translate(glm::mat4(1.0f), this->_particleData[i].position);
-		if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &model[0][0]);
-		if (flickeringLocation != -1) glUniform1f(flickeringLocation, this->_particleData[i].isFlickering ? 1.0f : 0.0f);
-		if (colorLocation != -1) glUniform4f(colorLocation, this->_particleData[i].color.r, this->_particleData[i].color.g, this->_particleData[i].color.b, 1.0f);
+		this->_particleModelTransform.set(glm::translate(glm::mat4(1.0f), this->_particleData[i].position));
+		this->_particleIsFlickering.set(this->_particleData[i].isFlickering ? 1.0f : 0.0f);
+		this->_particleColor.set(glm::vec4(this->_particleData[i].color, 1.0f));
 		this->_sampleUvSphere.draw(this->_particleData[i].level);
 		float radius = this->_sampleUvSphere.getRadius();
 		float distance = glm::length(this->_particleData[i].position);
 		if (distance < this->_skyboxSize - radius) {
-			float dx = 0.2 * Random::random(-1, 1);
+			float dx = 0.2 * this->_random.random(-1, 1);
 			this->_particleData[i].position.x += dx;
-			float dy = 0.2 * Random::random(-1, 1);
+			float dy = 0.2 * this->_random.random(-1, 1);
 			this->_particleData[i].position.y += dy;
-			float dz = 0.2 * Random::random(-1, 1);
+			float dz = 0.2 * this->_random.random(-1, 1);
 			this->_particleData[i].position.z += dz;
 		}
 		else {
@@ -526,22 +724,20 @@ void AppGLCanvas::_updateBrownianParticleMotion(void) {
 	this->_particleShader.unuse();
 	///////////////////
 }
-void AppGLCanvas::_updateCameraView(void) {
-	glm::vec3 cameraPosition = this->getGlCompatibleCoordinate(this->_cameraDistance, this->_cameraLatitude, this->_cameraLongitude);
+void AppGLCanvas::_updateCameraView(float latitude, float longitude) {
+	this->_viewLatitude = latitude;
+	this->_viewLongitude = longitude;
+	glm::vec3 cameraPosition = this->getGlCompatibleCoordinate(this->_cameraDistance, latitude, longitude);
 	this->defaultView = glm::lookAt(cameraPosition, this->_cameraTarget, this->_cameraUp);
 	glm::mat4 final_mat = this->defaultProj * this->defaultView;
 	if (this->_isGlewInitialized){
-		this->_textShader.use();
-		GLint location = this->_textShader.getUniformLocation("projectionView");
-		if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &final_mat[0][0]);
-		location = this->_textShader.getUniformLocation("cameraPosition");
-		if (location != -1) glUniform3f(location, cameraPosition.x, cameraPosition.y, cameraPosition.z); //Update uniform variable (camera position) in shader
-		this->_textShader.unuse();
-		this->_particleShader.use();
-		location = this->_particleShader.getUniformLocation("projectionView");
-		if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &final_mat[0][0]);
-		location = this->_particleShader.getUniformLocation("cameraPosition");
-		if (location != -1) glUniform3f(location, cameraPosition.x, cameraPosition.y, cameraPosition.z); //Update uniform variable (camera position) in shader
-		this->_particleShader.unuse();
+		//A single upload serves the text and particle shaders.
+		this->_frameState.projectionView = final_mat;
+		this->_frameState.cameraPosition = cameraPosition;
+		this->_frameState.lightDirection = this->getGlCompatibleCoordinate(1.0f, this->_lightDirLatitude, this->_lightDirLongitude); //direction determined by lattitude and longitude
+		this->_frameStateBuffer.loadData(&this->_frameState, sizeof(Shaders::FrameState));
 	}
 }
+void AppGLCanvas::_wakeRenderThread(void) {
+	if (!this->_isRenderWakeUpPending.exchange(true)) this->_renderWakeUp.release(); //The semaphore is binary, hence it must not be released twice.
+}
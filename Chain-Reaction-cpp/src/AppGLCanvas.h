@@ -7,7 +7,26 @@
 #include "Utilities.h"
 #include "UvSphere.h"
 #include "IcoSphere.h"
+#include "RandomGenerator.h"
+#include "UniformBufferObject.h"
+#include "LockFreeQueue.h"
 
+class MainGame;
+/*
+* @brief A command which the UI thread sends to the render thread of an AppGLCanvas through a lock-free queue.
+*/
+typedef struct RenderCommand {
+	enum Type {
+		REDRAW = 0, //The scene has changed, e.g., a new board was published.
+		RESIZE, //The canvas was resized.
+		ROTATE_CAMERA, //The camera of the welcome screen was moved.
+		SHOW_BOARD, //The published boards of a game are drawn from now on.
+		SHOW_WELCOME_SCREEN //The welcome screen is drawn from now on.
+	} type = REDRAW;
+	MainGame* game = nullptr; //SHOW_BOARD: game object whose boards are drawn.
+	int width = 0, height = 0; //RESIZE: size (in pixels) of the viewport.
+	float latitude = 0.0f, longitude = 0.0f; //ROTATE_CAMERA: location (in degree) of the camera.
+} RenderCommand;
 /*
 * @brief A class to obtain the OpenGL context in a wxGLCanvas. It is derived from the base class wxGLContext.
 */
@@ -22,6 +41,9 @@ public:
 };
 /*
 * @brief A class representing the canvas instance used for OpenGL rendering. It is derived from the baseclass wxGLCanvas.
+* @brief Frames are drawn and presented by a render thread which owns the OpenGL context. The UI thread runs the game loop in idle time and feeds the render thread
+* @brief through a lock-free command queue (e.g., resizes, camera moves) and the boards published by the game object. Hence neither thread waits for the other,
+* @brief and a busy or blocked UI thread (e.g., by a modal dialog) does not stall the frames.
 */
 class AppGLCanvas : public wxGLCanvas {
 public:
@@ -34,27 +56,35 @@ public:
 	AppGLCanvas(wxWindow* parent, wxSize size = wxSize(1200, 1200), int* attribList = NULL);
 	/*
 	* @brief Resets the camera configurations (i.e., viewport, camera location, camera direction, lights, projection matrix, etc.)
-	* of the openGL context.
+	* of the welcome screen to the current size of the canvas. They are applied by the render thread.
 	*/
 	void ApplyDefaultCameraSetup(void);
-	inline bool IsCanvasReadyForRendering(void) const { return (this->_isGlewInitialized && !(this->_isPendingResourceData)); }
+	/*
+	* @brief Checks whether or not the render thread has initialized the OpenGL context and processed the resource data.
+	*/
+	inline bool IsCanvasReadyForRendering(void) const { return this->_isRenderingReady.load(std::memory_order_acquire); }
 	/**
-	* @brief Initializes GLEW library.
+	* @brief Initializes GLEW library. Must be called on the render thread.
 	* @returns {bool} true if GLEW is successfully initialized, false otherwise.
 	*/
 	bool InitGLEW();
 	/**
-	* @brief Initializes OpenGL context on this wxGLCanvas.
+	* @brief Initializes OpenGL context on this wxGLCanvas. The context is handed over to the render thread (see `StartRenderThread`).
 	* @returns {bool} true if OpenGL context is successfully created, false otherwise.
 	*/
 	bool InitOpenGLContext();
 	/**
 	* @brief Handles IDLE events of AppGLCanvas instance and is responsible for maintaining communication between the main game loop
-	* @brief of the application and the GUI events of the canvas instance.
+	* @brief of the application and the GUI events of the canvas instance. The game loop publishes the board, which is drawn by the render thread.
 	* @param[out] {wxIdleEvent&} event: a reference to the idle event information provided by the canvas instance.
 	*/
 	void OnIdle(wxIdleEvent& event);
 	/*
+	* @brief Handles the frame timer, which wakes up the idle loop shortly before the next update of an animated game is due (see `AppGLCanvas::OnIdle`).
+	* @param[out] {wxTimerEvent&} event: a reference to the timer event information.
+	*/
+	void OnFrameTimer(wxTimerEvent& event);
+	/*
 	* @brief Handles key up events of AppGLCanvas instance. If there is a game running, updates the game state according to the input key.
 	* @param[out] {wxKeyEvent&} event: a reference to the key event information provided by the canvas instance.
 	* @see  AppGLCanvas::OnIdle
@@ -69,12 +99,34 @@ public:
 	*/
 	void OnMouseEvents(wxMouseEvent& event);
 	/*
-	* @brief Handles paint event of the AppGLCanvas instance and maintains fixed frame rate.
+	* @brief Handles paint event of the AppGLCanvas instance. The exposed canvas is redrawn by the render thread.
 	* @param[out] {wxPainEvent&} event: a reference to the paint event information provided by the canvas instance.
 	*/
 	void OnPaint(wxPaintEvent& event);
 	void OnResize(wxSizeEvent& event);
 	/*
+	* @brief Marks the scene as changed, hence the game loop publishes the board and the render thread redraws it as soon as the application is idle.
+	* Between such requests a static board is only redrawn at the idle frame rate (see `SetIdleFrameRate`).
+	*/
+	void RequestRedraw(void);
+	/*
+	* @brief Sets the frame rate at which the rotating orbs of a board are redrawn while no blast animation is running. Value 0 redraws a board only on request.
+	* @param {double} frameRate: frames per second.
+	*/
+	inline void SetIdleFrameRate(double frameRate) { this->_idleFrameRate.store((std::max)(frameRate, 0.0)); this->_wakeRenderThread(); }
+	/*
+	* @brief Sets the swap interval (i.e., number of vertical blanks per buffer swap) of the OpenGL context. Value 1 synchronizes the buffer swaps with the display (vsync), value 0 disables it.
+	* It is applied by the render thread through the WGL/GLX swap-control extension; if the platform does not support it, frames are paced by the render thread only.
+	* @param {int} interval: swap interval.
+	*/
+	inline void SetSwapInterval(int interval) { this->_swapInterval.store(interval); this->_wakeRenderThread(); }
+	/*
+	* @brief Sets the frame rate of the welcome screen and of running animations. The display may cap it when the buffer swaps are synchronized (see `SetSwapInterval`).
+	* @param {double} frameRate: frames per second. It must be positive.
+	*/
+	inline void SetTargetFrameRate(double frameRate) { if (frameRate > 0.0) { this->_targetFrameRate.store(frameRate); this->_wakeRenderThread(); } }
+	inline double GetTargetFrameRate(void) const { return this->_targetFrameRate.load(); }
+	/*
 	* @brief Registers the mouse input data (position) for further processing in idle time is eventually passed on to the
 	* @brief game object (take a look at `AppGLCanvas::OnIdle` method).
 	* @param {int} x: x-coordinate of the mouse pointer in AppGLCanvas (measured w.r.t. the canvas area: topleft of the AppGLCanvas is (0,0)).
@@ -83,44 +135,77 @@ public:
 	*/
 	bool SetMouseData(int x, int y, bool userInput = true);
 	/*
+	* @brief Replaces the random number generator which drives the Brownian motion of the background particles, e.g., with a seeded one for reproducible rendering.
+	* @brief The generator is used by the render thread, hence it must be replaced before the render thread is started (see `StartRenderThread`).
+	*/
+	void SetRandomGenerator(const RandomGenerator& generator);
+	/*
 	* @brief Stores the resource data passed by `OnInit` method of the application instance to a member variable for further usage.
+	* @brief The data is processed by the render thread, hence it must be passed before the render thread is started (see `StartRenderThread`).
 	* @param {const ResourceData*} source: pointer to the resource data.
 	*/
 	void SetResourceData(const ResourceUtilities::ResourceData* source);
 	/*
-	* @brief Stores the current projection matrix.
+	* @brief Starts the render thread, unless it is running already. The OpenGL context is released from the UI thread beforehand, hence
+	* @brief nothing is drawn on the canvas before this call. Must be called after the resource data was passed (see `SetResourceData`).
+	*/
+	void StartRenderThread(void);
+	/*
+	* @brief Stores the current projection matrix of the welcome screen. Only used by the render thread.
 	*/
 	glm::mat4 defaultProj = glm::mat4(1.0f);
 	/*
-	* @brief Stores the current view matrix.
+	* @brief Stores the current view matrix of the welcome screen. Only used by the render thread.
 	*/
 	glm::mat4 defaultView = glm::mat4(1.0f);
 	inline glm::vec3 getGlCompatibleCoordinate(float radius, float latitudeDegree, float longitudeDegree) { return glm::vec3({ radius * sin(glm::radians(longitudeDegree)) * cos(glm::radians(latitudeDegree)), radius * sin(glm::radians(latitudeDegree)), radius * cos(glm::radians(longitudeDegree)) * cos(glm::radians(latitudeDegree)) }); }
 
 private:
-	int _angle = 0;
+	//********************* Members of the UI thread
 	double _contentScalingFactor = 1.0;
-	bool _isGlewInitialized = false;
-	bool _isPendingResourceData = false;
 	bool _mouseCursorHidden = false;
 	int _mouseX = 0, _mouseY = 0;
 	float _currentMouseX = 0, _currentMouseY = 0;
+	float _cameraLatitude = 0; //latitude (measured in degree) of the camera location. It is sent to the render thread whenever the camera is dragged.
+	float _cameraLongitude = 0; //longitude (measured in degree) of the camera location. It is sent to the render thread whenever the camera is dragged.
+	float _cameraRotationSpeed = 360.0f; //Speed (degree / mouse_increment / sec) at which camera rotates while dragging mouse pointer.
+	std::chrono::steady_clock::time_point _mBeginFrame, _mLastFrame; //Start time of the current and of the last update of the game loop.
+	wxTimer _frameTimer; //Wakes up the idle loop shortly before the next update of an animated game is due.
+	bool _isRedrawRequested = true; //Whether or not the scene has changed since the game loop was run last.
+	MainGame* _shownGame = nullptr; //Game object whose boards the render thread was told to draw, or null for the welcome screen.
+	static constexpr double _MAX_FRAME_TIME = 250.0; //Upper bound (in milliseconds) of the time step of an animation, e.g., for the first frame after the canvas has been waiting for events.
+	AppGLContext* _context = nullptr;
+	//********************* Members shared between the UI thread and the render thread
+	LockFreeQueue<RenderCommand, 256> _renderCommands; //Commands from the UI thread (producer) to the render thread (consumer).
+	std::thread _renderThread; //Thread which owns the OpenGL context and draws the frames (see `_runRenderThread`).
+	std::atomic<bool> _isRenderThreadRunning = false; //Cleared by the UI thread for stopping the render thread.
+	std::atomic<bool> _isRenderingReady = false; //Set by the render thread once the OpenGL context and the resource data are ready.
+	std::binary_semaphore _renderWakeUp{ 0 }; //Wakes up the render thread while it waits for the next frame or command.
+	std::atomic<bool> _isRenderWakeUpPending = false; //Whether or not _renderWakeUp was released and not yet acquired. It prevents releasing the semaphore twice.
+	std::atomic<double> _idleFrameRate = 10.0; //Frame rate (frames per second) of a board whose orbs only rotate.
+	std::atomic<double> _targetFrameRate = 60.0; //Frame rate (frames per second) of the welcome screen and of running animations.
+	std::atomic<int> _swapInterval = 1; //Swap interval that is applied by the render thread (see `SetSwapInterval`).
+	//********************* Members of the render thread
+	int _angle = 0;
+	bool _isGlewInitialized = false;
+	bool _isPendingResourceData = false;
 	float _cameraDistance = 30.0f;
-	float _cameraLatitude = 0; //latitude (measured in degree) of the camera location.
-	float _cameraLongitude = 0; //longitude (measured in degree) of the camera location.
+	float _viewLatitude = 0, _viewLongitude = 0; //Location (in degree) of the camera which the welcome screen is drawn from.
+	int _viewportSize[2] = { 0, 0 }; //Size (in pixels) of the viewport of the welcome screen.
 	glm::vec3 _cameraTarget = glm::vec3(0, 0, 0);
 	glm::vec3 _cameraUp = glm::vec3(0, 1, 0);
-	float _cameraRotationSpeed = 1.0f; //Speed (degree / mouse_increment / sec) at which camera rotates while dragging mouse pointer.
 	GLfloat _lightDirLatitude = -10.0f;
 	GLfloat _lightDirLongitude = 0.0f;
 	unsigned int _mNumParticle = 0;
 	float _skyboxSize = 10.0f;
 	UvSphere _sampleUvSphere;
 	IcoSphere _sampleIcoSphere;
-	wxLongLong _mBeginFrame = 0, _mLastFrame = 0;
 	ResourceUtilities::ResourceData _resourceData;
-	AppGLContext* _context = nullptr;
 	Shaders _textShader, _particleShader;
+	Shaders::Uniform _textModelTransform; //Uniforms of the text shader, resolved whenever it is compiled.
+	Shaders::Uniform _particleAngle, _particleModelTransform, _particleColor, _particleIsFlickering; //Uniforms of the particle shader, resolved whenever it is compiled.
+	Shaders::FrameState _frameState; //Camera and light of the welcome screen, shared by the text and particle shaders.
+	UniformBufferObject _frameStateBuffer; //Uniform buffer holding _frameState. It is updated whenever the camera changes.
 	std::shared_ptr<Text> _textObject; //Pointer to the text object which is used for rendering 3D text.
 	std::unordered_map<std::string, MeshData*> _characterSet; //Map between name of the 26 alphabets and its mesh data. This is required as an argument for creating a Text object.
 	std::string _textShaderVertexSource = "#version 300 es\r\n\
@@ -129,7 +214,11 @@ private:
 		layout(location=2) in vec2 texCoord;\r\n\
 		out vec3 normal;\r\n\
 		out vec4 vPosition;\r\n\
-		uniform mat4 projectionView;\r\n\
+		layout(std140) uniform FrameState {\r\n\
+			mat4 projectionView;\r\n\
+			vec3 cameraPosition;\r\n\
+			vec3 lightDirection;\r\n\
+		};\r\n\
 		uniform mat4 modelTransform;\r\n\
 		void main(){\r\n\
 		    vPosition = modelTransform * vec4(vertexPosition, 1.0);\r\n\
@@ -142,11 +231,14 @@ private:
 		in vec3 normal;\r\n\
 		in vec4 vPosition;\r\n\
 		out vec4 outputColor;\r\n\
-		uniform vec3 cameraPosition;\r\n\
+		layout(std140) uniform FrameState {\r\n\
+			mat4 projectionView;\r\n\
+			vec3 cameraPosition;\r\n\
+			vec3 lightDirection;\r\n\
+		};\r\n\
 		uniform vec3 vDiffuse;\r\n\
 		uniform vec3 vSpecular;\r\n\
 		uniform float vSpecularExponent;\r\n\
-		uniform vec3 lightDirection;\r\n\
 		void main(){\r\n\
 		    vec3 viewDir = normalize(cameraPosition - vPosition.xyz);\r\n\
 			vec3 sunDir = normalize(lightDirection);\r\n\
@@ -164,7 +256,11 @@ private:
 		layout(location = 3) in vec4 vertexColor;\r\n\
 		out vec3 normal;\r\n\
 		out vec4 vPosition;\r\n\
-		uniform mat4 projectionView;\r\n\
+		layout(std140) uniform FrameState {\r\n\
+			mat4 projectionView;\r\n\
+			vec3 cameraPosition;\r\n\
+			vec3 lightDirection;\r\n\
+		};\r\n\
 		uniform mat4 modelTransform;\r\n\
 		void main() {\r\n\
 			vPosition = modelTransform * vec4(vertexPosition, 1.0);\r\n\
@@ -176,14 +272,17 @@ private:
 		in vec3 normal;\r\n\
 		in vec4 vPosition;\r\n\
 		out vec4 outputColor;\r\n\
-		uniform vec3 cameraPosition;\r\n\
+		layout(std140) uniform FrameState {\r\n\
+			mat4 projectionView;\r\n\
+			vec3 cameraPosition;\r\n\
+			vec3 lightDirection;\r\n\
+		};\r\n\
 		uniform vec4 particleColor;\r\n\
 		uniform float angle;\r\n\
 		uniform float isFlickering;\r\n\
 		uniform vec3 vDiffuse;\r\n\
 		uniform vec3 vSpecular;\r\n\
 		uniform float vSpecularExponent;\r\n\
-		uniform vec3 lightDirection;\r\n\
 		float randomExponent(vec2 config) {\r\n\
 		    return fract(sin(dot(config.xy, vec2(12.9898, 78.233))) * 43758.5453);\r\n\
 		}\r\n\
@@ -200,29 +299,93 @@ private:
 		    outputColor = vec4( color , 1.0);\r\n\
 		}";
 	std::vector<GameUtilities::Particle> _particleData;
+	RandomGenerator _random; //Random number generator of the canvas. It is seeded from the current time unless replaced with `SetRandomGenerator`.
 
 	//**************************************** Private Method Declaractions **********************************
 	~AppGLCanvas(void);
+	/*
+	* @brief Applies the swap interval to the OpenGL context, which must be current on the calling (render) thread.
+	* @param {int} interval: swap interval (see `SetSwapInterval`).
+	* @returns {bool} true if the platform supports the swap-control extension and the interval was applied, false otherwise.
+	*/
+	bool _applySwapInterval(int interval);
 	void _applyTextShaderSettings(void);
 	void _applyParticleShaderSettings(void);
 	/*
 	* @brief Handles the main event loop in idle time.
+	* @param {double} deltaTime: time (in milliseconds) elapsed since the last update.
+	* @param {bool} isRedrawRequested: whether or not the scene was changed by an event (see `RequestRedraw`), hence the board must be redrawn.
 	*/
-	bool _finishIdleTask(unsigned long deltaTime);
+	bool _finishIdleTask(double deltaTime, bool isRedrawRequested);
+	/*
+	* @brief Computes the rate at which the game loop must run on the UI thread: the target frame rate while a blast is pending or a computer player is to move,
+	* and 0 otherwise, i.e., the game loop only runs on request. The render thread animates the welcome screen and the rotating orbs on its own.
+	*/
+	double _getUpdateRate(void) const;
 	/*
 	* @brief Initializes default member variables of the OpenGL canvas instance and compiles generic shader elements.
 	*/
 	void _initDefaultVariables(void);
-	bool _offlineGameLoop(GameUtilities::GameState* gameState, unsigned long deltaTime);
+	/*
+	* @brief Initializes GLEW, the default OpenGL settings and the welcome screen, and processes the resource data. Runs on the render thread.
+	* @returns {bool} true if the canvas is ready for rendering, false otherwise.
+	*/
+	bool _initRendering(void);
+	bool _offlineGameLoop(GameUtilities::GameState* gameState, double deltaTime, bool isRedrawRequested);
+	/*
+	* @brief Sends a command to the render thread and wakes it up. If the queue is full, waits until the render thread has caught up.
+	* @param {const RenderCommand&} command: command to be sent.
+	*/
+	void _postRenderCommand(const RenderCommand& command);
 	bool _processPendingResourceData(void);
 	/*
+	* @brief Releases the OpenGL context from the calling thread, hence it can be made current on another one.
+	* @returns {bool} true if the context was released, false if the platform does not support it.
+	*/
+	bool _releaseCurrentContext(void);
+	/*
+	* @brief Frees the OpenGL objects of the welcome screen and of the given game objects. Runs on the render thread before it releases the context.
+	* @param {const std::vector<MainGame*>&} games: game objects whose boards were drawn. They must outlive the canvas, which the game objects of the app do.
+	*/
+	void _releaseGraphics(const std::vector<MainGame*>& games);
+	/*
+	* @brief Main loop of the render thread. It makes the OpenGL context current, then processes the commands of the UI thread and draws the frames
+	* at the frame rate which the scene needs, until the canvas is destroyed. A static scene is not redrawn until a command arrives.
+	*/
+	void _runRenderThread(void);
+	/*
+	* @brief Starts the frame timer for the next update of the given rate, or stops it for a rate of 0.
+	* The timer is started for whole milliseconds only; the remaining fraction of a millisecond is waited for by polling.
+	* @param {double} updateRate: updates per second.
+	* @param {double} elapsedTime: time (in milliseconds) elapsed since the last update.
+	* @returns {bool} true if the next update is due within a millisecond, hence more idle events must be requested, false otherwise.
+	*/
+	bool _scheduleUpdate(double updateRate, double elapsedTime);
+	/*
+	* @brief Tells the render thread which scene to draw, unless it is drawn already.
+	* @param {MainGame*} game: game object whose published boards are drawn, or null for the welcome screen.
+	*/
+	void _showScene(MainGame* game);
+	/*
 	* @brief Renders the default background at the start of the application.
 	*/
 	void _renderDefaultScene(void);
 	/*
+	* @brief Stops the render thread and waits for it to finish.
+	*/
+	void _stopRenderThread(void);
+	/*
 	* @brief Simulates the random motion of brownian particles at each frame call.
 	*/
 	void _updateBrownianParticleMotion(void);
-	void _updateCameraView(void);
+	/*
+	* @brief Updates the camera of the welcome screen. Runs on the render thread.
+	* @param {float} latitude, longitude: location (in degree) of the camera.
+	*/
+	void _updateCameraView(float latitude, float longitude);
+	/*
+	* @brief Wakes up the render thread, e.g., after a command was sent or a setting was changed.
+	*/
+	void _wakeRenderThread(void);
 };
 #endif // !APP_GL_CANVAS_H
@@ -3,11 +3,12 @@
 #include "MainGame.h"
 #include "Utilities.h"
 //*********************************** static variable initialization **********************************
-const unsigned int AppGUIFrame::_minimumNumberOfRows = (unsigned int) 6;
-const unsigned int AppGUIFrame::_maximumNumberOfRows = (unsigned int) 10;
-const unsigned int AppGUIFrame::_minimumNumberOfColumns = (unsigned int) 6;
-const unsigned int AppGUIFrame::_maximumNumberOfColumns = (unsigned int) 10;
+const unsigned int AppGUIFrame::_minimumNumberOfRows = (unsigned int) 2;
+const unsigned int AppGUIFrame::_maximumNumberOfRows = (unsigned int) 1000;
+const unsigned int AppGUIFrame::_minimumNumberOfColumns = (unsigned int) 2;
+const unsigned int AppGUIFrame::_maximumNumberOfColumns = (unsigned int) 1000;
 const unsigned int AppGUIFrame::_maximumNumberOfPlayers = (unsigned int) 8;
+const std::vector<wxString> AppGUIFrame::_playerTypeList = {"Human","Computer (alpha-beta)","Computer (MCTS)"};
 const std::vector<wxString> AppGUIFrame::_colorList = {"Red","Blue","Green","Yellow","Cyan","Purple","Violet","Pink","Orange","Green 1","Brown","Maroon","Green 2","Grey"};
 const std::unordered_map<wxString, wxColor> AppGUIFrame::_colorMap = AppGUIFrame::_createColormap();
 //*****************************************************************************************************
@@ -45,18 +46,14 @@ AppGUIFrame::AppGUIFrame(const wxString& title = "", const wxPoint& position = w
 	label->SetBackgroundColour(wxColor(200,200,200));
 	subsizerForBoardDimension->Add(label,0,wxALIGN_CENTER_HORIZONTAL | wxALIGN_CENTER_VERTICAL | wxALL,3);
 	///
-	wxArrayString rowList;
-	for (unsigned int i = AppGUIFrame::_minimumNumberOfRows; i < (AppGUIFrame::_maximumNumberOfRows + 1); i++) rowList.Add(wxString::Format("%d", i));
-	this->_rowChoice = new wxComboBox(subpanelForBoardDimension, ID_ROW_CHOICE, wxString::Format("%d", AppGUIFrame::_minimumNumberOfRows + 2), wxDefaultPosition, wxDefaultSize, rowList, wxCB_READONLY);
+	this->_rowChoice = new wxSpinCtrl(subpanelForBoardDimension, ID_ROW_CHOICE, wxT("8"), wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, AppGUIFrame::_minimumNumberOfRows, AppGUIFrame::_maximumNumberOfRows, 8);
 	subsizerForBoardDimension->Add(this->_rowChoice,0,wxALIGN_CENTER_HORIZONTAL | wxALIGN_CENTER_VERTICAL | wxALL,3);
 	///
 	label = new wxStaticText(subpanelForBoardDimension,wxID_STATIC,wxT(" x "),wxDefaultPosition,wxDefaultSize,wxALIGN_CENTER);
 	label->SetBackgroundColour(wxColor(200,200,200));
 	subsizerForBoardDimension->Add(label,0,wxALIGN_CENTER_HORIZONTAL | wxALIGN_CENTER_VERTICAL | wxALL,3);
 	///
-	wxArrayString columnList;
-	for (unsigned int i = AppGUIFrame::_minimumNumberOfColumns; i < (AppGUIFrame::_maximumNumberOfColumns + 1); i++) columnList.Add(wxString::Format("%d", i));
-	this->_columnChoice = new wxComboBox(subpanelForBoardDimension, ID_COL_CHOICE, wxString::Format("%d", AppGUIFrame::_minimumNumberOfColumns), wxDefaultPosition, wxDefaultSize, columnList, wxCB_READONLY);
+	this->_columnChoice = new wxSpinCtrl(subpanelForBoardDimension, ID_COL_CHOICE, wxT("6"), wxDefaultPosition, wxDefaultSize, wxSP_ARROW_KEYS, AppGUIFrame::_minimumNumberOfColumns, AppGUIFrame::_maximumNumberOfColumns, 6);
 	subsizerForBoardDimension->Add(this->_columnChoice,0,wxALIGN_CENTER_HORIZONTAL | wxALIGN_CENTER_VERTICAL | wxALL,3);
 	///
 	subpanelForBoardDimension->SetSizer(subsizerForBoardDimension);
@@ -95,12 +92,31 @@ AppGUIFrame::AppGUIFrame(const wxString& title = "", const wxPoint& position = w
 		this->_playerColors.push_back(playerColorList);
 		wxComboBox *playerColorOptionsWidget = new wxComboBox(subpanelForPlayerColor, ID_COLOR_CHOICE + i, AppGUIFrame::_colorList[i], wxDefaultPosition, wxDefaultSize, playerColorList, wxCB_READONLY);
 		subsizerForPlayerColor->Add(playerColorOptionsWidget, 1, wxALIGN_CENTER_HORIZONTAL | wxALIGN_CENTER_VERTICAL | wxALL, 3);
+		wxArrayString playerTypeList;
+		for (const auto& playerType : AppGUIFrame::_playerTypeList) playerTypeList.Add(playerType);
+		wxComboBox* playerTypeOptionsWidget = new wxComboBox(subpanelForPlayerColor, wxID_ANY, AppGUIFrame::_playerTypeList[0], wxDefaultPosition, wxDefaultSize, playerTypeList, wxCB_READONLY);
+		subsizerForPlayerColor->Add(playerTypeOptionsWidget, 1, wxALIGN_CENTER_HORIZONTAL | wxALIGN_CENTER_VERTICAL | wxALL, 3);
 		subpanelForPlayerColor->SetSizer(subsizerForPlayerColor);
 		control_panelsizer->Add(subpanelForPlayerColor, 0, wxALL | wxEXPAND, 5);
 		this->_playerColorsWidgetList.push_back(playerColorOptionsWidget);
-		if (i > 1) playerColorOptionsWidget->Disable();
+		this->_playerTypeWidgetList.push_back(playerTypeOptionsWidget);
+		if (i > 1) {
+			playerColorOptionsWidget->Disable();
+			playerTypeOptionsWidget->Disable();
+		}
 		control_panelsizer->AddStretchSpacer(1);
 	}
+	wxPanel* subpanelForRecording = new wxPanel(this->_panelOutsideGame, wxID_ANY, wxDefaultPosition, wxDefaultSize);
+	subpanelForRecording->SetBackgroundColour(wxColor(200, 200, 200));
+	wxBoxSizer* subsizerForRecording = new wxBoxSizer(wxHORIZONTAL);
+	//Recording is off by default, as the record file grows with every game.
+	this->_recordChoice = new wxCheckBox(subpanelForRecording, wxID_ANY, "Record games");
+	this->_recordChoice->SetValue(false);
+	this->_recordChoice->SetBackgroundColour(wxColour(200, 200, 200));
+	subsizerForRecording->Add(this->_recordChoice, 1, wxALIGN_CENTER_VERTICAL | wxALL, 3);
+	subpanelForRecording->SetSizer(subsizerForRecording);
+	control_panelsizer->Add(subpanelForRecording, 0, wxALL | wxEXPAND, 5);
+	control_panelsizer->AddStretchSpacer(1);
 	wxPanel *subpanelForStartButton = new wxPanel(this->_panelOutsideGame, wxID_ANY, wxDefaultPosition, wxDefaultSize);
 	subpanelForStartButton->SetBackgroundColour(wxColor(180,180,180));
 	///
@@ -195,7 +211,11 @@ AppGUIFrame::AppGUIFrame(const wxString& title = "", const wxPoint& position = w
 	this->_infoButton = new wxButton(gameSubpanelForMoveOrderButton, ID_INFO_BUTTON, "Move Order");
 	this->_infoButton->SetBackgroundColour(wxColor(180,180,180));
 	///
+	this->_hintButton = new wxButton(gameSubpanelForMoveOrderButton, ID_HINT_BUTTON, "Book &Hint");
+	this->_hintButton->SetBackgroundColour(wxColor(180,180,180));
+	///
 	gameSubsizerForMoveOrderButton->Add(this->_infoButton, 1, wxALIGN_CENTRE_HORIZONTAL | wxALIGN_CENTER_VERTICAL);
+	gameSubsizerForMoveOrderButton->Add(this->_hintButton, 1, wxALIGN_CENTRE_HORIZONTAL | wxALIGN_CENTER_VERTICAL);
 	gameSubpanelForMoveOrderButton->SetSizer(gameSubsizerForMoveOrderButton);
 
 	game_panelsizer->AddStretchSpacer(1);
@@ -208,7 +228,11 @@ AppGUIFrame::AppGUIFrame(const wxString& title = "", const wxPoint& position = w
 	wxButton *undo = new wxButton(gameSubpanelForUndoButton, wxID_UNDO);
 	undo->SetBackgroundColour(wxColor(180,180,180));
 	///
+	wxButton *redo = new wxButton(gameSubpanelForUndoButton, wxID_REDO);
+	redo->SetBackgroundColour(wxColor(180,180,180));
+	///
 	gameSubsizerForUndoButton->Add(undo, 1, wxALIGN_CENTRE_HORIZONTAL | wxALIGN_CENTER_VERTICAL);
+	gameSubsizerForUndoButton->Add(redo, 1, wxALIGN_CENTRE_HORIZONTAL | wxALIGN_CENTER_VERTICAL);
 	gameSubpanelForUndoButton->SetSizer(gameSubsizerForUndoButton);
 
 	game_panelsizer->AddStretchSpacer(1);
@@ -282,7 +306,9 @@ AppGUIFrame::AppGUIFrame(const wxString& title = "", const wxPoint& position = w
 	wxLogDebug("[Chain-Reaction] Performing dynamic event-bindings to the application-frame object ...");
 	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonStart, this, wxID_OK);
 	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonTurnInfo, this, ID_INFO_BUTTON);
+	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonHint, this, ID_HINT_BUTTON);
 	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonUndo, this, wxID_UNDO);
+	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonRedo, this, wxID_REDO);
 	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonStartNew, this, ID_START_NEW_BUTTON);
 	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonMainMenu, this, ID_MAIN_MENU);
 	Bind(wxEVT_COMMAND_BUTTON_CLICKED, &AppGUIFrame::OnButtonQuit, this, wxID_EXIT);
@@ -301,6 +327,7 @@ void AppGUIFrame::OnButtonMainMenu(wxCommandEvent& event) {
 	else {
 		GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->canvas_panel->GetClientData();
 		if (gameInfo && gameInfo->game_started) gameInfo->go_back_main = REQUESTED_IN_OFFLINE_MODE;
+		this->canvas_panel->RequestRedraw();
 	}
 }
 void AppGUIFrame::OnButtonQuit(wxCommandEvent& event) {
@@ -319,19 +346,25 @@ void AppGUIFrame::OnButtonStart(wxCommandEvent& event){
 		return;
 	}
 	//Configure game parameters before the start of a game ....
-	unsigned int numberOfRows = this->_rowChoice->GetSelection() + 6;
-	unsigned int numberOfColumns = this->_columnChoice->GetSelection() + 6;
+	unsigned int numberOfRows = (unsigned int)this->_rowChoice->GetValue();
+	unsigned int numberOfColumns = (unsigned int)this->_columnChoice->GetValue();
 	unsigned int player_no = this->_playerChoice->GetSelection() + 2;
 	std::vector<std::string> players;
+	std::vector<GameUtilities::PlayerType> playerTypes;
 	for (unsigned int i = 0; i < player_no; i++){
 		const auto& color = this->_playerColorsWidgetList[i]->GetStringSelection();
 		players.push_back(std::string(color));
+		playerTypes.push_back((GameUtilities::PlayerType)this->_playerTypeWidgetList[i]->GetSelection());
 	}
 	std::set<std::string> player_set = std::set<std::string>(players.begin(),players.end());
 	if ((unsigned int) player_set.size() != (unsigned int) players.size()){
 		wxMessageBox(wxT("Same colors are not allowed for multiple players!"),wxT("Error!"),wxOK | wxICON_INFORMATION);
 		return;
 	}
+	if ((unsigned long long)numberOfRows * numberOfColumns < player_no) { //Every player needs an empty cell for the first move.
+		wxMessageBox(wxString::Format("A board of %u x %u cells is too small for %u players!", numberOfRows, numberOfColumns, player_no), wxT("Error!"), wxOK | wxICON_INFORMATION);
+		return;
+	}
 	//Retrieve the game object ...
 	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->canvas_panel->GetClientData();
 	if (!gameInfo) {
@@ -348,11 +381,16 @@ void AppGUIFrame::OnButtonStart(wxCommandEvent& event){
 	//Inform the game object about the current canvas dimension.
 	wxSize size = this->canvas_panel->GetClientSize();
 	game->setCanvasSize(size.x, size.y);
-	game->setupCamera();
 
 	//Pass the game parameters to the game object ...
 	game->resetGameVariables();
+	if (this->_recordChoice->GetValue() && !this->_recordPath.IsEmpty()) {
+		if (!game->startRecording(this->_recordPath.ToStdString(), 16)) wxLogDebug(wxString::Format("[Chain-Reaction] Error: could not open the game record file '%s' ...", this->_recordPath));
+	}
+	else game->stopRecording();
 	game->setAttribute(numberOfRows, numberOfColumns, players);
+	game->setupCamera(); //The view is fitted to the board dimension.
+	game->setComputerPlayers(playerTypes);
 	game->updateTurn();
 	wxString dummyLabel = wxString::Format("BOARD : %d x %d  ", numberOfRows, numberOfColumns);
 	this->_boardLabel->SetLabel(dummyLabel);
@@ -365,7 +403,7 @@ void AppGUIFrame::OnButtonStart(wxCommandEvent& event){
 	gameInfo->game_started = 1;
 	gameInfo->isOnline = false;
 	gameInfo->game_ended = 0;
-
+	this->canvas_panel->RequestRedraw();
 }
 void AppGUIFrame::OnButtonStartNew(wxCommandEvent& event) {
 	int result = wxMessageBox(wxT("New game will start. Continue?"), wxT("Confirmation"), wxNO_DEFAULT | wxYES_NO | wxICON_INFORMATION, this);
@@ -373,7 +411,27 @@ void AppGUIFrame::OnButtonStartNew(wxCommandEvent& event) {
 	else {
 		GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->canvas_panel->GetClientData();
 		if (gameInfo && gameInfo->game_started) gameInfo->new_game = 1;
+		this->canvas_panel->RequestRedraw();
+	}
+}
+void AppGUIFrame::OnButtonHint(wxCommandEvent& event) {
+	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*)this->canvas_panel->GetClientData();
+	if (!gameInfo || !gameInfo->game) return;
+	MainGame* offlineGameObject = (MainGame*)gameInfo->game;
+	if (offlineGameObject->isBlastAnimationRunning()) return;
+	std::vector<OpeningBook::BookMove> moves;
+	if (!offlineGameObject->getBookMoves(moves)) {
+		wxMessageBox(wxT("The current position is not in the opening book."), wxT("Book Hint"), wxOK | wxICON_INFORMATION, this);
+		return;
 	}
+	//Cells are given in the board coordinate system, i.e., counted from the lower-left cell of the board.
+	const unsigned int numberOfColumns = offlineGameObject->getEngine().getNumberOfColumns();
+	wxMenu hintMenu(wxT("Book moves (column, row): "));
+	for (size_t i = 0; i < moves.size() && i < 5; i++) {
+		const auto& move = moves[i];
+		hintMenu.Append(wxID_ANY, wxString::Format("(%u, %u): %u games, %.0f%% won", move.cellIndex % numberOfColumns + 1, move.cellIndex / numberOfColumns + 1, move.games, 100.0 * move.wins / move.games));
+	}
+	this->_hintButton->PopupMenu(&hintMenu);
 }
 void AppGUIFrame::OnButtonTurnInfo(wxCommandEvent& event){
 	int id = event.GetId();
@@ -390,17 +448,30 @@ void AppGUIFrame::OnButtonTurnInfo(wxCommandEvent& event){
 		if (!offlineGameObject) return;
 		for (unsigned int i = 0; i < player_no; i++) {
 			const auto& playerColor = this->_playerColorsWidgetList[i]->GetStringSelection();
-			std::string lowerCasePlayerColor = playerColor.Lower().ToStdString();
-			if (!offlineGameObject->isEliminated(lowerCasePlayerColor)) infoMenu.Append(wxID_ANY, playerColor);
+			if (!offlineGameObject->isEliminated((uint8_t)i)) infoMenu.Append(wxID_ANY, playerColor);
 		}
 		this->_infoButton->PopupMenu(&infoMenu);
 	}
 }
+void AppGUIFrame::OnButtonRedo(wxCommandEvent& event){
+	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*) this->canvas_panel->GetClientData();
+	if (gameInfo) {
+		MainGame* game = (MainGame*)gameInfo->game;
+		if (game && !game->isBlastAnimationRunning()) game->redo();
+		this->canvas_panel->RequestRedraw();
+	}
+	else {
+		wxLogDebug("[Chain-Reaction] Error: failed to start the game. Game information has not been generated yet ...");
+		wxMessageBox(wxT("Failed to start the game. Game information has not been generated yet!"), wxT("Error!"), wxOK | wxICON_INFORMATION);
+		return;
+	}
+}
 void AppGUIFrame::OnButtonUndo(wxCommandEvent& event){
 	GameUtilities::GameState* gameInfo = (GameUtilities::GameState*) this->canvas_panel->GetClientData();
 	if (gameInfo) {
 		MainGame* game = (MainGame*)gameInfo->game;
 		if (game && !game->isBlastAnimationRunning()) game->undo();
+		this->canvas_panel->RequestRedraw();
 	}
 	else {
 		wxLogDebug("[Chain-Reaction] Error: failed to start the game. Game information has not been generated yet ...");
@@ -444,11 +515,14 @@ void AppGUIFrame::OnPlayerSelection(wxCommandEvent& event) {
 	if (!online) {
 		for (unsigned int i = 0; i < this->_playerColorsWidgetList.size(); i++) {
 			wxChoice* dummyWidget = this->_playerColorsWidgetList[i];
+			wxComboBox* typeWidget = this->_playerTypeWidgetList[i];
 			if (i < selectedOption) {
 				if (!(dummyWidget->IsEnabled())) dummyWidget->Enable();
+				if (!(typeWidget->IsEnabled())) typeWidget->Enable();
 			}
 			else {
 				if (dummyWidget->IsEnabled()) dummyWidget->Disable();
+				if (typeWidget->IsEnabled()) typeWidget->Disable();
 			}
 		}
 	}
@@ -461,10 +535,10 @@ void AppGUIFrame::OnSashDrag(wxSashEvent& event) {
 	wxSize currentParentSize = this->_parentOfCanvasWindow->GetParent()->GetClientSize();
 	wxPoint currentPosition = this->_parentOfCanvasWindow->GetPosition();
 	wxSashEdgePosition edge = event.GetEdge();
-	int newX = max(0, sashRect.x);
-	int newY = max(0, sashRect.y);
-	int newW = min(currentParentSize.GetWidth(), sashRect.width);
-	int newH = min(currentParentSize.GetHeight(), sashRect.height);
+	int newX = (std::max)(0, sashRect.x);
+	int newY = (std::max)(0, sashRect.y);
+	int newW = (std::min)(currentParentSize.GetWidth(), sashRect.width);
+	int newH = (std::min)(currentParentSize.GetHeight(), sashRect.height);
 	switch (edge) {
 		case wxSASH_LEFT:
 			this->_parentOfCanvasWindow->SetPosition(wxPoint(newX, currentPosition.y));
@@ -489,9 +563,6 @@ void AppGUIFrame::ShowGamePanel(bool state) {
 		this->_panelInsideGame->Update();
 	}
 }
-void AppGUIFrame::swapBuffers(void){
-	this->canvas_panel->SwapBuffers();
-}
 void AppGUIFrame::UpdateTurnInGUI(unsigned int player){
 	wxString playerLabel = wxString::Format("Player %d  ", player);
 	this->_turnLabel->SetLabel(playerLabel);
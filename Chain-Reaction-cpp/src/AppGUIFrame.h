@@ -8,7 +8,6 @@
 #include "ObjLoader.h"
 #include "AppGLCanvas.h"
 
-#define FPS_RATE 60.0 //default frame rate for rendering OpenGL.
 #define REQUESTED_IN_OFFLINE_MODE 1
 //*********************** These macro definitions are used only for the option of online play. ****************
 constexpr auto REGISTRATION_HOSTNAME = "chainserver.pythonanywhere.com";
@@ -22,6 +21,7 @@ enum{
 	ID_COL_CHOICE,
 	ID_PLAYER_CHOICE,
 	ID_INFO_BUTTON,
+	ID_HINT_BUTTON,
 	ID_START_NEW_BUTTON,
 	ID_MAIN_MENU,
 	ID_REGISTER_ONLINE,
@@ -41,6 +41,10 @@ public:
 	*/
 	void OnButtonStart(wxCommandEvent& event);
 	/*
+	* @brief Callback function for the 'Book Hint' button press event. It lists the moves of the opening book for the current position.
+	*/
+	void OnButtonHint(wxCommandEvent& event);
+	/*
 	* @brief Callback function for the 'Move Order' button press event.
 	*/
 	void OnButtonTurnInfo(wxCommandEvent& event);
@@ -49,6 +53,10 @@ public:
 	*/
 	void OnButtonUndo(wxCommandEvent& event);
 	/*
+	* @brief Callback function for the 'Redo' button press event.
+	*/
+	void OnButtonRedo(wxCommandEvent& event);
+	/*
 	* @brief Callback function for the 'Start New Game' button press event.
 	*/
 	void OnButtonStartNew(wxCommandEvent& event);
@@ -78,10 +86,6 @@ public:
 	/*@brief Updates the current player in the GUI interface.*/
 	void UpdateTurnInGUI(unsigned int player = 2);
 	/*
-	* @brief Swaps frame buffers of the wxGLCanvas (OpenGL) instance.
-	*/
-	void swapBuffers(void);
-	/*
 	* @brief Toggles the visibility status of the inside-game-menu and outside-game-menu.
 	*/
 	void ShowGamePanel(bool state);
@@ -90,6 +94,11 @@ public:
 	* It opens a webpage (in the default browser) where the online version of the game can be played.
 	*/
 	void OnButtonRegisterOnline(wxCommandEvent& event);
+	/*
+	* @brief Sets the file that games are appended to if 'Record games' is checked in the setup panel. Recording is disabled for an empty path.
+	* @param {const wxString&} path: path to the game record file.
+	*/
+	void SetRecordPath(const wxString& path) { this->_recordPath = path; }
 	//An AppGLCanvas instance derived from the baseclass wxGLCanvas, which serves as the main canvas for OpenGL rendering.
 	AppGLCanvas *canvas_panel = nullptr;
 
@@ -97,14 +106,19 @@ private:
 	static const unsigned int _minimumNumberOfRows, _minimumNumberOfColumns, _maximumNumberOfRows, _maximumNumberOfColumns, _maximumNumberOfPlayers;
 	static const wxString _playerList[];
 	std::vector<wxArrayString> _playerColors;
-	wxComboBox *_rowChoice, *_columnChoice, *_playerChoice;
+	wxSpinCtrl *_rowChoice, *_columnChoice; //Board dimension. Any value within the minimum and maximum number of rows (columns) can be typed in.
+	wxComboBox *_playerChoice;
+	wxCheckBox *_recordChoice; //Enables recording of the offline games. It is unchecked by default.
+	wxString _recordPath; //Game record file used if recording is enabled.
 	wxStaticText *_boardLabel, *_playerLabel, *_turnLabel, *_turnLabelStatic;
-	wxButton* _infoButton;
+	wxButton *_hintButton, *_infoButton;
 	wxBoxSizer *_gameSubsizerForTurnLabel, *_topsizerForLeftWindow;
 	wxPanel *_panelOutsideGame, *_panelInsideGame;
 	wxSashLayoutWindow* _parentOfCanvasWindow;
 	std::vector<wxComboBox*> _playerColorsWidgetList;
+	std::vector<wxComboBox*> _playerTypeWidgetList; //Selects whether a player is controlled by a human or by the computer.
 	static const std::vector<wxString> _colorList;
+	static const std::vector<wxString> _playerTypeList;
 	//An unordered map that points each color name to its corresponding RGB value.
 	static const std::unordered_map<wxString,wxColor> _colorMap;
 	/*
@@ -0,0 +1,303 @@
+#include "BatchSimulator.h"
+#include <algorithm>
+
+//*************************************** Public methods ****************************************
+
+BatchSimulator::BatchSimulator(unsigned int batchSize, uint64_t seed) {
+	const unsigned int blockCount = (std::max)(1u, (batchSize + LANES - 1) / LANES);
+	this->_blocks.resize(blockCount);
+	this->_games.resize((size_t)blockCount * LANES);
+	this->_lastSteps.resize(this->_games.size());
+	this->_random.seed(seed);
+	this->setAttribute(8, 6, 2);
+}
+void BatchSimulator::resetStatistics(void) {
+	this->_completedGames = 0;
+	this->_adjudicatedGames = 0;
+	this->_moveCount = 0;
+	for (auto& wins : this->_wins) wins = 0;
+}
+uint64_t BatchSimulator::run(uint64_t games) {
+	const uint64_t start = this->_completedGames;
+	//Unlike `step`, the games of a block are not kept in lockstep: a game whose chain reaction has settled plays its next moves while the chain reactions
+	//of the other games of the block are still running. Moves without a chain reaction are played at once, hence (nearly) every game takes part in every blast.
+	while (this->_completedGames - start < games) {
+		for (size_t blockIndex = 0; blockIndex < this->_blocks.size(); blockIndex++) {
+			Block& block = this->_blocks[blockIndex];
+			const unsigned int firstGame = (unsigned int)(blockIndex * LANES);
+			if (this->_startMoves(block, firstGame, true)) this->_runBlast(block, firstGame);
+		}
+	}
+	return this->_completedGames - start;
+}
+void BatchSimulator::seed(uint64_t value) {
+	this->_random.seed(value);
+}
+bool BatchSimulator::setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers) {
+	if (!BitboardEngine::supports(numberOfRows, numberOfColumns, numberOfPlayers)) return false;
+	this->_ROW_DIV = numberOfRows;
+	this->_COL_DIV = numberOfColumns;
+	this->_numberOfPlayers = numberOfPlayers;
+	for (unsigned int w = 0; w < 2; w++) {
+		this->_board[w] = this->_firstColumn[w] = this->_lastColumn[w] = 0;
+		for (auto& cells : this->_criticalMass) cells[w] = 0;
+	}
+	for (uint32_t y = 0; y < numberOfRows; y++) {
+		for (uint32_t x = 0; x < numberOfColumns; x++) {
+			const uint32_t cellIndex = x + y * numberOfColumns;
+			const uint64_t bit = 1ULL << (cellIndex & 63);
+			const unsigned int neighbours = (x > 0) + (x + 1 < numberOfColumns) + (y > 0) + (y + 1 < numberOfRows);
+			this->_board[cellIndex >> 6] |= bit;
+			if (!x) this->_firstColumn[cellIndex >> 6] |= bit;
+			if (x + 1 == numberOfColumns) this->_lastColumn[cellIndex >> 6] |= bit;
+			if (neighbours) this->_criticalMass[neighbours - 1][cellIndex >> 6] |= bit;
+		}
+	}
+	GameEngine game;
+	game.setAttribute(numberOfRows, numberOfColumns, numberOfPlayers);
+	return this->setStartPosition(game);
+}
+bool BatchSimulator::setStartPosition(const GameEngine& game) {
+	if (game.hasGameEnded() || game.hasPendingBlast() || !BitboardEngine::supports(game.getNumberOfRows(), game.getNumberOfColumns(), game.getNumberOfPlayers())) return false;
+	if (this->_ROW_DIV != game.getNumberOfRows() || this->_COL_DIV != game.getNumberOfColumns() || this->_numberOfPlayers != game.getNumberOfPlayers()) {
+		//Sets up the board masks (and the empty board as start position, which is replaced by the actual one right away).
+		return this->setAttribute(game.getNumberOfRows(), game.getNumberOfColumns(), (uint8_t)game.getNumberOfPlayers()) && this->setStartPosition(game);
+	}
+	this->_startPosition = Position();
+	const auto& board = game.getBoard();
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) {
+		const auto& cell = board[cellIndex];
+		if (!cell.level) continue;
+		const uint64_t bit = 1ULL << (cellIndex & 63);
+		for (unsigned int plane = 0; plane < 3; plane++) {
+			if ((cell.level >> plane) & 1) this->_startPosition.levels[plane][cellIndex >> 6] |= bit;
+		}
+		this->_startPosition.owners[cell.owner][cellIndex >> 6] |= bit;
+	}
+	this->_startState = GameState();
+	this->_startState.turn = game.getTurn();
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		if (!game.isEliminated(player)) continue;
+		this->_startState.eliminated |= (uint8_t)(1 << player);
+		this->_startState.eliminatedCount++;
+	}
+	//Clearing the blocks also clears the owner masks of the unused player slots, which the blast kernel processes all the same.
+	for (auto& block : this->_blocks) block = Block();
+	for (size_t gameIndex = 0; gameIndex < this->_games.size(); gameIndex++) {
+		this->_storeLane(this->_blocks[gameIndex / LANES], (unsigned int)(gameIndex % LANES), this->_startPosition);
+		this->_games[gameIndex] = this->_startState;
+	}
+	this->resetStatistics();
+	return true;
+}
+void BatchSimulator::step(void) {
+	for (size_t blockIndex = 0; blockIndex < this->_blocks.size(); blockIndex++) {
+		Block& block = this->_blocks[blockIndex];
+		const unsigned int firstGame = (unsigned int)(blockIndex * LANES);
+		//The chain reactions of a block are resolved together; the block is done once its longest chain reaction has settled.
+		bool isRunning = this->_startMoves(block, firstGame, false);
+		while (isRunning) isRunning = this->_runBlast(block, firstGame);
+		for (unsigned int lane = 0; lane < LANES; lane++) {
+			GameState& state = this->_games[firstGame + lane];
+			StepResult& result = this->_lastSteps[firstGame + lane];
+			result.move = state.lastMove;
+			result.winnerIndex = 0;
+			if (!state.hasEnded && !(this->_moveLimit && state.moves >= this->_moveLimit)) continue;
+			Position position;
+			this->_loadLane(block, lane, position);
+			result.winnerIndex = 1 + this->_finishGame(position, state);
+			this->_storeLane(block, lane, position);
+		}
+	}
+}
+uint8_t BatchSimulator::getOwner(unsigned int gameIndex, uint32_t cellIndex) const {
+	const Block& block = this->_blocks[gameIndex / LANES];
+	const unsigned int lane = gameIndex % LANES, w = cellIndex >> 6;
+	const uint64_t bit = 1ULL << (cellIndex & 63);
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		if (block.owners[player][w][lane] & bit) return player;
+	}
+	return 0;
+}
+//******************************************* Private methods ************************************
+
+void BatchSimulator::_eliminatePlayers(uint8_t emptyPlayers, GameState& state, bool updateTurnVariable) const {
+	//Like GameEngine::_eliminatePlayers, the turn is only passed on once the move has settled, also during the first round.
+	if (state.turn < this->_numberOfPlayers) {
+		if (updateTurnVariable) state.turn++;
+		return;
+	}
+	const uint8_t newlyEliminated = emptyPlayers & (uint8_t)~state.eliminated;
+	state.eliminated |= newlyEliminated;
+	state.eliminatedCount += (uint8_t)std::popcount(newlyEliminated);
+	if (updateTurnVariable) {
+		while (1) {
+			state.turn += 1;
+			if (!((state.eliminated >> (state.turn % this->_numberOfPlayers)) & 1)) break;
+		}
+	}
+}
+void BatchSimulator::_findBombs(Block& block) const {
+	for (unsigned int w = 0; w < 2; w++) {
+		const uint64_t criticalMass1 = this->_criticalMass[0][w], criticalMass2 = this->_criticalMass[1][w], criticalMass3 = this->_criticalMass[2][w], criticalMass4 = this->_criticalMass[3][w];
+		for (unsigned int lane = 0; lane < LANES; lane++) {
+			const uint64_t level0 = block.levels[0][w][lane], level1 = block.levels[1][w][lane], level2 = block.levels[2][w][lane];
+			const uint64_t critical = (criticalMass1 & (level0 | level1 | level2)) | (criticalMass2 & (level1 | level2)) | (criticalMass3 & (level2 | (level1 & level0))) | (criticalMass4 & level2);
+			block.bombs[w][lane] = critical & block.pending[lane];
+		}
+	}
+}
+uint8_t BatchSimulator::_finishGame(Position& position, GameState& state) {
+	if (!state.hasEnded) {
+		//Adjudication by the number of orbs, as in the playouts of the Monte-Carlo search.
+		uint32_t mostOrbs = 0;
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			uint32_t orbs = 0;
+			for (unsigned int w = 0; w < 2; w++) {
+				const uint64_t owned = position.owners[player][w];
+				orbs += (uint32_t)(std::popcount(position.levels[0][w] & owned) + 2 * std::popcount(position.levels[1][w] & owned) + 4 * std::popcount(position.levels[2][w] & owned));
+			}
+			if (!player || orbs > mostOrbs) {
+				mostOrbs = orbs;
+				state.winner = player;
+			}
+		}
+		this->_adjudicatedGames++;
+	}
+	const uint8_t winner = state.winner;
+	this->_wins[winner]++;
+	this->_completedGames++;
+	position = this->_startPosition;
+	state = this->_startState;
+	return winner;
+}
+bool BatchSimulator::_playRandomMove(Position& position, GameState& state, RandomGenerator& random, unsigned int& word, uint64_t& bit) const {
+	const uint8_t currentPlayer = (uint8_t)(state.turn % this->_numberOfPlayers);
+	uint64_t legal[2];
+	for (unsigned int w = 0; w < 2; w++) {
+		const uint64_t occupied = position.levels[0][w] | position.levels[1][w] | position.levels[2][w];
+		legal[w] = this->_board[w] & ~(occupied & ~position.owners[currentPlayer][w]);
+	}
+	const uint32_t lowCount = (uint32_t)std::popcount(legal[0]);
+	uint32_t n = random.below(lowCount + (uint32_t)std::popcount(legal[1]));
+	word = 0;
+	if (n >= lowCount) {
+		n -= lowCount;
+		word = 1;
+	}
+	const uint32_t bitIndex = Bitboard::selectBit(legal[word], n);
+	bit = 1ULL << bitIndex;
+	state.lastMove = 64 * word + bitIndex;
+	//Add the orb, i.e., increment the bit-sliced counter of the cell. The cell is empty or owned by the current player.
+	uint64_t carry = bit;
+	for (unsigned int plane = 0; plane < 3; plane++) {
+		const uint64_t next = position.levels[plane][word] & carry;
+		position.levels[plane][word] ^= carry;
+		carry = next;
+	}
+	position.owners[currentPlayer][word] |= bit;
+	state.moves++;
+	//Only the cell that received the orb can become explosive.
+	const uint64_t level0 = position.levels[0][word], level1 = position.levels[1][word], level2 = position.levels[2][word];
+	const uint64_t critical = (this->_criticalMass[0][word] & (level0 | level1 | level2)) | (this->_criticalMass[1][word] & (level1 | level2)) | (this->_criticalMass[2][word] & (level2 | (level1 & level0))) | (this->_criticalMass[3][word] & level2);
+	if (critical & bit) return true;
+	this->_eliminatePlayers(this->_getEmptyPlayers(position), state, true);
+	return false;
+}
+bool BatchSimulator::_runBlast(Block& block, unsigned int firstGame) {
+	//Vertical neighbours are found by shifting by the number of columns, which is at most 64 on a board of more than one row. A shift by 64 is split into two shifts.
+	const unsigned int shift = this->_ROW_DIV > 1 ? this->_COL_DIV : 1;
+	const uint64_t verticalMask = this->_ROW_DIV > 1 ? UINT64_MAX : 0;
+	const uint64_t board0 = this->_board[0] & verticalMask, board1 = this->_board[1] & verticalMask;
+	const uint64_t inner0 = ~this->_lastColumn[0], inner1 = ~this->_lastColumn[1], outer0 = ~this->_firstColumn[0], outer1 = ~this->_firstColumn[1];
+	alignas(64) uint64_t captured[2][LANES];
+	//One branch-free pass over the lanes: every explosive site loses all its orbs and every neighbour receives one orb per exploding neighbour (see BitboardEngine::_runBlast).
+	for (unsigned int lane = 0; lane < LANES; lane++) {
+		const uint64_t bombs0 = block.bombs[0][lane], bombs1 = block.bombs[1][lane];
+		const uint64_t east0 = (bombs0 & inner0) << 1, east1 = ((bombs1 & inner1) << 1) | ((bombs0 & inner0) >> 63);
+		const uint64_t west0 = ((bombs0 & outer0) >> 1) | ((bombs1 & outer1) << 63), west1 = (bombs1 & outer1) >> 1;
+		const uint64_t north0 = ((bombs0 << (shift - 1)) << 1) & board0, north1 = (((bombs1 << (shift - 1)) << 1) | (bombs0 >> (64 - shift))) & board1;
+		const uint64_t south0 = (((bombs0 >> (shift - 1)) >> 1) | (bombs1 << (64 - shift))) & verticalMask, south1 = ((bombs1 >> (shift - 1)) >> 1) & verticalMask;
+		captured[0][lane] = east0 | west0 | north0 | south0;
+		captured[1][lane] = east1 | west1 | north1 | south1;
+		BatchSimulator::_addNeighbourCounts(block, 0, lane, east0, west0, north0, south0);
+		BatchSimulator::_addNeighbourCounts(block, 1, lane, east1, west1, north1, south1);
+	}
+	//The explosive sites are emptied and the captured cells are handed over to the player whose chain reaction is running in the lane.
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		for (unsigned int w = 0; w < 2; w++) {
+			for (unsigned int lane = 0; lane < LANES; lane++) {
+				const uint64_t isMover = 0 - (uint64_t)(block.mover[lane] == player);
+				block.owners[player][w][lane] = (block.owners[player][w][lane] & ~(captured[w][lane] | block.bombs[w][lane])) | (captured[w][lane] & isMover);
+			}
+		}
+	}
+	this->_findBombs(block);
+	//Elimination and turn bookkeeping of the games that took part in the blast, in the order of GameEngine::runBlast.
+	bool isRunning = false;
+	for (unsigned int lane = 0; lane < LANES; lane++) {
+		if (!block.pending[lane]) continue;
+		GameState& state = this->_games[firstGame + lane];
+		const bool hasNextBombs = (block.bombs[0][lane] | block.bombs[1][lane]) != 0;
+		const bool firstRound = state.turn < this->_numberOfPlayers;
+		uint8_t emptyPlayers = 0;
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (!(block.owners[player][0][lane] | block.owners[player][1][lane])) emptyPlayers |= (uint8_t)(1 << player);
+		}
+		this->_eliminatePlayers(emptyPlayers, state, false);
+		if (firstRound && hasNextBombs && std::popcount((uint8_t)(~emptyPlayers & ((1u << this->_numberOfPlayers) - 1))) == 1) {
+			for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+				if (player == block.mover[lane] || ((state.eliminated >> player) & 1)) continue;
+				state.eliminated |= (uint8_t)(1 << player);
+				state.eliminatedCount++;
+			}
+		}
+		if (state.eliminatedCount + 1 == this->_numberOfPlayers) {
+			uint8_t winner = 0;
+			while ((state.eliminated >> winner) & 1) winner++;
+			state.winner = winner;
+			state.hasEnded = true;
+		}
+		else if (hasNextBombs) {
+			isRunning = true;
+			continue;
+		}
+		else this->_eliminatePlayers(emptyPlayers, state, true);
+		block.pending[lane] = 0;
+		block.bombs[0][lane] = block.bombs[1][lane] = 0;
+	}
+	return isRunning;
+}
+bool BatchSimulator::_startMoves(Block& block, unsigned int firstGame, bool untilChainReaction) {
+	//The moves are played on copies of the lane and of the random generator, which the compiler keeps in registers instead of reloading them from the block.
+	RandomGenerator random = this->_random;
+	bool isRunning = false;
+	for (unsigned int lane = 0; lane < LANES; lane++) {
+		if (block.pending[lane]) {
+			isRunning = true;
+			continue;
+		}
+		GameState state = this->_games[firstGame + lane];
+		Position position;
+		this->_loadLane(block, lane, position);
+		while (1) {
+			if (state.hasEnded || (this->_moveLimit && state.moves >= this->_moveLimit)) this->_finishGame(position, state);
+			const uint8_t currentPlayer = (uint8_t)(state.turn % this->_numberOfPlayers);
+			unsigned int word;
+			uint64_t bit;
+			this->_moveCount++;
+			if (this->_playRandomMove(position, state, random, word, bit)) {
+				block.pending[lane] = UINT64_MAX;
+				block.mover[lane] = currentPlayer;
+				block.bombs[word][lane] = bit;
+				isRunning = true;
+				break;
+			}
+			if (!untilChainReaction || (this->_moveLimit && state.moves >= this->_moveLimit)) break;
+		}
+		this->_storeLane(block, lane, position);
+		this->_games[firstGame + lane] = state;
+	}
+	this->_random = random;
+	return isRunning;
+}
@@ -0,0 +1,222 @@
+#pragma once
+#ifndef BATCH_SIMULATOR_H
+#define BATCH_SIMULATOR_H
+
+/* The batch simulator is part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+ It plays a large batch of independent uniformly random games of one board configuration in lockstep, e.g., for estimating the value of a position
+ by Monte-Carlo playouts. The games use the bitboard representation of BitboardEngine.h, but the boards are stored as structure of arrays: games are grouped
+ into blocks of LANES games, and a block stores every 64 bit word of a bitplane or owner mask of its games contiguously. A blast is then resolved for all the
+ games of a block at once by branch-free loops over the lanes, which the compiler turns into vector instructions (every game of the block whose chain reaction
+ is still running takes part; the explosive sites of the other games are masked out). Games that end are counted and restarted from the start position.
+*/
+#include <cstdint>
+#include <vector>
+#include "BitboardEngine.h"
+#include "RandomGenerator.h"
+
+class BatchSimulator {
+public:
+	static const unsigned int LANES = 8; //Number of games per block.
+	/*
+	* @brief Outcome of the last `step` of a game.
+	* @brief Member variables:
+	* @brief	1. {uint32_t} move: index of the board-cell of the move played by the step.
+	* @brief	2. {unsigned int} winnerIndex: (1-based) index of the winner if the game was completed by the step (and restarted from the start position), 0 otherwise.
+	*/
+	typedef struct StepResult {
+		uint32_t move = 0;
+		unsigned int winnerIndex = 0;
+	} StepResult;
+
+	/*
+	* @param {unsigned int} batchSize: number of games played in lockstep. It is rounded up to a multiple of LANES.
+	* @param {uint64_t} seed: seed of the random moves.
+	*/
+	BatchSimulator(unsigned int batchSize = 1024, uint64_t seed = 1);
+	/*
+	* @brief Returns the number of games that reached the move limit and were adjudicated by the number of orbs.
+	*/
+	inline uint64_t getAdjudicatedGames() const { return this->_adjudicatedGames; }
+	inline unsigned int getBatchSize() const { return (unsigned int)this->_games.size(); }
+	/*
+	* @brief Returns the number of games completed since the last `resetStatistics`, including the adjudicated ones.
+	*/
+	inline uint64_t getCompletedGames() const { return this->_completedGames; }
+	/*
+	* @brief Returns the outcome of the last `step` of a game of the batch. Together with `getLevel`, `getOwner`, `getTurn` and `isEliminated` it lets
+	* @brief the games of the batch be replayed and checked move by move with GameEngine (see EngineTestMain.cpp).
+	* @param {unsigned int} gameIndex: index of the game in the batch.
+	*/
+	inline const StepResult& getLastStep(unsigned int gameIndex) const { return this->_lastSteps[gameIndex]; }
+	/*
+	* @brief Returns the number of orbs in a board-cell of a game of the batch. Only meaningful between two calls of `step`, as `run` leaves moves unresolved.
+	*/
+	inline uint8_t getLevel(unsigned int gameIndex, uint32_t cellIndex) const {
+		const Block& block = this->_blocks[gameIndex / LANES];
+		const unsigned int lane = gameIndex % LANES, w = cellIndex >> 6;
+		const uint64_t bit = 1ULL << (cellIndex & 63);
+		return (uint8_t)(((block.levels[0][w][lane] & bit) != 0) | (((block.levels[1][w][lane] & bit) != 0) << 1) | (((block.levels[2][w][lane] & bit) != 0) << 2));
+	}
+	inline uint64_t getMoveCount() const { return this->_moveCount; }
+	inline unsigned int getNumberOfPlayers() const { return this->_numberOfPlayers; }
+	/*
+	* @brief Returns the (0-based) id of the player owning a board-cell of a game of the batch. Only meaningful if the cell is occupied.
+	*/
+	uint8_t getOwner(unsigned int gameIndex, uint32_t cellIndex) const;
+	inline unsigned int getTurn(unsigned int gameIndex) const { return this->_games[gameIndex].turn; }
+	/*
+	* @brief Returns the number of completed games won by a given (0-based) player.
+	*/
+	inline uint64_t getWins(uint8_t player) const { return this->_wins[player]; }
+	inline bool isEliminated(unsigned int gameIndex, uint8_t player) const { return (this->_games[gameIndex].eliminated >> player) & 1; }
+	/*
+	* @brief Clears the game counters. The games in progress are kept.
+	*/
+	void resetStatistics(void);
+	/*
+	* @brief Advances the batch until at least a given number of further games are completed. This is the fast path for Monte-Carlo evaluation:
+	* @brief every game advances by one blast per iteration or, if its chain reaction has settled, plays moves until one starts a chain reaction. Hence moves of
+	* @brief the games may be left unresolved.
+	* @returns {uint64_t} number of games completed by this call.
+	*/
+	uint64_t run(uint64_t games);
+	void seed(uint64_t value);
+	/*
+	* @brief Configures the board dimension and number of players and restarts every game of the batch from the empty board.
+	* @returns {bool} false if the configuration is not supported by the bitboard engine (see `BitboardEngine::supports`).
+	*/
+	bool setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers);
+	/*
+	* @brief Limits the length of a game: a game that has not ended after this many moves (counted from the start position) is won by the player owning the most orbs.
+	* @brief Value 0 (default) removes the limit.
+	*/
+	inline void setMoveLimit(uint32_t moveLimit) { this->_moveLimit = moveLimit; }
+	/*
+	* @brief Restarts every game of the batch from a given position, which is also the start position of the games started later on. The statistics are cleared.
+	* @returns {bool} false if the configuration is not supported by the bitboard engine, or if the position has ended or has a pending blast.
+	*/
+	bool setStartPosition(const GameEngine& game);
+	/*
+	* @brief Plays one move (including its chain reaction) in every game of the batch. Games that end are counted and restarted.
+	* @brief A game whose move was left unresolved by `run` only completes that move.
+	*/
+	void step(void);
+private:
+	/*
+	* @brief Board state of LANES games. Word w of the bitplane k of the game in lane i is levels[k][w][i] (see BitboardEngine.h for the meaning of the bitplanes).
+	*/
+	typedef struct alignas(64) Block {
+		uint64_t levels[3][2][LANES];
+		uint64_t owners[BitboardEngine::MAX_PLAYERS][2][LANES];
+		uint64_t bombs[2][LANES]; //Explosive sites of the current blast.
+		uint64_t pending[LANES]; //All bits set if the chain reaction of the game is running, 0 otherwise.
+		uint64_t mover[LANES]; //(0-based) id of the player whose chain reaction is running.
+	} Block;
+	/*
+	* @brief Board state of a single game, i.e., of a lane of a block. Moves without a chain reaction are played on such a copy of the lane.
+	*/
+	typedef struct Position {
+		uint64_t levels[3][2];
+		uint64_t owners[BitboardEngine::MAX_PLAYERS][2];
+	} Position;
+	/*
+	* @brief Bookkeeping of a single game, i.e., the (scalar) state that is not resolved blast by blast.
+	*/
+	typedef struct GameState {
+		unsigned int turn = 0;
+		uint32_t moves = 0; //Number of moves played since the start position.
+		uint8_t eliminated = 0; //Bit i is set if player i is eliminated.
+		uint8_t eliminatedCount = 0;
+		bool hasEnded = false;
+		uint8_t winner = 0;
+		uint32_t lastMove = 0; //Index of the board-cell of the last move played.
+	} GameState;
+
+	uint64_t _adjudicatedGames = 0;
+	std::vector<Block> _blocks;
+	uint64_t _board[2]; //Every cell of the board.
+	unsigned int _COL_DIV;
+	uint64_t _completedGames = 0;
+	uint64_t _criticalMass[4][2]; //Cells with a critical mass of 1, 2, 3 and 4 orbs respectively.
+	uint64_t _firstColumn[2];
+	std::vector<GameState> _games;
+	std::vector<StepResult> _lastSteps; //Outcome of the last `step` of every game.
+	uint64_t _lastColumn[2];
+	uint64_t _moveCount = 0;
+	uint32_t _moveLimit = 0;
+	uint8_t _numberOfPlayers;
+	RandomGenerator _random;
+	unsigned int _ROW_DIV;
+	Position _startPosition;
+	GameState _startState;
+	uint64_t _wins[BitboardEngine::MAX_PLAYERS] = {};
+
+	/*
+	* @brief Empties the explosive sites of a word of a lane and adds the orbs received from the exploding neighbours in the four directions, i.e., adds the
+	* @brief bit-sliced sum of the four neighbour masks (0 to 4 orbs per cell) to the bit-sliced levels by a single 3 bit addition.
+	*/
+	static inline void _addNeighbourCounts(Block& block, unsigned int w, unsigned int lane, uint64_t east, uint64_t west, uint64_t north, uint64_t south) {
+		const uint64_t pairCarry = east & west, secondPairCarry = north & south;
+		const uint64_t pairSum = east ^ west, secondPairSum = north ^ south;
+		const uint64_t sum0 = pairSum ^ secondPairSum, sumCarry = pairSum & secondPairSum;
+		const uint64_t sum1 = pairCarry ^ secondPairCarry ^ sumCarry, sum2 = (pairCarry & secondPairCarry) | (sumCarry & (pairCarry | secondPairCarry));
+		const uint64_t remaining = ~block.bombs[w][lane];
+		const uint64_t level0 = block.levels[0][w][lane] & remaining, level1 = block.levels[1][w][lane] & remaining, level2 = block.levels[2][w][lane] & remaining;
+		const uint64_t carry0 = level0 & sum0, carry1 = (level1 & sum1) | (carry0 & (level1 ^ sum1));
+		block.levels[0][w][lane] = level0 ^ sum0;
+		block.levels[1][w][lane] = level1 ^ sum1 ^ carry0;
+		block.levels[2][w][lane] = level2 ^ sum2 ^ carry1;
+	}
+	/*
+	* @brief Updates the list of eliminated players and the turn of a game like `GameEngine::_eliminatePlayers`.
+	* @param {uint8_t} emptyPlayers: bit i is set if player i owns no cell.
+	*/
+	void _eliminatePlayers(uint8_t emptyPlayers, GameState& state, bool updateTurnVariable) const;
+	/*
+	* @brief Stores the explosive sites of the running chain reactions of a block in `bombs`.
+	*/
+	void _findBombs(Block& block) const;
+	/*
+	* @brief Counts a finished game and restarts it from the start position.
+	* @returns {uint8_t} (0-based) id of the winner.
+	*/
+	uint8_t _finishGame(Position& position, GameState& state);
+	inline uint8_t _getEmptyPlayers(const Position& position) const {
+		uint8_t emptyPlayers = 0;
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (!(position.owners[player][0] | position.owners[player][1])) emptyPlayers |= (uint8_t)(1 << player);
+		}
+		return emptyPlayers;
+	}
+	inline void _loadLane(const Block& block, unsigned int lane, Position& position) const {
+		for (unsigned int w = 0; w < 2; w++) {
+			for (unsigned int plane = 0; plane < 3; plane++) position.levels[plane][w] = block.levels[plane][w][lane];
+			for (uint8_t player = 0; player < this->_numberOfPlayers; player++) position.owners[player][w] = block.owners[player][w][lane];
+		}
+	}
+	/*
+	* @brief Plays a uniformly random move in a game.
+	* @param {unsigned int&} word, {uint64_t&} bit: receive the cell of the move, i.e., bit `bit` of word `word` of the masks.
+	* @returns {bool} true if the move starts a chain reaction, i.e., if the cell has become explosive.
+	*/
+	bool _playRandomMove(Position& position, GameState& state, RandomGenerator& random, unsigned int& word, uint64_t& bit) const;
+	/*
+	* @brief Resolves one blast of every running chain reaction of a block, then updates the elimination and turn state of those games like `GameEngine::runBlast`.
+	* @brief The explosive sites of the blast are taken from `bombs`; those of the next blast are stored in turn.
+	* @returns {bool} true if the chain reaction of any game of the block continues.
+	*/
+	bool _runBlast(Block& block, unsigned int firstGame);
+	inline void _storeLane(Block& block, unsigned int lane, const Position& position) const {
+		for (unsigned int w = 0; w < 2; w++) {
+			for (unsigned int plane = 0; plane < 3; plane++) block.levels[plane][w][lane] = position.levels[plane][w];
+			for (uint8_t player = 0; player < this->_numberOfPlayers; player++) block.owners[player][w][lane] = position.owners[player][w];
+		}
+	}
+	/*
+	* @brief Restarts the finished games of a block and plays random moves in every game of the block whose chain reaction is not running.
+	* @param {bool} untilChainReaction: if true, a game keeps playing moves until a move starts a chain reaction (or the move limit is reached); otherwise a single move is played.
+	* @returns {bool} true if any game of the block has a running chain reaction.
+	*/
+	bool _startMoves(Block& block, unsigned int firstGame, bool untilChainReaction);
+};
+#endif //!BATCH_SIMULATOR_H
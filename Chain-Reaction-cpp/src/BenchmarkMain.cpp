@@ -0,0 +1,290 @@
+/* Command-line benchmark suite of the headless engine. It does not include the precompiled header and only links the engine library.
+ Every benchmark has a stable name of the form <benchmark>/<rows>x<columns>/p<players>, so that results can be compared from commit to commit.
+ Usage: Chain-Reaction-cpp-Benchmark [--format csv|json] [--output FILE] [--filter SUBSTRING] [--min-time MS] [--seed S]
+*/
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <vector>
+#include "BatchSimulator.h"
+#include "BitboardEngine.h"
+#include "GameRecord.h"
+#include "RandomPlayer.h"
+
+namespace Benchmark {
+	/*
+	* @brief Result of a single benchmark.
+	* @brief Member variables:
+	* @brief	1. {string} name: stable name of the benchmark.
+	* @brief	2. {double} value: measured value.
+	* @brief	3. {string} unit: unit of the value, e.g., "ns/move" or "games/s".
+	* @brief	4. {uint64_t} iterations: number of measured operations.
+	*/
+	typedef struct Result {
+		std::string name;
+		double value;
+		std::string unit;
+		uint64_t iterations;
+	} Result;
+	/*
+	* @brief Settings of the benchmark run, parsed from the command line.
+	*/
+	typedef struct Settings {
+		std::string format = "csv";
+		std::string outputPath;
+		std::string filter;
+		double minimumSeconds = 0.5; //Minimum measuring time of a single benchmark.
+		uint64_t seed = 12345;
+	} Settings;
+	typedef std::chrono::steady_clock Clock;
+
+	//Fixed set of configurations: small, default and large boards with 2 to 8 players.
+	const unsigned int BOARD_SIZES[][2] = { {6, 6}, {10, 10}, {16, 16}, {32, 32} };
+	const unsigned int PLAYER_COUNTS[] = { 2, 4, 8 };
+	const unsigned int POSITIONS_PER_CONFIGURATION = 32;
+
+	inline double secondsSince(Clock::time_point start) { return std::chrono::duration<double>(Clock::now() - start).count(); }
+	inline void playMove(GameEngine& game, uint32_t cellIndex) {
+		game.processPlayerInput(cellIndex % game.getNumberOfColumns(), cellIndex / game.getNumberOfColumns());
+		game.resolveChainReaction();
+	}
+	/*
+	* @brief Generates reproducible midgame positions by playing seeded random games. The k-th position is taken after k * (cells / positions) + players moves,
+	* @brief so that the set covers the opening to the late game of a board.
+	*/
+	std::vector<GameEngine> createPositions(unsigned int rows, unsigned int columns, unsigned int players, uint64_t seed) {
+		std::vector<GameEngine> positions;
+		RandomPlayer player(seed);
+		const uint32_t cellCount = rows * columns;
+		for (unsigned int k = 0; k < POSITIONS_PER_CONFIGURATION; k++) {
+			GameEngine game;
+			game.setAttribute(rows, columns, (uint8_t)players);
+			const uint32_t plies = players + k * std::max(1u, cellCount / POSITIONS_PER_CONFIGURATION);
+			for (uint32_t ply = 0; ply < plies && !game.hasGameEnded(); ply++) {
+				uint32_t cellIndex;
+				if (!player.findMove(game, cellIndex)) break;
+				GameEngine previous = game;
+				playMove(game, cellIndex);
+				//A position must still be playable; keep the last one before the end of the game.
+				if (game.hasGameEnded()) {
+					game = previous;
+					break;
+				}
+			}
+			positions.push_back(game);
+		}
+		return positions;
+	}
+	/*
+	* @brief Throughput of generating the list of legal moves of a position.
+	*/
+	Result benchmarkMoveGeneration(const std::string& name, const std::vector<GameEngine>& positions, const Settings& settings) {
+		std::vector<uint32_t> moves;
+		uint64_t generated = 0, iterations = 0;
+		const auto start = Clock::now();
+		do {
+			for (const auto& game : positions) {
+				moves.clear();
+				for (uint32_t cellIndex = 0; cellIndex < (uint32_t)game.getBoard().size(); cellIndex++) {
+					if (game.isLegalMove(cellIndex)) moves.push_back(cellIndex);
+				}
+				generated += moves.size();
+				iterations++;
+			}
+		} while (secondsSince(start) < settings.minimumSeconds);
+		return { name, generated / secondsSince(start), "moves/s", iterations };
+	}
+	/*
+	* @brief Average latency of applying a move (including its chain reaction) and undoing it, over every legal move of every position.
+	*/
+	Result benchmarkMoveApplication(const std::string& name, const std::vector<GameEngine>& positions, const Settings& settings) {
+		std::vector<GameEngine> games = positions;
+		uint64_t iterations = 0;
+		const auto start = Clock::now();
+		do {
+			for (auto& game : games) {
+				for (uint32_t cellIndex = 0; cellIndex < (uint32_t)game.getBoard().size(); cellIndex++) {
+					if (!game.isLegalMove(cellIndex)) continue;
+					playMove(game, cellIndex);
+					game.undo();
+					iterations++;
+				}
+			}
+		} while (secondsSince(start) < settings.minimumSeconds);
+		return { name, 1e9 * secondsSince(start) / std::max<uint64_t>(1, iterations), "ns/move", iterations };
+	}
+	/*
+	* @brief Worst-case chain reaction: the longest time taken by a single `resolveChainReaction` call during seeded random games.
+	* @brief Also reports the throughput of complete random games (including the move choice of the random players).
+	*/
+	void benchmarkRandomGames(const std::string& chainName, const std::string& gameName, unsigned int rows, unsigned int columns, unsigned int players, const Settings& settings, std::vector<Result>& results) {
+		RandomPlayer player(settings.seed);
+		GameEngine game;
+		game.setAttribute(rows, columns, (uint8_t)players);
+		double worstChainSeconds = 0.0;
+		uint64_t games = 0, chains = 0;
+		const auto start = Clock::now();
+		do {
+			game.resetGameVariables();
+			while (!game.hasGameEnded()) {
+				uint32_t cellIndex;
+				if (!player.findMove(game, cellIndex)) break;
+				game.processPlayerInput(cellIndex % columns, cellIndex / columns);
+				if (game.hasPendingBlast()) {
+					const auto chainStart = Clock::now();
+					game.resolveChainReaction();
+					worstChainSeconds = std::max(worstChainSeconds, secondsSince(chainStart));
+					chains++;
+				}
+			}
+			games++;
+		} while (secondsSince(start) < settings.minimumSeconds);
+		const double totalSeconds = secondsSince(start);
+		results.push_back({ chainName, 1e6 * worstChainSeconds, "us", chains });
+		results.push_back({ gameName, games / totalSeconds, "games/s", games });
+	}
+	/*
+	* @brief Throughput of complete uniformly random games on the bitboard engine, i.e., of the playouts of the Monte-Carlo search. Only boards of up to 128 cells are supported.
+	*/
+	Result benchmarkBitboardGames(const std::string& name, unsigned int rows, unsigned int columns, unsigned int players, const Settings& settings) {
+		RandomGenerator random(settings.seed);
+		BitboardEngine game;
+		game.setAttribute(rows, columns, (uint8_t)players);
+		uint64_t games = 0;
+		const auto start = Clock::now();
+		do {
+			game.resetGameVariables();
+			while (!game.hasGameEnded()) {
+				const Bitboard::Mask moves = game.getLegalMoves();
+				game.playMove(Bitboard::selectCell(moves, random.below(Bitboard::popCount(moves))));
+			}
+			games++;
+		} while (secondsSince(start) < settings.minimumSeconds);
+		return { name, games / secondsSince(start), "games/s", games };
+	}
+	/*
+	* @brief Throughput of complete uniformly random games played in lockstep by the batch simulator (1024 games at a time).
+	*/
+	Result benchmarkBatchGames(const std::string& name, unsigned int rows, unsigned int columns, unsigned int players, const Settings& settings) {
+		BatchSimulator batch(1024, settings.seed);
+		batch.setAttribute(rows, columns, (uint8_t)players);
+		batch.run(batch.getBatchSize()); //Warm-up, so that the games of the batch are spread over all stages of a game.
+		batch.resetStatistics();
+		const auto start = Clock::now();
+		do {
+			batch.run(batch.getBatchSize());
+		} while (secondsSince(start) < settings.minimumSeconds);
+		return { name, batch.getCompletedGames() / secondsSince(start), "games/s", batch.getCompletedGames() };
+	}
+	/*
+	* @brief Throughput of replaying recorded games through the engine, i.e., of decoding the game-record format and applying every move.
+	* @brief The games are seeded random games which are recorded into memory, hence the file system is not measured.
+	*/
+	Result benchmarkReplay(const std::string& name, unsigned int rows, unsigned int columns, unsigned int players, const Settings& settings) {
+		RandomPlayer player(settings.seed);
+		GameRecordWriter writer;
+		std::vector<uint8_t> records;
+		GameEngine game;
+		game.setAttribute(rows, columns, (uint8_t)players);
+		GameRecord::Header header;
+		header.rows = rows;
+		header.columns = columns;
+		header.playerTypes.assign(players, GameUtilities::RANDOM_PLAYER);
+		header.playerNames.assign(players, "random");
+		for (unsigned int k = 0; k < POSITIONS_PER_CONFIGURATION; k++) {
+			game.resetGameVariables();
+			writer.beginGame(header);
+			uint32_t cellIndex;
+			while (!game.hasGameEnded() && player.findMove(game, cellIndex)) {
+				writer.recordMove(game, cellIndex);
+				playMove(game, cellIndex);
+			}
+			writer.endGame(game.getWinnerIndex());
+			records.insert(records.end(), writer.getGameData().begin(), writer.getGameData().end());
+		}
+		GameRecordReader reader;
+		uint64_t moves = 0, iterations = 0;
+		const auto start = Clock::now();
+		do {
+			reader.open(records.data(), records.size());
+			while (reader.nextGame()) {
+				reader.replay(game);
+				moves += reader.getPly();
+				iterations++;
+			}
+		} while (secondsSince(start) < settings.minimumSeconds);
+		return { name, moves / secondsSince(start), "moves/s", iterations };
+	}
+	bool parseArguments(int argc, char** argv, Settings& settings) {
+		for (int i = 1; i + 1 < argc; i += 2) {
+			const std::string option = argv[i];
+			const char* value = argv[i + 1];
+			if (option == "--format") settings.format = value;
+			else if (option == "--output") settings.outputPath = value;
+			else if (option == "--filter") settings.filter = value;
+			else if (option == "--min-time") settings.minimumSeconds = std::strtod(value, nullptr) / 1000.0;
+			else if (option == "--seed") settings.seed = std::strtoull(value, nullptr, 10);
+			else {
+				std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+				return false;
+			}
+		}
+		if (argc % 2 == 0) {
+			std::fprintf(stderr, "Missing value of option %s\n", argv[argc - 1]);
+			return false;
+		}
+		if (settings.format != "csv" && settings.format != "json") {
+			std::fprintf(stderr, "Unknown format %s (expected csv or json)\n", settings.format.c_str());
+			return false;
+		}
+		return true;
+	}
+	void writeResults(std::ostream& stream, const std::vector<Result>& results, const Settings& settings) {
+		if (settings.format == "csv") {
+			stream << "name,value,unit,iterations\n";
+			for (const auto& result : results) stream << result.name << ',' << result.value << ',' << result.unit << ',' << result.iterations << '\n';
+			return;
+		}
+		stream << "{\n  \"seed\": " << settings.seed << ",\n  \"benchmarks\": [\n";
+		for (size_t i = 0; i < results.size(); i++) {
+			const auto& result = results[i];
+			stream << "    {\"name\": \"" << result.name << "\", \"value\": " << result.value << ", \"unit\": \"" << result.unit << "\", \"iterations\": " << result.iterations << '}' << (i + 1 < results.size() ? ",\n" : "\n");
+		}
+		stream << "  ]\n}\n";
+	}
+}
+int main(int argc, char** argv) {
+	Benchmark::Settings settings;
+	if (!Benchmark::parseArguments(argc, argv, settings)) return 1;
+	std::vector<Benchmark::Result> results;
+	auto isSelected = [&settings](const std::string& name) { return settings.filter.empty() || name.find(settings.filter) != std::string::npos; };
+	for (const auto& size : Benchmark::BOARD_SIZES) {
+		for (const auto& players : Benchmark::PLAYER_COUNTS) {
+			const std::string suffix = "/" + std::to_string(size[0]) + "x" + std::to_string(size[1]) + "/p" + std::to_string(players);
+			const std::string names[7] = { "movegen" + suffix, "apply_undo" + suffix, "chain_worst" + suffix, "random_game" + suffix, "replay" + suffix, "bitboard_game" + suffix, "batch_game" + suffix };
+			if (!std::any_of(std::begin(names), std::end(names), isSelected)) continue;
+			std::fprintf(stderr, "Running benchmarks%s ...\n", suffix.c_str());
+			const std::vector<GameEngine> positions = Benchmark::createPositions(size[0], size[1], players, settings.seed);
+			if (isSelected(names[0])) results.push_back(Benchmark::benchmarkMoveGeneration(names[0], positions, settings));
+			if (isSelected(names[1])) results.push_back(Benchmark::benchmarkMoveApplication(names[1], positions, settings));
+			if (isSelected(names[2]) || isSelected(names[3])) {
+				std::vector<Benchmark::Result> gameResults;
+				Benchmark::benchmarkRandomGames(names[2], names[3], size[0], size[1], players, settings, gameResults);
+				for (const auto& result : gameResults) if (isSelected(result.name)) results.push_back(result);
+			}
+			if (isSelected(names[4])) results.push_back(Benchmark::benchmarkReplay(names[4], size[0], size[1], players, settings));
+			if (isSelected(names[5]) && BitboardEngine::supports(size[0], size[1], players)) results.push_back(Benchmark::benchmarkBitboardGames(names[5], size[0], size[1], players, settings));
+			if (isSelected(names[6]) && BitboardEngine::supports(size[0], size[1], players)) results.push_back(Benchmark::benchmarkBatchGames(names[6], size[0], size[1], players, settings));
+		}
+	}
+	if (settings.outputPath.empty()) Benchmark::writeResults(std::cout, results, settings);
+	else {
+		std::ofstream file(settings.outputPath);
+		Benchmark::writeResults(file, results, settings);
+	}
+	return 0;
+}
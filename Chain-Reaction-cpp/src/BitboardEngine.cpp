@@ -0,0 +1,164 @@
+#include "BitboardEngine.h"
+
+//*************************************** Public methods ****************************************
+
+BitboardEngine::BitboardEngine() {
+	this->setAttribute(8, 6, 2);
+}
+uint8_t BitboardEngine::getOwner(uint32_t cellIndex) const {
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		if (Bitboard::contains(this->_owners[player], cellIndex)) return player;
+	}
+	return 0;
+}
+bool BitboardEngine::loadPosition(const GameEngine& game) {
+	if (game.hasPendingBlast() || !BitboardEngine::supports(game.getNumberOfRows(), game.getNumberOfColumns(), game.getNumberOfPlayers())) return false;
+	if (this->_ROW_DIV != game.getNumberOfRows() || this->_COL_DIV != game.getNumberOfColumns() || this->_numberOfPlayers != game.getNumberOfPlayers()) {
+		this->setAttribute(game.getNumberOfRows(), game.getNumberOfColumns(), (uint8_t)game.getNumberOfPlayers());
+	}
+	//Collect the bitplanes and owner masks as 64 bit words first; a set of cells is only converted to a mask once.
+	uint64_t levels[3][2] = {}, owners[MAX_PLAYERS][2] = {};
+	const auto& board = game.getBoard();
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) {
+		const auto& cell = board[cellIndex];
+		if (!cell.level) continue;
+		const uint64_t bit = 1ULL << (cellIndex & 63);
+		for (unsigned int plane = 0; plane < 3; plane++) {
+			if ((cell.level >> plane) & 1) levels[plane][cellIndex >> 6] |= bit;
+		}
+		owners[cell.owner][cellIndex >> 6] |= bit;
+	}
+	for (unsigned int plane = 0; plane < 3; plane++) this->_levels[plane] = Bitboard::makeMask(levels[plane][0], levels[plane][1]);
+	this->_eliminated = 0;
+	this->_eliminatedCount = 0;
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		this->_owners[player] = Bitboard::makeMask(owners[player][0], owners[player][1]);
+		if (game.isEliminated(player)) {
+			this->_eliminated |= (uint8_t)(1 << player);
+			this->_eliminatedCount++;
+		}
+	}
+	this->_turn = game.getTurn();
+	this->_gameHasEnded = game.hasGameEnded();
+	this->_winnerIndex = game.getWinnerIndex();
+	return true;
+}
+bool BitboardEngine::playMove(uint32_t cellIndex) {
+	if (!this->isLegalMove(cellIndex)) return false;
+	const uint8_t currentPlayer = this->getCurrentPlayer();
+	const Bitboard::Mask cell = Bitboard::getCellMask(cellIndex);
+	this->_addOrbs(cell);
+	this->_owners[currentPlayer] = this->_owners[currentPlayer] | cell;
+	//Only the cell that received the orb can become explosive.
+	Bitboard::Mask bombs = this->_getCriticalCells();
+	if (Bitboard::isEmpty(bombs)) {
+		this->_eliminatePlayers(true);
+		return true;
+	}
+	while (!Bitboard::isEmpty(bombs)) bombs = this->_runBlast(bombs, currentPlayer);
+	return true;
+}
+void BitboardEngine::resetGameVariables(void) {
+	const Bitboard::Mask empty = Bitboard::makeMask(0, 0);
+	for (auto& plane : this->_levels) plane = empty;
+	for (auto& owned : this->_owners) owned = empty;
+	this->_eliminated = 0;
+	this->_eliminatedCount = 0;
+	this->_turn = 0;
+	this->_winnerIndex = 0;
+	this->_gameHasEnded = false;
+}
+void BitboardEngine::setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers) {
+	this->_ROW_DIV = numberOfRows;
+	this->_COL_DIV = numberOfColumns;
+	this->_numberOfPlayers = numberOfPlayers;
+	uint64_t board[2] = {}, firstColumn[2] = {}, lastColumn[2] = {}, criticalMass[4][2] = {};
+	for (uint32_t y = 0; y < numberOfRows; y++) {
+		for (uint32_t x = 0; x < numberOfColumns; x++) {
+			const uint32_t cellIndex = x + y * numberOfColumns;
+			const uint64_t bit = 1ULL << (cellIndex & 63);
+			const unsigned int neighbours = (x > 0) + (x + 1 < numberOfColumns) + (y > 0) + (y + 1 < numberOfRows);
+			board[cellIndex >> 6] |= bit;
+			if (!x) firstColumn[cellIndex >> 6] |= bit;
+			if (x + 1 == numberOfColumns) lastColumn[cellIndex >> 6] |= bit;
+			if (neighbours) criticalMass[neighbours - 1][cellIndex >> 6] |= bit;
+		}
+	}
+	this->_board = Bitboard::makeMask(board[0], board[1]);
+	this->_firstColumn = Bitboard::makeMask(firstColumn[0], firstColumn[1]);
+	this->_lastColumn = Bitboard::makeMask(lastColumn[0], lastColumn[1]);
+	for (unsigned int k = 0; k < 4; k++) this->_criticalMass[k] = Bitboard::makeMask(criticalMass[k][0], criticalMass[k][1]);
+	this->resetGameVariables();
+}
+//******************************************* Private methods ************************************
+
+void BitboardEngine::_eliminatePlayers(bool updateTurnVariable) {
+	//Like GameEngine::_eliminatePlayers, the turn is only passed on once the move has settled, also during the first round.
+	if (this->_turn < this->_numberOfPlayers) {
+		if (updateTurnVariable) this->_turn++;
+		return;
+	}
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		if (!this->isEliminated(player) && Bitboard::isEmpty(this->_owners[player])) {
+			this->_eliminated |= (uint8_t)(1 << player);
+			this->_eliminatedCount++;
+		}
+	}
+	if (updateTurnVariable) {
+		while (1) {
+			this->_turn += 1;
+			if (!this->isEliminated(this->getCurrentPlayer())) break;
+		}
+	}
+}
+unsigned int BitboardEngine::_getPlayersOnBoard(void) const {
+	unsigned int playersOnBoard = 0;
+	for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+		if (!Bitboard::isEmpty(this->_owners[player])) playersOnBoard++;
+	}
+	return playersOnBoard;
+}
+Bitboard::Mask BitboardEngine::_runBlast(Bitboard::Mask bombs, uint8_t bombOwner) {
+	//Every explosive site loses all its orbs. The explosive sites are owned by the bomb owner.
+	for (auto& plane : this->_levels) plane = Bitboard::andNot(plane, bombs);
+	this->_owners[bombOwner] = Bitboard::andNot(this->_owners[bombOwner], bombs);
+	//Every neighbour of an explosive site receives one orb per exploding neighbour. The neighbours in each direction are found by shifting the explosive sites;
+	//horizontal shifts must not wrap around into the next row and vertical shifts must stay on the board.
+	const Bitboard::Mask east = Bitboard::shiftLeft(Bitboard::andNot(bombs, this->_lastColumn), 1);
+	const Bitboard::Mask west = Bitboard::shiftRight(Bitboard::andNot(bombs, this->_firstColumn), 1);
+	this->_addOrbs(east);
+	this->_addOrbs(west);
+	Bitboard::Mask captured = east | west;
+	if (this->_ROW_DIV > 1) {
+		const Bitboard::Mask north = Bitboard::shiftLeft(bombs, this->_COL_DIV) & this->_board;
+		const Bitboard::Mask south = Bitboard::shiftRight(bombs, this->_COL_DIV);
+		this->_addOrbs(north);
+		this->_addOrbs(south);
+		captured = captured | north | south;
+	}
+	this->_capture(captured, bombOwner);
+	//Every explosive site of the next blast has received an orb in this one.
+	Bitboard::Mask nextBombs = this->_getCriticalCells();
+	const bool firstRound = this->_turn < this->_numberOfPlayers;
+	this->_eliminatePlayers(false);
+	if (firstRound && !Bitboard::isEmpty(nextBombs) && this->_getPlayersOnBoard() == 1) {
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (player != bombOwner && !this->isEliminated(player)) {
+				this->_eliminated |= (uint8_t)(1 << player);
+				this->_eliminatedCount++;
+			}
+		}
+	}
+	if (this->_eliminatedCount + 1 == this->_numberOfPlayers) {
+		unsigned int winnerIndex = 1;
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (!this->isEliminated(player)) break;
+			winnerIndex++;
+		}
+		this->_winnerIndex = winnerIndex;
+		this->_gameHasEnded = true;
+		return Bitboard::makeMask(0, 0);
+	}
+	if (Bitboard::isEmpty(nextBombs)) this->_eliminatePlayers(true);
+	return nextBombs;
+}
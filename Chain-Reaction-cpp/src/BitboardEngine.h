@@ -0,0 +1,243 @@
+#pragma once
+#ifndef BITBOARD_ENGINE_H
+#define BITBOARD_ENGINE_H
+
+/* The bitboard engine is part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+ It is an alternative backend of the rules for boards of up to 128 cells (every board of the GUI) which is meant for bulk simulation, e.g., the playouts of
+ the Monte-Carlo search. It keeps no undo/redo history; a position is small enough (a few hundred bytes) to be copied instead.
+ Every attribute of the board is a 128 bit mask over the row-major cell indices: three bitplanes hold the (bit-sliced) number of orbs of every cell and
+ one mask per player holds the cells owned by that player. Finding the explosive sites and resolving one blast of a chain reaction are then a fixed
+ sequence of shift/and/or operations, independent of the number of exploding cells. The masks use SSE2 registers where available, two 64 bit words otherwise.
+*/
+#include <bit>
+#include <cstdint>
+#include "GameEngine.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BITBOARD_USE_SSE2 1
+#include <emmintrin.h>
+#else
+#define BITBOARD_USE_SSE2 0
+#endif //SSE2
+
+namespace Bitboard {
+	/*
+	* @brief A set of board-cells, i.e., a 128 bit mask in which bit i stands for the cell at index i of the row-major board array.
+	*/
+	typedef struct Mask {
+#if BITBOARD_USE_SSE2
+		__m128i bits;
+#else
+		uint64_t low;
+		uint64_t high;
+#endif //BITBOARD_USE_SSE2
+	} Mask;
+
+#if BITBOARD_USE_SSE2
+	inline Mask makeMask(uint64_t low, uint64_t high) { return { _mm_set_epi64x((long long)high, (long long)low) }; }
+	inline Mask operator&(Mask a, Mask b) { return { _mm_and_si128(a.bits, b.bits) }; }
+	inline Mask operator|(Mask a, Mask b) { return { _mm_or_si128(a.bits, b.bits) }; }
+	inline Mask operator^(Mask a, Mask b) { return { _mm_xor_si128(a.bits, b.bits) }; }
+	/*
+	* @brief Returns the cells of a that are not in b.
+	*/
+	inline Mask andNot(Mask a, Mask b) { return { _mm_andnot_si128(b.bits, a.bits) }; }
+	inline bool isEmpty(Mask a) { return _mm_movemask_epi8(_mm_cmpeq_epi8(a.bits, _mm_setzero_si128())) == 0xFFFF; }
+	/*
+	* @brief Shifts a mask towards higher cell indices by 1 to 127 cells. The 64 bit lanes are shifted separately and the bits crossing the lanes are carried over.
+	*/
+	inline Mask shiftLeft(Mask a, unsigned int count) {
+		const __m128i lowToHigh = _mm_slli_si128(a.bits, 8);
+		if (count >= 64) return { _mm_sll_epi64(lowToHigh, _mm_cvtsi32_si128((int)count - 64)) };
+		return { _mm_or_si128(_mm_sll_epi64(a.bits, _mm_cvtsi32_si128((int)count)), _mm_srl_epi64(lowToHigh, _mm_cvtsi32_si128(64 - (int)count))) };
+	}
+	/*
+	* @brief Shifts a mask towards lower cell indices by 1 to 127 cells.
+	*/
+	inline Mask shiftRight(Mask a, unsigned int count) {
+		const __m128i highToLow = _mm_srli_si128(a.bits, 8);
+		if (count >= 64) return { _mm_srl_epi64(highToLow, _mm_cvtsi32_si128((int)count - 64)) };
+		return { _mm_or_si128(_mm_srl_epi64(a.bits, _mm_cvtsi32_si128((int)count)), _mm_sll_epi64(highToLow, _mm_cvtsi32_si128(64 - (int)count))) };
+	}
+	inline void getWords(Mask a, uint64_t (&words)[2]) { _mm_storeu_si128((__m128i*)words, a.bits); }
+#else
+	inline Mask makeMask(uint64_t low, uint64_t high) { return { low, high }; }
+	inline Mask operator&(Mask a, Mask b) { return { a.low & b.low, a.high & b.high }; }
+	inline Mask operator|(Mask a, Mask b) { return { a.low | b.low, a.high | b.high }; }
+	inline Mask operator^(Mask a, Mask b) { return { a.low ^ b.low, a.high ^ b.high }; }
+	inline Mask andNot(Mask a, Mask b) { return { a.low & ~b.low, a.high & ~b.high }; }
+	inline bool isEmpty(Mask a) { return !(a.low | a.high); }
+	inline Mask shiftLeft(Mask a, unsigned int count) {
+		if (count >= 64) return { 0, a.low << (count - 64) };
+		return { a.low << count, (a.high << count) | (a.low >> (64 - count)) };
+	}
+	inline Mask shiftRight(Mask a, unsigned int count) {
+		if (count >= 64) return { a.high >> (count - 64), 0 };
+		return { (a.low >> count) | (a.high << (64 - count)), a.high >> count };
+	}
+	inline void getWords(Mask a, uint64_t (&words)[2]) {
+		words[0] = a.low;
+		words[1] = a.high;
+	}
+#endif //BITBOARD_USE_SSE2
+	/*
+	* @brief Returns the mask of a single board-cell.
+	*/
+	inline Mask getCellMask(uint32_t cellIndex) { return cellIndex < 64 ? makeMask(1ULL << cellIndex, 0) : makeMask(0, 1ULL << (cellIndex - 64)); }
+	inline unsigned int popCount(Mask a) {
+		uint64_t words[2];
+		getWords(a, words);
+		return (unsigned int)(std::popcount(words[0]) + std::popcount(words[1]));
+	}
+	inline bool contains(Mask a, uint32_t cellIndex) { return !isEmpty(a & getCellMask(cellIndex)); }
+	/*
+	* @brief Returns the position of the n-th (0-based) set bit of a word, counted from the lowest bit. The word must have more than n set bits.
+	* @brief The set bits of every byte are counted in parallel and summed up to prefix counts by a multiplication; the byte holding the bit is the number
+	* @brief of prefix counts not exceeding n. This avoids a loop over the lower set bits (and its mispredicted exit) when choosing a random move.
+	*/
+	inline uint32_t selectBit(uint64_t word, unsigned int n) {
+		const uint64_t ONES = 0x0101010101010101ULL, HIGHS = 0x8080808080808080ULL;
+		uint64_t counts = word - ((word >> 1) & 0x5555555555555555ULL);
+		counts = (counts & 0x3333333333333333ULL) + ((counts >> 2) & 0x3333333333333333ULL);
+		counts = (counts + (counts >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+		const uint64_t prefix = counts * ONES; //Byte i holds the number of set bits of the bytes 0 to i.
+		//The high bit of byte i is set if its prefix count does not exceed n (the prefix counts are at most 64, n is less than 64).
+		const uint64_t notExceeding = (((uint64_t)n * ONES) | HIGHS) - prefix;
+		const unsigned int shift = 8 * (unsigned int)((((notExceeding & HIGHS) >> 7) * ONES) >> 56);
+		n -= (unsigned int)(((prefix << 8) >> shift) & 0xFF);
+		uint64_t byte = (word >> shift) & 0xFF;
+		for (; n; n--) byte &= byte - 1;
+		return shift + (uint32_t)std::countr_zero(byte);
+	}
+	/*
+	* @brief Returns the cell index of the n-th (0-based) cell of a mask in ascending order, i.e., the n-th entry of the list of its cell indices.
+	*/
+	inline uint32_t selectCell(Mask a, unsigned int n) {
+		uint64_t words[2];
+		getWords(a, words);
+		const unsigned int lowCount = (unsigned int)std::popcount(words[0]);
+		return n < lowCount ? selectBit(words[0], n) : 64 + selectBit(words[1], n - lowCount);
+	}
+}
+/*
+* @brief A class implementing the rules of the chain reaction game on bitboards. Positions and games are identical to the ones of `GameEngine`
+* @brief (including the order in which players are eliminated and the turn is passed on), but moves are always resolved at once and cannot be undone.
+* @brief Only boards with at most MAX_CELLS cells and MAX_PLAYERS players are supported (see `supports`).
+*/
+class BitboardEngine {
+public:
+	static const unsigned int MAX_CELLS = 128;
+	static const unsigned int MAX_PLAYERS = 8;
+
+	/*
+	* @brief Default constructor of the bitboard engine. Configures a 8 x 6 board with two players.
+	*/
+	BitboardEngine();
+	inline uint32_t getCellCount(uint8_t player) const { return Bitboard::popCount(this->_owners[player]); }
+	inline uint8_t getCurrentPlayer() const { return (uint8_t)(this->_turn % this->_numberOfPlayers); }
+	/*
+	* @brief Returns the cells in which the player who is to make the next move may place an orb, i.e., the empty cells and the cells owned by that player.
+	*/
+	inline Bitboard::Mask getLegalMoves() const {
+		if (this->_gameHasEnded) return Bitboard::makeMask(0, 0);
+		return Bitboard::andNot(this->_board, Bitboard::andNot(this->_getOccupiedCells(), this->_owners[this->getCurrentPlayer()]));
+	}
+	/*
+	* @brief Returns the number of orbs in a board-cell.
+	*/
+	inline uint8_t getLevel(uint32_t cellIndex) const {
+		return (uint8_t)(Bitboard::contains(this->_levels[0], cellIndex) | (Bitboard::contains(this->_levels[1], cellIndex) << 1) | (Bitboard::contains(this->_levels[2], cellIndex) << 2));
+	}
+	inline unsigned int getNumberOfColumns() const { return this->_COL_DIV; }
+	inline unsigned int getNumberOfPlayers() const { return this->_numberOfPlayers; }
+	inline unsigned int getNumberOfRows() const { return this->_ROW_DIV; }
+	/*
+	* @brief Returns the total number of orbs owned by a given player, i.e., the weighted number of the player's cells in each bitplane.
+	*/
+	inline uint32_t getOrbCount(uint8_t player) const {
+		const Bitboard::Mask& owned = this->_owners[player];
+		return Bitboard::popCount(this->_levels[0] & owned) + 2 * Bitboard::popCount(this->_levels[1] & owned) + 4 * Bitboard::popCount(this->_levels[2] & owned);
+	}
+	/*
+	* @brief Returns the (0-based) id of the player owning a board-cell. Only meaningful if the cell is occupied.
+	*/
+	uint8_t getOwner(uint32_t cellIndex) const;
+	inline unsigned int getTurn() const { return this->_turn; }
+	inline unsigned int getWinnerIndex() const { return this->_winnerIndex; }
+	inline bool hasGameEnded() const { return this->_gameHasEnded; }
+	inline bool isEliminated(uint8_t player) const { return (this->_eliminated >> player) & 1; }
+	inline bool isLegalMove(uint32_t cellIndex) const { return cellIndex < this->_ROW_DIV * this->_COL_DIV && Bitboard::contains(this->getLegalMoves(), cellIndex); }
+	/*
+	* @brief Copies a (settled) position of the game engine, e.g., the leaf of a search tree from which a playout is run.
+	* @returns {bool} true if the position was copied, false if its board or number of players is not supported or it has a pending blast.
+	*/
+	bool loadPosition(const GameEngine& game);
+	/*
+	* @brief Places an orb of the player who is to make the next move in a board-cell and resolves the resulting chain reaction.
+	* @param {uint32_t} cellIndex: index of the board-cell in the row-major board array.
+	* @returns {bool} true if the move was applied, false if it is not legal.
+	*/
+	bool playMove(uint32_t cellIndex);
+	/*
+	* @brief Clears the board and the list of eliminated players.
+	*/
+	void resetGameVariables(void);
+	/*
+	* @brief Configures the board dimension and number of players. The board is cleared. Must only be called with a supported configuration (see `supports`).
+	*/
+	void setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers);
+	/*
+	* @brief Checks whether or not the bitboard engine can hold a game of a given configuration, i.e., a board of 2 to MAX_CELLS cells and 2 to MAX_PLAYERS players.
+	*/
+	static inline bool supports(unsigned int numberOfRows, unsigned int numberOfColumns, unsigned int numberOfPlayers) { return numberOfRows * numberOfColumns >= 2 && numberOfRows * numberOfColumns <= MAX_CELLS && numberOfPlayers >= 2 && numberOfPlayers <= MAX_PLAYERS; }
+private:
+	Bitboard::Mask _board; //Every cell of the board.
+	unsigned int _COL_DIV;
+	Bitboard::Mask _criticalMass[4]; //Cells with a critical mass of 1, 2, 3 and 4 orbs respectively.
+	uint8_t _eliminated = 0; //Bit i is set if player i is eliminated.
+	unsigned int _eliminatedCount = 0;
+	Bitboard::Mask _firstColumn;
+	bool _gameHasEnded = false;
+	Bitboard::Mask _lastColumn;
+	Bitboard::Mask _levels[3]; //Bitplanes of the number of orbs of every cell: bit k of the number of orbs of cell i is bit i of _levels[k]. A cell holds at most 7 orbs during a chain reaction.
+	uint8_t _numberOfPlayers;
+	Bitboard::Mask _owners[MAX_PLAYERS]; //Occupied cells owned by each player.
+	unsigned int _ROW_DIV;
+	unsigned int _turn = 0;
+	unsigned int _winnerIndex = 0;
+
+	/*
+	* @brief Adds one orb to every cell of a mask, i.e., increments the bit-sliced counters of those cells.
+	*/
+	inline void _addOrbs(Bitboard::Mask cells) {
+		const Bitboard::Mask carry = this->_levels[0] & cells;
+		this->_levels[0] = this->_levels[0] ^ cells;
+		const Bitboard::Mask secondCarry = this->_levels[1] & carry;
+		this->_levels[1] = this->_levels[1] ^ carry;
+		this->_levels[2] = this->_levels[2] | secondCarry;
+	}
+	/*
+	* @brief Hands the cells of a mask over to a given player.
+	*/
+	inline void _capture(Bitboard::Mask cells, uint8_t player) {
+		for (uint8_t other = 0; other < this->_numberOfPlayers; other++) this->_owners[other] = Bitboard::andNot(this->_owners[other], cells);
+		this->_owners[player] = this->_owners[player] | cells;
+	}
+	void _eliminatePlayers(bool updateTurnVariable);
+	/*
+	* @brief Returns the explosive sites, i.e., the cells holding at least as many orbs as their critical mass.
+	*/
+	inline Bitboard::Mask _getCriticalCells() const {
+		const Bitboard::Mask atLeastTwo = this->_levels[1] | this->_levels[2];
+		const Bitboard::Mask atLeastThree = this->_levels[2] | (this->_levels[1] & this->_levels[0]);
+		return (this->_criticalMass[0] & this->_getOccupiedCells()) | (this->_criticalMass[1] & atLeastTwo) | (this->_criticalMass[2] & atLeastThree) | (this->_criticalMass[3] & this->_levels[2]);
+	}
+	inline Bitboard::Mask _getOccupiedCells() const { return this->_levels[0] | this->_levels[1] | this->_levels[2]; }
+	unsigned int _getPlayersOnBoard(void) const;
+	/*
+	* @brief Resolves a single blast, i.e., explodes all the current explosive sites simultaneously and updates the elimination and turn state like `GameEngine::runBlast`.
+	* @returns {Mask} explosive sites of the next blast (empty once the chain reaction or the game has ended).
+	*/
+	Bitboard::Mask _runBlast(Bitboard::Mask bombs, uint8_t bombOwner);
+};
+#endif //!BITBOARD_ENGINE_H
@@ -0,0 +1,67 @@
+#include "BoardSymmetry.h"
+
+unsigned int BoardSymmetry::getSymmetryHashes(const GameEngine& game, uint64_t (&hashes)[SYMMETRY_COUNT]) {
+	const unsigned int numberOfRows = game.getNumberOfRows(), numberOfColumns = game.getNumberOfColumns();
+	const unsigned int symmetryCount = BoardSymmetry::getSymmetryCount(numberOfRows, numberOfColumns);
+	const auto& board = game.getBoard();
+	uint64_t boardHashes[SYMMETRY_COUNT] = {};
+	for (uint32_t y = 0; y < numberOfRows; y++) {
+		const uint32_t mirroredY = numberOfRows - 1 - y;
+		for (uint32_t x = 0; x < numberOfColumns; x++) {
+			const auto& cell = board[x + y * numberOfColumns];
+			if (!cell.level) continue;
+			const uint32_t mirroredX = numberOfColumns - 1 - x;
+			boardHashes[IDENTITY] ^= GameEngine::getZobristKey(x + y * numberOfColumns, cell.owner, cell.level);
+			boardHashes[MIRROR_X] ^= GameEngine::getZobristKey(mirroredX + y * numberOfColumns, cell.owner, cell.level);
+			boardHashes[MIRROR_Y] ^= GameEngine::getZobristKey(x + mirroredY * numberOfColumns, cell.owner, cell.level);
+			boardHashes[ROTATE_180] ^= GameEngine::getZobristKey(mirroredX + mirroredY * numberOfColumns, cell.owner, cell.level);
+			if (symmetryCount == 4) continue;
+			//On a square board the transposed images swap the roles of x and y (numberOfColumns equals numberOfRows).
+			boardHashes[TRANSPOSE] ^= GameEngine::getZobristKey(y + x * numberOfColumns, cell.owner, cell.level);
+			boardHashes[ROTATE_90] ^= GameEngine::getZobristKey(mirroredY + x * numberOfColumns, cell.owner, cell.level);
+			boardHashes[ROTATE_270] ^= GameEngine::getZobristKey(y + mirroredX * numberOfColumns, cell.owner, cell.level);
+			boardHashes[ANTI_TRANSPOSE] ^= GameEngine::getZobristKey(mirroredY + mirroredX * numberOfColumns, cell.owner, cell.level);
+		}
+	}
+	//The keys of the board dimension and of the player to move are the same for every image; they are contained in the hash of the position.
+	const uint64_t positionKey = game.getHash() ^ boardHashes[IDENTITY];
+	for (unsigned int symmetry = 0; symmetry < symmetryCount; symmetry++) hashes[symmetry] = positionKey ^ boardHashes[symmetry];
+	return symmetryCount;
+}
+uint64_t BoardSymmetry::getCanonicalHash(const GameEngine& game, unsigned int& symmetry) {
+	uint64_t hashes[SYMMETRY_COUNT];
+	const unsigned int symmetryCount = BoardSymmetry::getSymmetryHashes(game, hashes);
+	symmetry = IDENTITY;
+	for (unsigned int k = 1; k < symmetryCount; k++) {
+		if (hashes[k] < hashes[symmetry]) symmetry = k;
+	}
+	return hashes[symmetry];
+}
+uint32_t BoardSymmetry::getCanonicalMove(const GameEngine& game, uint32_t cellIndex, uint64_t& canonicalHash) {
+	uint64_t hashes[SYMMETRY_COUNT];
+	const unsigned int symmetryCount = BoardSymmetry::getSymmetryHashes(game, hashes);
+	canonicalHash = hashes[IDENTITY];
+	for (unsigned int k = 1; k < symmetryCount; k++) {
+		if (hashes[k] < canonicalHash) canonicalHash = hashes[k];
+	}
+	uint32_t canonicalCell = UINT32_MAX;
+	for (unsigned int k = 0; k < symmetryCount; k++) {
+		if (hashes[k] != canonicalHash) continue;
+		const uint32_t mappedCell = BoardSymmetry::mapCell(cellIndex, game.getNumberOfRows(), game.getNumberOfColumns(), k);
+		if (mappedCell < canonicalCell) canonicalCell = mappedCell;
+	}
+	return canonicalCell;
+}
+bool BoardSymmetry::transformPosition(const GameEngine& game, unsigned int symmetry, GameEngine& image) {
+	if (game.hasPendingBlast()) return false;
+	const unsigned int numberOfRows = game.getNumberOfRows(), numberOfColumns = game.getNumberOfColumns();
+	if (image.getNumberOfRows() != numberOfRows || image.getNumberOfColumns() != numberOfColumns || image.getNumberOfPlayers() != game.getNumberOfPlayers()) {
+		image.setAttribute(numberOfRows, numberOfColumns, (uint8_t)game.getNumberOfPlayers());
+	}
+	const auto& board = game.getBoard();
+	std::vector<GameUtilities::BoardCell> imageBoard(board.size());
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) imageBoard[BoardSymmetry::mapCell(cellIndex, numberOfRows, numberOfColumns, symmetry)] = board[cellIndex];
+	std::vector<uint8_t> eliminated(game.getNumberOfPlayers());
+	for (uint8_t player = 0; player < (uint8_t)eliminated.size(); player++) eliminated[player] = game.isEliminated(player) ? 1 : 0;
+	return image.loadPosition(imageBoard, game.getTurn(), eliminated);
+}
@@ -0,0 +1,89 @@
+#pragma once
+#ifndef BOARD_SYMMETRY_H
+#define BOARD_SYMMETRY_H
+
+/* Board symmetries are part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+ The rules of the game only depend on the neighbourhood of the board-cells, hence mirroring a rectangular board (or rotating a square one) maps every position
+ to an equivalent one (same legal moves, same chain reactions, same winner). A rectangular board has 4 such images, a square board 8.
+ Storage that is keyed by position (e.g., the opening book) can therefore share one entry between all images of a position by keying it with the canonical image,
+ i.e., the image with the smallest hash, and by mapping moves into that image (`getCanonicalMove`) and back (`unmapCell`).
+*/
+#include <cstdint>
+#include <utility>
+#include <vector>
+#include "GameEngine.h"
+
+namespace BoardSymmetry {
+	/*
+	* @brief Symmetries of the board. Bit 2 transposes the board (i.e., swaps x and y; square boards only), then bit 0 reverses the columns and bit 1 the rows.
+	* @brief The first 4 symmetries apply to every board, the last 4 only to square boards.
+	*/
+	enum Symmetry {
+		IDENTITY = 0,
+		MIRROR_X = 1, //Reverses the columns, i.e., maps x to (numberOfColumns - 1 - x).
+		MIRROR_Y = 2, //Reverses the rows, i.e., maps y to (numberOfRows - 1 - y).
+		ROTATE_180 = 3,
+		TRANSPOSE = 4, //Mirrors the board at its diagonal through the lower-left cell.
+		ROTATE_90 = 5, //Rotates the board counterclockwise.
+		ROTATE_270 = 6,
+		ANTI_TRANSPOSE = 7 //Mirrors the board at its diagonal through the upper-left cell.
+	};
+	const unsigned int SYMMETRY_COUNT = 8;
+
+	/*
+	* @brief Returns the number of symmetries of a board dimension, i.e., 8 for a square board and 4 otherwise.
+	*/
+	inline unsigned int getSymmetryCount(unsigned int numberOfRows, unsigned int numberOfColumns) { return numberOfRows == numberOfColumns ? 8 : 4; }
+	/*
+	* @brief Returns the symmetry which undoes a given one. Every symmetry except the quarter rotations is its own inverse.
+	*/
+	inline unsigned int getInverse(unsigned int symmetry) { return symmetry == ROTATE_90 ? (unsigned int)ROTATE_270 : (symmetry == ROTATE_270 ? (unsigned int)ROTATE_90 : symmetry); }
+	/*
+	* @brief Maps a board-cell to its position in an image of the board.
+	* @param {uint32_t} cellIndex: index of the board-cell in the row-major board array.
+	* @param {unsigned int} numberOfRows, numberOfColumns: board dimension.
+	* @param {unsigned int} symmetry: one of the `Symmetry` values. It must be less than `getSymmetryCount` of the board dimension.
+	*/
+	inline uint32_t mapCell(uint32_t cellIndex, unsigned int numberOfRows, unsigned int numberOfColumns, unsigned int symmetry) {
+		uint32_t x = cellIndex % numberOfColumns, y = cellIndex / numberOfColumns;
+		if (symmetry & TRANSPOSE) std::swap(x, y);
+		if (symmetry & MIRROR_X) x = numberOfColumns - 1 - x;
+		if (symmetry & MIRROR_Y) y = numberOfRows - 1 - y;
+		return x + y * numberOfColumns;
+	}
+	/*
+	* @brief Maps a board-cell of an image back to the board, i.e., undoes `mapCell`.
+	*/
+	inline uint32_t unmapCell(uint32_t cellIndex, unsigned int numberOfRows, unsigned int numberOfColumns, unsigned int symmetry) { return mapCell(cellIndex, numberOfRows, numberOfColumns, getInverse(symmetry)); }
+	/*
+	* @brief Computes the hash (see `GameEngine::getHash`) of every image of the current position in a single pass over the board.
+	* @param {const GameEngine&} game: the position.
+	* @param {uint64_t[]} hashes: receives the hash of each image, indexed by `Symmetry` value. hashes[IDENTITY] equals game.getHash().
+	* @returns {unsigned int} number of symmetries of the board, i.e., of the hashes that were computed.
+	*/
+	unsigned int getSymmetryHashes(const GameEngine& game, uint64_t (&hashes)[SYMMETRY_COUNT]);
+	/*
+	* @brief Returns the hash of the canonical image of the current position, i.e., the smallest hash of its images.
+	* @param {const GameEngine&} game: the position.
+	* @param {unsigned int&} symmetry: receives the symmetry which maps the position to its canonical image. Cells are mapped with `mapCell` and back with `unmapCell`.
+	*/
+	uint64_t getCanonicalHash(const GameEngine& game, unsigned int& symmetry);
+	/*
+	* @brief Maps a move in the current position to the corresponding move in the canonical image. If the position is itself symmetric, the equivalent moves
+	* @brief are folded onto one, namely the smallest cell index any symmetry onto the canonical image maps the move to.
+	* @param {const GameEngine&} game: the position.
+	* @param {uint32_t} cellIndex: index of the board-cell of the move.
+	* @param {uint64_t&} canonicalHash: receives the hash of the canonical image (see `getCanonicalHash`).
+	* @returns {uint32_t} cell index of the move in the canonical image.
+	*/
+	uint32_t getCanonicalMove(const GameEngine& game, uint32_t cellIndex, uint64_t& canonicalHash);
+	/*
+	* @brief Sets up an image of the current position in another engine, e.g., the canonical form of a position for storing it.
+	* @param {const GameEngine&} game: the position. It must not have a pending blast.
+	* @param {unsigned int} symmetry: the symmetry to apply. The image of a position is mapped back by applying `getInverse(symmetry)` to it.
+	* @param {GameEngine&} image: receives the image. It is configured with the board dimension and number of players of the position; its undo/redo history is cleared.
+	* @returns {bool} true if the image was set up, false if the position has a pending blast.
+	*/
+	bool transformPosition(const GameEngine& game, unsigned int symmetry, GameEngine& image);
+}
+#endif //!BOARD_SYMMETRY_H
@@ -0,0 +1,193 @@
+/* Command-line tool for building and querying an opening book (see OpeningBook.h). It only depends on the headless engine library,
+ hence it does not include the precompiled header.
+ Usage: Chain-Reaction-cpp-Book build BOOK [--rows R] [--columns C] [--players P] [--games N] [--policies random,greedy] [--seed S] [--threads T]
+                                           [--depth D] [--min-games M] [--records FILE]...
+        Chain-Reaction-cpp-Book query BOOK [--rows R] [--columns C] [--players P] [--moves X:Y,X:Y,...]
+ `build` plays seeded self-play games and adds the games of the given record files (e.g., the records of the GUI or of the tournament runner).
+ An existing book is extended, hence books of several board configurations can be collected in one file.
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "GreedyPlayer.h"
+#include "OpeningBook.h"
+#include "RandomPlayer.h"
+
+namespace Book {
+	/*
+	* @brief Settings of the book tool, parsed from the command line.
+	*/
+	typedef struct Settings {
+		unsigned int rows = 8;
+		unsigned int columns = 6;
+		unsigned int players = 2;
+		unsigned int games = 10000; //Number of self-play games.
+		unsigned int threads = 0; //0 selects one worker per hardware thread.
+		unsigned int depth = 12; //Number of moves from the start of a game that are collected.
+		unsigned int minGames = 2; //Moves played in fewer games are left out of the book.
+		uint64_t seed = 1;
+		std::vector<std::string> policies = { "random", "greedy" };
+		std::vector<std::string> recordPaths;
+		std::string moves; //Position of a query, given by the moves from the start.
+	} Settings;
+
+	/*
+	* @brief Creates a computer player for a policy name. Returns null for an unknown name.
+	*/
+	std::unique_ptr<ComputerPlayer> createPlayer(const std::string& policy, uint64_t seed) {
+		if (policy == "random") return std::make_unique<RandomPlayer>(seed);
+		if (policy == "greedy") return std::make_unique<GreedyPlayer>(seed);
+		return nullptr;
+	}
+	/*
+	* @brief Plays a seeded self-play game and adds it to a builder. Seats are rotated over the policies as in the tournament runner.
+	*/
+	void playGame(unsigned int gameIndex, const Settings& settings, std::vector<std::unique_ptr<ComputerPlayer>>& players, GameEngine& game, BookBuilder& builder) {
+		const uint64_t gameSeed = settings.seed * 0x9E3779B97F4A7C15ULL + gameIndex;
+		std::vector<unsigned int> seats;
+		for (unsigned int seat = 0; seat < settings.players; seat++) {
+			seats.push_back((gameIndex + seat) % (unsigned int)settings.policies.size());
+			players[seats.back()]->seed(gameSeed + seat);
+		}
+		game.resetGameVariables();
+		std::vector<uint32_t> moves;
+		while (!game.hasGameEnded()) {
+			uint32_t cellIndex;
+			if (!players[seats[game.getCurrentPlayer()]]->findMove(game, cellIndex)) break;
+			moves.push_back(cellIndex);
+			game.processPlayerInput(cellIndex % settings.columns, cellIndex / settings.columns);
+			game.resolveChainReaction();
+		}
+		builder.addGame(settings.rows, settings.columns, (uint8_t)settings.players, moves, game.getWinnerIndex());
+	}
+	int build(const std::string& bookPath, const Settings& settings) {
+		BookBuilder book(settings.depth);
+		std::error_code error;
+		if (std::filesystem::exists(bookPath, error) && !book.load(bookPath)) {
+			std::fprintf(stderr, "%s is not a valid book\n", bookPath.c_str());
+			return 1;
+		}
+		const size_t loadedEntries = book.getEntryCount();
+		for (const auto& recordPath : settings.recordPaths) {
+			MappedFile records;
+			if (!records.open(recordPath)) {
+				std::fprintf(stderr, "Could not read %s\n", recordPath.c_str());
+				continue;
+			}
+			std::fprintf(stderr, "%s: %llu games\n", recordPath.c_str(), (unsigned long long)book.addRecords(records.getData(), records.getSize()));
+		}
+		unsigned int numberOfThreads = settings.threads ? settings.threads : (std::max)(1u, std::thread::hardware_concurrency());
+		numberOfThreads = (std::min)(numberOfThreads, (std::max)(1u, settings.games));
+		//Every worker collects into its own builder; the builders are merged once all games are played.
+		std::vector<BookBuilder> builders(numberOfThreads, BookBuilder(settings.depth));
+		std::atomic<unsigned int> nextGame = 0;
+		std::vector<std::thread> workers;
+		const auto start = std::chrono::steady_clock::now();
+		for (unsigned int t = 0; t < numberOfThreads; t++) {
+			workers.emplace_back([&settings, &builders, &nextGame, t]() {
+				std::vector<std::unique_ptr<ComputerPlayer>> players;
+				for (const auto& policy : settings.policies) players.push_back(Book::createPlayer(policy, settings.seed + t));
+				GameEngine game;
+				game.setAttribute(settings.rows, settings.columns, (uint8_t)settings.players);
+				for (unsigned int gameIndex = nextGame++; gameIndex < settings.games; gameIndex = nextGame++) Book::playGame(gameIndex, settings, players, game, builders[t]);
+			});
+		}
+		for (auto& worker : workers) worker.join();
+		for (const auto& builder : builders) book.merge(builder);
+		const double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+		if (!book.write(bookPath, settings.minGames)) {
+			std::fprintf(stderr, "Could not write the book %s\n", bookPath.c_str());
+			return 1;
+		}
+		std::printf("Added %llu games (%.2f s of self-play using %u threads); the book holds %zu moves (%zu before)\n", (unsigned long long)book.getGameCount(), totalSeconds, numberOfThreads, book.getEntryCount(), loadedEntries);
+		return 0;
+	}
+	int query(const std::string& bookPath, const Settings& settings) {
+		BookReader book;
+		if (!book.open(bookPath)) {
+			std::fprintf(stderr, "Could not open the book %s\n", bookPath.c_str());
+			return 1;
+		}
+		GameEngine game;
+		game.setAttribute(settings.rows, settings.columns, (uint8_t)settings.players);
+		std::stringstream list(settings.moves);
+		std::string move;
+		while (std::getline(list, move, ',')) {
+			unsigned int x = 0, y = 0;
+			if (std::sscanf(move.c_str(), "%u:%u", &x, &y) != 2 || !game.processPlayerInput(x, y)) {
+				std::fprintf(stderr, "Illegal move %s\n", move.c_str());
+				return 1;
+			}
+			game.resolveChainReaction();
+		}
+		std::vector<OpeningBook::BookMove> moves;
+		if (!book.findMoves(game, moves)) {
+			std::printf("The position is not in the book\n");
+			return 0;
+		}
+		std::printf("%-10s %10s %10s %8s\n", "move", "games", "wins", "win%");
+		for (const auto& bookMove : moves) {
+			const std::string cell = std::to_string(bookMove.cellIndex % settings.columns) + ":" + std::to_string(bookMove.cellIndex / settings.columns);
+			std::printf("%-10s %10u %10u %8.1f\n", cell.c_str(), bookMove.games, bookMove.wins, 100.0 * bookMove.wins / bookMove.games);
+		}
+		return 0;
+	}
+}
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::fprintf(stderr, "Usage: %s build|query BOOK [options]\n", argv[0]);
+		return 1;
+	}
+	const std::string command = argv[1], bookPath = argv[2];
+	Book::Settings settings;
+	for (int i = 3; i < argc; i++) {
+		const std::string option = argv[i];
+		if (i + 1 >= argc) {
+			std::fprintf(stderr, "Missing value of option %s\n", option.c_str());
+			return 1;
+		}
+		const char* value = argv[++i];
+		if (option == "--rows") settings.rows = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--columns") settings.columns = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--players") settings.players = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--games") settings.games = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--threads") settings.threads = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--depth") settings.depth = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--min-games") settings.minGames = (unsigned int)std::strtoul(value, nullptr, 10);
+		else if (option == "--seed") settings.seed = std::strtoull(value, nullptr, 10);
+		else if (option == "--records") settings.recordPaths.push_back(value);
+		else if (option == "--moves") settings.moves = value;
+		else if (option == "--policies") {
+			settings.policies.clear();
+			std::stringstream list(value);
+			std::string policy;
+			while (std::getline(list, policy, ',')) if (!policy.empty()) settings.policies.push_back(policy);
+		}
+		else {
+			std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+			return 1;
+		}
+	}
+	if (settings.players < 2 || (uint64_t)settings.rows * settings.columns < settings.players || settings.players > 255 || settings.policies.empty()) {
+		std::fprintf(stderr, "Invalid board dimension, number of players or list of policies\n");
+		return 1;
+	}
+	for (const auto& policy : settings.policies) {
+		if (!Book::createPlayer(policy, 0)) {
+			std::fprintf(stderr, "Unknown policy %s (expected random or greedy)\n", policy.c_str());
+			return 1;
+		}
+	}
+	if (command == "build") return Book::build(bookPath, settings);
+	if (command == "query") return Book::query(bookPath, settings);
+	std::fprintf(stderr, "Unknown command %s\n", command.c_str());
+	return 1;
+}
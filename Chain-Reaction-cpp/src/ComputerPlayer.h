@@ -0,0 +1,54 @@
+#pragma once
+#ifndef COMPUTER_PLAYER_H
+#define COMPUTER_PLAYER_H
+
+/* Computer players are part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+*/
+#include <atomic>
+#include "GameEngine.h"
+#include "RandomGenerator.h"
+
+namespace GameUtilities {
+	/*
+	* @brief Controller of a player. The values match the order of the player type options in the GUI; the players after MCTS_PLAYER are only used by the tournament runner.
+	* @brief The values are stored in game records and must therefore never change.
+	*/
+	enum PlayerType {
+		HUMAN_PLAYER = 0,
+		ALPHA_BETA_PLAYER = 1,
+		MCTS_PLAYER = 2,
+		RANDOM_PLAYER = 3,
+		GREEDY_PLAYER = 4
+	};
+}
+/*
+* @brief Base class of the computer players. A computer player chooses a move for the player who is to make the next move in a given position.
+* @brief A search may run on a worker thread; `stop` can be called from any other thread for aborting it.
+*/
+class ComputerPlayer {
+public:
+	virtual ~ComputerPlayer() {}
+	/*
+	* @brief Chooses a move for the player who is to make the next move.
+	* @param {const GameEngine&} game: the current position. It must not have a pending blast.
+	* @param {uint32_t&} cellIndex: receives the index of the chosen board-cell in the row-major board array.
+	* @returns {bool} true if a move was found, false if there is no legal move (e.g., the game has ended).
+	*/
+	virtual bool findMove(const GameEngine& game, uint32_t& cellIndex) = 0;
+	/*
+	* @brief Returns the search effort of the last call to `findMove`, i.e., the number of positions visited (tree search) or playouts run (Monte-Carlo search).
+	*/
+	virtual uint64_t getNodeCount() const { return 0; }
+	/*
+	* @brief Reseeds the pseudo random number generator of the player (e.g., for reproducible games). Players are seeded from the current time by default.
+	*/
+	virtual void seed(uint64_t value) { this->_random.seed(value); }
+	/*
+	* @brief Requests the running search to return as soon as possible with the best move found so far.
+	*/
+	inline void stop(void) { this->_stopRequested.store(true, std::memory_order_relaxed); }
+protected:
+	RandomGenerator _random;
+	std::atomic<bool> _stopRequested = false;
+};
+#endif //!COMPUTER_PLAYER_H
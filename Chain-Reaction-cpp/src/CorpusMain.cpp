@@ -0,0 +1,206 @@
+/* Command-line tool for building and querying a replay corpus (see ReplayCorpus.h). It only depends on the headless engine library,
+ hence it does not include the precompiled header.
+ Usage: Chain-Reaction-cpp-Corpus ingest CORPUS PATH... [--memory MB]
+        Chain-Reaction-cpp-Corpus info CORPUS
+        Chain-Reaction-cpp-Corpus query CORPUS [--rows R] [--columns C] [--players P] [--moves X:Y,X:Y,...] [--hash H] [--games N] [--symmetric]
+ PATH is a game-record file or a directory, which is searched recursively for '.crg' files (e.g., the records of the GUI or of the tournament runner).
+ A query position is given by the moves from the start of a game, in board coordinates as accepted by `MainGame::processPlayerInput`, or directly by its hash.
+ With --symmetric, the mirror (and, on square boards, rotated) images of a position given by moves are looked up as well and their replies are mapped back onto the position.
+*/
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "BoardSymmetry.h"
+#include "ReplayCorpus.h"
+
+namespace Corpus {
+	/*
+	* @brief Settings of a query, parsed from the command line.
+	*/
+	typedef struct QuerySettings {
+		unsigned int rows = 8;
+		unsigned int columns = 6;
+		unsigned int players = 2;
+		std::string moves;
+		uint64_t hash = 0;
+		bool hasHash = false;
+		unsigned int games = 10; //Number of games that are listed.
+		bool symmetric = false; //Whether or not the symmetric images of the position are included.
+	} QuerySettings;
+
+	/*
+	* @brief Collects the record files of a path, i.e., the path itself if it is a file, or every '.crg' file below it if it is a directory. The files are sorted, so that ingesting is reproducible.
+	*/
+	std::vector<std::filesystem::path> collectFiles(const std::filesystem::path& path) {
+		std::vector<std::filesystem::path> files;
+		std::error_code error;
+		if (!std::filesystem::is_directory(path, error)) {
+			files.push_back(path);
+			return files;
+		}
+		for (const auto& entry : std::filesystem::recursive_directory_iterator(path, error)) {
+			if (entry.is_regular_file(error) && entry.path().extension() == ".crg") files.push_back(entry.path());
+		}
+		std::sort(files.begin(), files.end());
+		return files;
+	}
+	int ingest(const std::string& corpusPath, const std::vector<std::string>& paths, size_t memoryMegabytes) {
+		CorpusWriter writer;
+		if (!writer.open(corpusPath, memoryMegabytes * 1024 * 1024 / sizeof(ReplayCorpus::IndexEntry))) {
+			std::fprintf(stderr, "Could not open the corpus %s\n", corpusPath.c_str());
+			return 1;
+		}
+		uint64_t games = 0;
+		for (const auto& path : paths) {
+			for (const auto& file : collectFiles(path)) {
+				//Record files are mapped as well, so that large archives are never read into memory as a whole.
+				MappedFile records;
+				if (!records.open(file.string())) {
+					std::fprintf(stderr, "Could not read %s\n", file.string().c_str());
+					continue;
+				}
+				const uint64_t added = writer.addGames(records.getData(), records.getSize());
+				std::fprintf(stderr, "%s: %llu games\n", file.string().c_str(), (unsigned long long)added);
+				games += added;
+			}
+		}
+		const uint64_t skipped = writer.getSkippedGameCount();
+		if (!writer.close()) {
+			std::fprintf(stderr, "Could not write the corpus %s\n", corpusPath.c_str());
+			return 1;
+		}
+		std::printf("Added %llu games (%llu skipped due to malformed data or illegal moves)\n", (unsigned long long)games, (unsigned long long)skipped);
+		return 0;
+	}
+	int info(const std::string& corpusPath) {
+		CorpusReader reader;
+		if (!reader.open(corpusPath)) {
+			std::fprintf(stderr, "Could not open the corpus %s\n", corpusPath.c_str());
+			return 1;
+		}
+		std::printf("segments: %zu\ngames: %llu\npositions: %llu\n", reader.getSegmentCount(), (unsigned long long)reader.getGameCount(), (unsigned long long)reader.getEntryCount());
+		return 0;
+	}
+	int query(const std::string& corpusPath, const QuerySettings& settings) {
+		CorpusReader reader;
+		if (!reader.open(corpusPath)) {
+			std::fprintf(stderr, "Could not open the corpus %s\n", corpusPath.c_str());
+			return 1;
+		}
+		uint64_t hashes[BoardSymmetry::SYMMETRY_COUNT] = { settings.hash };
+		unsigned int symmetryCount = 1;
+		if (!settings.hasHash) {
+			GameEngine game;
+			game.setAttribute(settings.rows, settings.columns, (uint8_t)settings.players);
+			std::stringstream list(settings.moves);
+			std::string move;
+			while (std::getline(list, move, ',')) {
+				unsigned int x = 0, y = 0;
+				if (std::sscanf(move.c_str(), "%u:%u", &x, &y) != 2 || !game.processPlayerInput(x, y)) {
+					std::fprintf(stderr, "Illegal move %s\n", move.c_str());
+					return 1;
+				}
+				game.resolveChainReaction();
+			}
+			if (settings.symmetric) symmetryCount = BoardSymmetry::getSymmetryHashes(game, hashes);
+			else hashes[0] = game.getHash();
+		}
+		//Every image of the position is looked up once (a symmetric position is its own image), and its replies are mapped back onto the position.
+		std::vector<ReplayCorpus::IndexEntry> entries;
+		std::vector<ReplayCorpus::ReplyStatistics> statistics;
+		for (unsigned int symmetry = 0; symmetry < symmetryCount; symmetry++) {
+			if (std::find(hashes, hashes + symmetry, hashes[symmetry]) != hashes + symmetry) continue;
+			reader.findPosition(hashes[symmetry], entries);
+			for (auto reply : reader.getReplyStatistics(hashes[symmetry])) {
+				reply.cellIndex = BoardSymmetry::unmapCell(reply.cellIndex, settings.rows, settings.columns, symmetry);
+				auto merged = std::find_if(statistics.begin(), statistics.end(), [&reply](const ReplayCorpus::ReplyStatistics& other) { return other.cellIndex == reply.cellIndex; });
+				if (merged == statistics.end()) statistics.push_back(reply);
+				else {
+					merged->games += reply.games;
+					merged->wins += reply.wins;
+				}
+			}
+		}
+		std::sort(statistics.begin(), statistics.end(), [](const ReplayCorpus::ReplyStatistics& a, const ReplayCorpus::ReplyStatistics& b) {
+			return a.games != b.games ? a.games > b.games : a.cellIndex < b.cellIndex;
+		});
+		std::set<uint64_t> games;
+		for (const auto& entry : entries) games.insert(entry.getGameOffset());
+		std::printf("position %016llx: %zu occurrences in %zu games\n", (unsigned long long)hashes[0], entries.size(), games.size());
+		if (!statistics.empty()) {
+			std::printf("%-10s %10s %10s %8s\n", "reply", "games", "wins", "win%");
+			for (const auto& reply : statistics) {
+				const std::string cell = std::to_string(reply.cellIndex % settings.columns) + ":" + std::to_string(reply.cellIndex / settings.columns);
+				std::printf("%-10s %10llu %10llu %8.1f\n", settings.hasHash ? std::to_string(reply.cellIndex).c_str() : cell.c_str(), (unsigned long long)reply.games, (unsigned long long)reply.wins, 100.0 * reply.wins / reply.games);
+			}
+		}
+		//List a few of the games with their players, e.g., for looking them up in the original records.
+		for (size_t k = 0; k < entries.size() && k < settings.games; k++) {
+			const auto& entry = entries[k];
+			GameRecordReader game;
+			if (!reader.openGame(entry.getGameOffset(), game) || !game.nextGame()) continue;
+			std::string players;
+			for (const auto& name : game.getHeader().playerNames) players += (players.empty() ? "" : ",") + name;
+			std::printf("game @%llu ply %u winner %u players %s\n", (unsigned long long)entry.getGameOffset(), entry.ply, entry.getWinnerIndex(), players.c_str());
+		}
+		return 0;
+	}
+}
+int main(int argc, char** argv) {
+	if (argc < 3) {
+		std::fprintf(stderr, "Usage: %s ingest|info|query CORPUS [arguments]\n", argv[0]);
+		return 1;
+	}
+	const std::string command = argv[1], corpusPath = argv[2];
+	if (command == "info") return Corpus::info(corpusPath);
+	if (command == "ingest") {
+		std::vector<std::string> paths;
+		size_t memoryMegabytes = 256;
+		for (int i = 3; i < argc; i++) {
+			const std::string argument = argv[i];
+			if (argument == "--memory" && i + 1 < argc) memoryMegabytes = (size_t)std::strtoull(argv[++i], nullptr, 10);
+			else paths.push_back(argument);
+		}
+		return Corpus::ingest(corpusPath, paths, memoryMegabytes);
+	}
+	if (command == "query") {
+		Corpus::QuerySettings settings;
+		for (int i = 3; i < argc; i++) {
+			const std::string option = argv[i];
+			if (option == "--symmetric") {
+				settings.symmetric = true;
+				continue;
+			}
+			if (i + 1 >= argc) {
+				std::fprintf(stderr, "Missing value of option %s\n", option.c_str());
+				return 1;
+			}
+			const char* value = argv[++i];
+			if (option == "--rows") settings.rows = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--columns") settings.columns = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--players") settings.players = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--moves") settings.moves = value;
+			else if (option == "--games") settings.games = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--hash") {
+				settings.hash = std::strtoull(value, nullptr, 16);
+				settings.hasHash = true;
+			}
+			else {
+				std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+				return 1;
+			}
+		}
+		if (settings.players < 2 || (uint64_t)settings.rows * settings.columns < settings.players || settings.players > 255) {
+			std::fprintf(stderr, "Invalid board dimension or number of players\n");
+			return 1;
+		}
+		return Corpus::query(corpusPath, settings);
+	}
+	std::fprintf(stderr, "Unknown command %s\n", command.c_str());
+	return 1;
+}
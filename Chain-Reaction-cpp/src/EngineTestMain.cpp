@@ -0,0 +1,322 @@
+/* Command-line checks of the headless engine. It does not include the precompiled header and only links the engine library.
+ Every check has a stable name and is registered as a separate CTest case (see CMakeLists.txt). The games are seeded, hence every run plays the same games.
+ Usage: Chain-Reaction-cpp-EngineTest [CHECK]. Without a check name every check is run. The exit code is 0 if every check passed and 1 otherwise.
+*/
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include "BatchSimulator.h"
+#include "BitboardEngine.h"
+#include "BoardSymmetry.h"
+#include "GameEngine.h"
+#include "GameRecord.h"
+#include "RandomPlayer.h"
+
+namespace EngineTest {
+	/*
+	* @brief A named check of the engine.
+	* @brief Member variables:
+	* @brief	1. {const char*} name: stable name of the check, i.e., the command-line argument which selects it.
+	* @brief	2. {bool (*)(void)} run: runs the check and returns true if it passed. Failures are reported on stderr.
+	*/
+	typedef struct Check {
+		const char* name;
+		bool (*run)(void);
+	} Check;
+
+	//Configurations of the seeded random games: small, default and large boards with 2 to 8 players.
+	const unsigned int BOARD_SIZES[][2] = { {1, 9}, {2, 2}, {2, 64}, {3, 5}, {6, 6}, {8, 6}, {11, 11}, {16, 8}, {20, 20} };
+	const unsigned int PLAYER_COUNTS[] = { 2, 3, 4, 8 };
+	const unsigned int GAMES_PER_CONFIGURATION = 8;
+	const uint64_t SEED = 12345;
+	//Configurations of the batch simulator check: a single row board, a board spanning both words of a bitboard and the default board.
+	const unsigned int BATCH_BOARD_SIZES[][2] = { {1, 9}, {2, 64}, {8, 6} };
+	const unsigned int BATCH_SIZE = 2 * BatchSimulator::LANES;
+	const unsigned int BATCH_STEPS = 300;
+	/*
+	* @brief A short game with the expected player to move after each of its moves. Single row boards have end cells with a critical mass of 1,
+	* @brief hence a move there explodes right away, which must not cost the next player its turn.
+	* @brief Member variables:
+	* @brief	1. {unsigned int} rows, columns, players: board configuration.
+	* @brief	2. {vector<uint32_t>} moves: cell indices of the moves in the order of play.
+	* @brief	3. {vector<uint8_t>} nextPlayers: (0-based) id of the player who is to move after each move.
+	*/
+	typedef struct TurnScenario {
+		unsigned int rows, columns, players;
+		std::vector<uint32_t> moves;
+		std::vector<uint8_t> nextPlayers;
+	} TurnScenario;
+	const TurnScenario TURN_SCENARIOS[] = {
+		{ 1, 3, 2, { 0 }, { 1 } },
+		{ 1, 4, 3, { 0, 3 }, { 1, 2 } },
+		{ 1, 5, 2, { 0, 4, 1 }, { 1, 0, 1 } }
+	};
+
+	inline void playMove(GameEngine& game, uint32_t cellIndex) {
+		game.processPlayerInput(cellIndex % game.getNumberOfColumns(), cellIndex / game.getNumberOfColumns());
+		game.resolveChainReaction();
+	}
+	/*
+	* @brief Reports a failed check on stderr.
+	* @returns {bool} false, hence a check can return the report.
+	*/
+	bool fail(const std::string& message, unsigned int rows, unsigned int columns, unsigned int players, unsigned int game, unsigned int ply) {
+		std::fprintf(stderr, "FAILED: %s (board %ux%u, %u players, game %u, ply %u)\n", message.c_str(), rows, columns, players, game, ply);
+		return false;
+	}
+	/*
+	* @brief Plays the turn scenarios with the game engine and the bitboard engine and checks the player who is to move after every move, i.e., that a chain reaction
+	* @brief in the first round passes the turn on exactly once.
+	*/
+	bool checkFirstRoundTurn(void) {
+		for (const auto& scenario : TURN_SCENARIOS) {
+			GameEngine game;
+			game.setAttribute(scenario.rows, scenario.columns, (uint8_t)scenario.players);
+			BitboardEngine bitboard;
+			bitboard.setAttribute(scenario.rows, scenario.columns, (uint8_t)scenario.players);
+			for (unsigned int ply = 0; ply < (unsigned int)scenario.moves.size(); ply++) {
+				if (!game.isLegalMove(scenario.moves[ply])) return fail("a move of the scenario is not legal", scenario.rows, scenario.columns, scenario.players, 0, ply);
+				playMove(game, scenario.moves[ply]);
+				if (game.getTurn() != ply + 1 || game.getCurrentPlayer() != scenario.nextPlayers[ply]) return fail("the game engine passed the turn to player " + std::to_string(game.getCurrentPlayer()), scenario.rows, scenario.columns, scenario.players, 0, ply);
+				if (!bitboard.playMove(scenario.moves[ply])) return fail("the bitboard engine rejected a move of the scenario", scenario.rows, scenario.columns, scenario.players, 0, ply);
+				if (bitboard.getTurn() != ply + 1 || bitboard.getCurrentPlayer() != scenario.nextPlayers[ply]) return fail("the bitboard engine passed the turn to player " + std::to_string(bitboard.getCurrentPlayer()), scenario.rows, scenario.columns, scenario.players, 0, ply);
+			}
+		}
+		return true;
+	}
+	/*
+	* @brief Plays seeded random games with the game engine and the same moves with the bitboard engine, and compares the positions after every move.
+	*/
+	bool checkBitboard(void) {
+		for (const auto& size : BOARD_SIZES) {
+			for (const unsigned int players : PLAYER_COUNTS) {
+				if (!BitboardEngine::supports(size[0], size[1], players) || size[0] * size[1] < players) continue;
+				RandomPlayer player(SEED);
+				for (unsigned int k = 0; k < GAMES_PER_CONFIGURATION; k++) {
+					GameEngine game;
+					game.setAttribute(size[0], size[1], (uint8_t)players);
+					BitboardEngine bitboard;
+					bitboard.setAttribute(size[0], size[1], (uint8_t)players);
+					uint32_t cellIndex;
+					for (unsigned int ply = 0; !game.hasGameEnded() && player.findMove(game, cellIndex); ply++) {
+						playMove(game, cellIndex);
+						if (!bitboard.playMove(cellIndex)) return fail("the bitboard engine rejected a legal move", size[0], size[1], players, k, ply);
+						if (bitboard.getTurn() != game.getTurn() || bitboard.getCurrentPlayer() != game.getCurrentPlayer()) return fail("the turn differs", size[0], size[1], players, k, ply);
+						if (bitboard.hasGameEnded() != game.hasGameEnded() || bitboard.getWinnerIndex() != game.getWinnerIndex()) return fail("the end of the game differs", size[0], size[1], players, k, ply);
+						const auto& board = game.getBoard();
+						for (uint32_t cell = 0; cell < (uint32_t)board.size(); cell++) {
+							if (bitboard.getLevel(cell) != board[cell].level || (board[cell].level && bitboard.getOwner(cell) != board[cell].owner)) return fail("board-cell " + std::to_string(cell) + " differs", size[0], size[1], players, k, ply);
+						}
+						for (uint8_t id = 0; id < (uint8_t)players; id++) {
+							if (bitboard.isEliminated(id) != game.isEliminated(id) || bitboard.getOrbCount(id) != game.getOrbCount(id) || bitboard.getCellCount(id) != game.getCellCount(id)) return fail("the state of player " + std::to_string(id) + " differs", size[0], size[1], players, k, ply);
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+	/*
+	* @brief Steps the batch simulator, replays the move of every game with the game engine and compares the positions, the turn and the winner after every step.
+	* @brief Completed games are restarted by the simulator, hence the game engine starts a new game as well.
+	*/
+	bool checkBatch(void) {
+		for (const auto& size : BATCH_BOARD_SIZES) {
+			for (const unsigned int players : PLAYER_COUNTS) {
+				BatchSimulator batch(BATCH_SIZE, SEED);
+				if (size[0] * size[1] < players || !batch.setAttribute(size[0], size[1], (uint8_t)players)) continue;
+				std::vector<GameEngine> games(batch.getBatchSize());
+				for (auto& game : games) game.setAttribute(size[0], size[1], (uint8_t)players);
+				for (unsigned int ply = 0; ply < BATCH_STEPS; ply++) {
+					batch.step();
+					for (unsigned int k = 0; k < batch.getBatchSize(); k++) {
+						GameEngine& game = games[k];
+						const BatchSimulator::StepResult& result = batch.getLastStep(k);
+						if (!game.isLegalMove(result.move)) return fail("the simulator played the illegal move " + std::to_string(result.move), size[0], size[1], players, k, ply);
+						playMove(game, result.move);
+						if (result.winnerIndex != (game.hasGameEnded() ? game.getWinnerIndex() : 0)) return fail("the winner differs", size[0], size[1], players, k, ply);
+						if (game.hasGameEnded()) { //The simulator restarted the game.
+							game = GameEngine();
+							game.setAttribute(size[0], size[1], (uint8_t)players);
+						}
+						if (batch.getTurn(k) != game.getTurn()) return fail("the turn differs", size[0], size[1], players, k, ply);
+						const auto& board = game.getBoard();
+						for (uint32_t cell = 0; cell < (uint32_t)board.size(); cell++) {
+							if (batch.getLevel(k, cell) != board[cell].level || (board[cell].level && batch.getOwner(k, cell) != board[cell].owner)) return fail("board-cell " + std::to_string(cell) + " differs", size[0], size[1], players, k, ply);
+						}
+						for (uint8_t id = 0; id < (uint8_t)players; id++) {
+							if (batch.isEliminated(k, id) != game.isEliminated(id)) return fail("the elimination of player " + std::to_string(id) + " differs", size[0], size[1], players, k, ply);
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+	/*
+	* @brief Plays seeded random games and checks that the incrementally maintained hash equals the hash of the same position loaded from scratch,
+	* @brief and that undoing every move and redoing it again restores the hash of each position.
+	*/
+	bool checkHashHistory(void) {
+		for (const auto& size : BOARD_SIZES) {
+			for (const unsigned int players : PLAYER_COUNTS) {
+				if (size[0] * size[1] < players) continue;
+				RandomPlayer player(SEED);
+				for (unsigned int k = 0; k < GAMES_PER_CONFIGURATION; k++) {
+					GameEngine game, loaded;
+					game.setAttribute(size[0], size[1], (uint8_t)players);
+					loaded.setAttribute(size[0], size[1], (uint8_t)players);
+					std::vector<uint64_t> hashes = { game.getHash() }; //Hash of the position after each number of moves.
+					std::vector<uint8_t> eliminated(players);
+					uint32_t cellIndex;
+					while (!game.hasGameEnded() && player.findMove(game, cellIndex)) {
+						playMove(game, cellIndex);
+						hashes.push_back(game.getHash());
+						if (game.hasGameEnded()) break; //A won position is not a settled position which can be loaded.
+						for (uint8_t id = 0; id < (uint8_t)players; id++) eliminated[id] = game.isEliminated(id) ? 1 : 0;
+						if (!loaded.loadPosition(game.getBoard(), game.getTurn(), eliminated)) return fail("the position could not be loaded", size[0], size[1], players, k, (unsigned int)hashes.size() - 1);
+						if (loaded.getHash() != game.getHash()) return fail("the incremental hash differs from the hash of the loaded position", size[0], size[1], players, k, (unsigned int)hashes.size() - 1);
+					}
+					for (size_t ply = hashes.size() - 1; ply > 0; ply--) {
+						if (!game.undo()) return fail("a move could not be undone", size[0], size[1], players, k, (unsigned int)ply);
+						if (game.getHash() != hashes[ply - 1]) return fail("the hash is not restored by undo", size[0], size[1], players, k, (unsigned int)ply - 1);
+					}
+					for (size_t ply = 1; ply < hashes.size(); ply++) {
+						if (!game.redo()) return fail("a move could not be redone", size[0], size[1], players, k, (unsigned int)ply);
+						if (game.getHash() != hashes[ply]) return fail("the hash is not restored by redo", size[0], size[1], players, k, (unsigned int)ply);
+					}
+				}
+			}
+		}
+		return true;
+	}
+	/*
+	* @brief Records seeded random games (with checkpoints and an undone and redone last move), reads them back and checks the header, the moves,
+	* @brief the final position and the position set up by seeking into the middle of the game.
+	*/
+	bool checkRecordRoundTrip(void) {
+		for (const auto& size : BOARD_SIZES) {
+			for (const unsigned int players : PLAYER_COUNTS) {
+				if (size[0] * size[1] < players) continue;
+				RandomPlayer player(SEED);
+				for (unsigned int k = 0; k < GAMES_PER_CONFIGURATION; k++) {
+					GameRecord::Header header;
+					header.rows = size[0];
+					header.columns = size[1];
+					for (unsigned int id = 0; id < players; id++) {
+						header.playerTypes.push_back((uint8_t)GameUtilities::RANDOM_PLAYER);
+						header.playerNames.push_back("random " + std::to_string(id));
+					}
+					header.seed = SEED + k;
+					header.checkpointInterval = 4;
+					GameEngine game;
+					game.setAttribute(size[0], size[1], (uint8_t)players);
+					GameRecordWriter writer; //No file is opened, the encoded game is taken from the writer.
+					writer.beginGame(header);
+					std::vector<uint32_t> moves;
+					std::vector<uint64_t> hashes = { game.getHash() }; //Hash of the position after each number of moves.
+					uint32_t cellIndex;
+					while (!game.hasGameEnded() && player.findMove(game, cellIndex)) {
+						writer.recordMove(game, cellIndex);
+						playMove(game, cellIndex);
+						moves.push_back(cellIndex);
+						hashes.push_back(game.getHash());
+					}
+					if (!(writer.undoMove() && game.undo() && writer.redoMove(game) && game.redo())) return fail("the last move could not be undone and redone", size[0], size[1], players, k, (unsigned int)moves.size());
+					if (!writer.endGame(game.getWinnerIndex())) return fail("the game could not be ended", size[0], size[1], players, k, (unsigned int)moves.size());
+					const std::vector<uint8_t> data = writer.getGameData();
+					GameRecordReader reader;
+					reader.open(data.data(), data.size());
+					if (!reader.nextGame()) return fail("the game could not be read", size[0], size[1], players, k, 0);
+					const GameRecord::Header& readHeader = reader.getHeader();
+					if (readHeader.rows != header.rows || readHeader.columns != header.columns || readHeader.playerTypes != header.playerTypes || readHeader.playerNames != header.playerNames || readHeader.seed != header.seed || readHeader.checkpointInterval != header.checkpointInterval) return fail("the header differs", size[0], size[1], players, k, 0);
+					for (uint32_t ply = 0; ply < (uint32_t)moves.size(); ply++) {
+						if (!reader.nextMove(cellIndex) || cellIndex != moves[ply]) return fail("the move differs", size[0], size[1], players, k, ply);
+					}
+					if (reader.nextMove(cellIndex) || reader.hasError() || reader.getWinnerIndex() != game.getWinnerIndex()) return fail("the end of the game differs", size[0], size[1], players, k, (unsigned int)moves.size());
+					if (reader.nextGame()) return fail("the record holds more than one game", size[0], size[1], players, k, 0);
+					GameEngine replayed;
+					reader.open(data.data(), data.size());
+					if (!(reader.nextGame() && reader.replay(replayed)) || replayed.getHash() != game.getHash() || replayed.getWinnerIndex() != game.getWinnerIndex()) return fail("the replayed position differs", size[0], size[1], players, k, (unsigned int)moves.size());
+					const uint32_t middle = (uint32_t)moves.size() / 2;
+					reader.open(data.data(), data.size());
+					if (!(reader.nextGame() && reader.seek(replayed, middle)) || replayed.getHash() != hashes[middle]) return fail("the position set up by seeking differs", size[0], size[1], players, k, middle);
+				}
+			}
+		}
+		return true;
+	}
+	/*
+	* @brief Checks that every symmetry of a board composed with its inverse (see `BoardSymmetry::getInverse`) is the identity, both on the board-cells
+	* @brief and on the positions of seeded random games, and that the hash of every image of a position matches `BoardSymmetry::getSymmetryHashes`.
+	*/
+	bool checkSymmetryInverse(void) {
+		for (const auto& size : BOARD_SIZES) {
+			const unsigned int rows = size[0], columns = size[1];
+			const uint32_t cellCount = rows * columns;
+			const unsigned int symmetryCount = BoardSymmetry::getSymmetryCount(rows, columns);
+			for (unsigned int symmetry = 0; symmetry < symmetryCount; symmetry++) {
+				const unsigned int inverse = BoardSymmetry::getInverse(symmetry);
+				std::vector<bool> isMapped(cellCount, false);
+				for (uint32_t cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+					const uint32_t image = BoardSymmetry::mapCell(cellIndex, rows, columns, symmetry);
+					if (image >= cellCount || isMapped[image]) return fail("symmetry " + std::to_string(symmetry) + " does not permute the board-cells", rows, columns, 0, 0, 0);
+					isMapped[image] = true;
+					if (BoardSymmetry::mapCell(image, rows, columns, inverse) != cellIndex || BoardSymmetry::unmapCell(image, rows, columns, symmetry) != cellIndex) return fail("symmetry " + std::to_string(symmetry) + " composed with its inverse moves board-cell " + std::to_string(cellIndex), rows, columns, 0, 0, 0);
+				}
+			}
+			for (const unsigned int players : PLAYER_COUNTS) {
+				if (cellCount < players) continue;
+				RandomPlayer player(SEED);
+				for (unsigned int k = 0; k < GAMES_PER_CONFIGURATION; k++) {
+					GameEngine game, image, restored;
+					game.setAttribute(rows, columns, (uint8_t)players);
+					uint64_t hashes[BoardSymmetry::SYMMETRY_COUNT];
+					uint32_t cellIndex;
+					for (unsigned int ply = 1; !game.hasGameEnded() && player.findMove(game, cellIndex); ply++) {
+						playMove(game, cellIndex);
+						if (ply % 4 && !game.hasGameEnded()) continue; //Every image costs a full board copy, hence only every 4th position (and the final one) is checked.
+						BoardSymmetry::getSymmetryHashes(game, hashes);
+						for (unsigned int symmetry = 0; symmetry < symmetryCount; symmetry++) {
+							if (!(BoardSymmetry::transformPosition(game, symmetry, image) && BoardSymmetry::transformPosition(image, BoardSymmetry::getInverse(symmetry), restored))) return fail("the position could not be transformed", rows, columns, players, k, ply);
+							if (image.getHash() != hashes[symmetry]) return fail("the hash of image " + std::to_string(symmetry) + " differs", rows, columns, players, k, ply);
+							if (restored.getHash() != game.getHash()) return fail("symmetry " + std::to_string(symmetry) + " composed with its inverse changes the position", rows, columns, players, k, ply);
+							for (uint32_t cell = 0; cell < cellCount; cell++) {
+								if (restored.getBoard()[cell].level != game.getBoard()[cell].level || (game.getBoard()[cell].level && restored.getBoard()[cell].owner != game.getBoard()[cell].owner)) return fail("symmetry " + std::to_string(symmetry) + " composed with its inverse changes board-cell " + std::to_string(cell), rows, columns, players, k, ply);
+							}
+						}
+					}
+				}
+			}
+		}
+		return true;
+	}
+
+	const Check CHECKS[] = {
+		{ "first-round-turn", checkFirstRoundTurn },
+		{ "bitboard", checkBitboard },
+		{ "batch", checkBatch },
+		{ "hash-history", checkHashHistory },
+		{ "record-round-trip", checkRecordRoundTrip },
+		{ "symmetry-inverse", checkSymmetryInverse }
+	};
+}
+
+int main(int argc, char** argv) {
+	const char* selected = argc > 1 ? argv[1] : nullptr;
+	bool isFound = false, hasPassed = true;
+	for (const auto& check : EngineTest::CHECKS) {
+		if (selected && std::strcmp(selected, check.name)) continue;
+		isFound = true;
+		const bool passed = check.run();
+		std::fprintf(stderr, "%s: %s\n", check.name, passed ? "passed" : "FAILED");
+		hasPassed = hasPassed && passed;
+	}
+	if (!isFound) {
+		std::fprintf(stderr, "Unknown check '%s'.\n", selected);
+		return 1;
+	}
+	return hasPassed ? 0 : 1;
+}
@@ -0,0 +1,242 @@
+#include "GameEngine.h"
+#include <algorithm>
+#include <cassert>
+
+//*************************************** Public methods ****************************************
+
+GameEngine::GameEngine() {
+	this->_ROW_DIV = 8;
+	this->_COL_DIV = 6;
+	this->_numberOfPlayers = 2;
+	this->_buildNeighbourTable();
+	this->resetGameVariables();
+}
+bool GameEngine::loadPosition(const std::vector<GameUtilities::BoardCell>& board, unsigned int turn, const std::vector<uint8_t>& eliminated) {
+	if (board.size() != this->_BOARD.size() || eliminated.size() != this->_numberOfPlayers) return false;
+	unsigned int eliminatedCount = 0;
+	for (const auto& isEliminated : eliminated) if (isEliminated) eliminatedCount++;
+	const bool gameHasEnded = (eliminatedCount + 1 == this->_numberOfPlayers);
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) {
+		const auto& cell = board[cellIndex];
+		if (!cell.level) continue;
+		if (cell.owner >= this->_numberOfPlayers || eliminated[cell.owner]) return false;
+		//Only a finished game may contain explosive sites (a chain reaction is stopped once the game ends).
+		if (!gameHasEnded && cell.level >= this->_criticalMass[cellIndex]) return false;
+	}
+	this->resetGameVariables();
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)board.size(); cellIndex++) {
+		if (board[cellIndex].level) this->_setCell(cellIndex, board[cellIndex]);
+	}
+	this->_eliminated = eliminated;
+	this->_eliminatedCount = eliminatedCount;
+	this->_turn = turn;
+	if (gameHasEnded) {
+		this->_winnerIndex = 1 + (unsigned int)(std::find(eliminated.begin(), eliminated.end(), 0) - eliminated.begin());
+		this->_gameHasEnded = true;
+	}
+	return true;
+}
+bool GameEngine::processPlayerInput(uint32_t boardCoordinateX, uint32_t boardCoordinateY) {
+	if (this->_gameHasEnded || this->hasPendingBlast()) return false; //Current board has bombs which needs to be taken care of before processing any input.
+	if (boardCoordinateX >= this->_COL_DIV || boardCoordinateY >= this->_ROW_DIV) return false;
+	const uint8_t currentPlayerIndex = this->getCurrentPlayer();
+	if (this->getCell(boardCoordinateX, boardCoordinateY).level && this->getCell(boardCoordinateX, boardCoordinateY).owner != currentPlayerIndex) return false;
+	this->_startMoveRecord();
+	const uint32_t cellIndex = this->getCellIndex(boardCoordinateX, boardCoordinateY);
+	this->_addOrb(cellIndex, currentPlayerIndex);
+	//Only the cell that received the orb can become explosive.
+	if (this->_isCritical(cellIndex)) this->_currentBombs.push_back(cellIndex);
+	if (this->_currentBombs.empty()) this->_eliminatePlayers(true);
+	return true;
+}
+void GameEngine::resetGameVariables(void) {
+	this->_BOARD.assign((size_t)this->_ROW_DIV * this->_COL_DIV, GameUtilities::BoardCell());
+	this->_boardHash = 0;
+	this->_dimensionKey = GameEngine::_mixHash((1ULL << 62) ^ ((uint64_t)this->_ROW_DIV << 32) ^ ((uint64_t)this->_COL_DIV << 8) ^ this->_numberOfPlayers);
+	this->_waveMark.assign(this->_BOARD.size(), 0);
+	this->_waveCount = 0;
+	this->_moveMark.assign(this->_BOARD.size(), 0);
+	this->_moveCount = 0;
+	this->_history.clear();
+	this->_historyChanges.clear();
+	this->_historyEliminations.clear();
+	this->_historyPosition = 0;
+	this->_cellCount.assign(this->_numberOfPlayers, 0);
+	this->_orbCount.assign(this->_numberOfPlayers, 0);
+	this->_playersOnBoard = 0;
+	this->_eliminated.assign(this->_numberOfPlayers, 0);
+	this->_eliminatedCount = 0;
+	this->_currentBombs.clear();
+	this->_turn = 0;
+	this->_gameHasEnded = false;
+}
+bool GameEngine::redo(void) {
+	if (!this->canRedo()) return false;
+	const size_t moveIndex = this->_historyPosition++;
+	const auto& move = this->_history[moveIndex];
+	const size_t lastChange = moveIndex + 1 < this->_history.size() ? this->_history[moveIndex + 1].firstChange : this->_historyChanges.size();
+	const size_t lastElimination = moveIndex + 1 < this->_history.size() ? this->_history[moveIndex + 1].firstElimination : this->_historyEliminations.size();
+	for (size_t i = move.firstChange; i < lastChange; i++) {
+		const auto& change = this->_historyChanges[i];
+		this->_setCell(change.cellIndex, change.after);
+	}
+	for (size_t i = move.firstElimination; i < lastElimination; i++) {
+		this->_eliminated[this->_historyEliminations[i]] = 1;
+		this->_eliminatedCount++;
+	}
+	this->_turn = move.turnAfter;
+	this->_winnerIndex = move.winnerIndex;
+	this->_gameHasEnded = (move.winnerIndex != 0);
+	return true;
+}
+bool GameEngine::resolveChainReaction(std::vector<std::vector<uint32_t>>* waves) {
+	while (this->hasPendingBlast()) {
+		if (waves != nullptr) waves->push_back(this->_currentBombs);
+		if (this->runBlast()) return true;
+	}
+	return this->_gameHasEnded;
+}
+bool GameEngine::runBlast(void) {
+	if (this->_gameHasEnded) return true;
+	if (!this->hasPendingBlast()) return false;
+	const uint8_t bombOwner = this->_BOARD[this->_currentBombs[0]].owner;
+	for (const auto& bombIndex : this->_currentBombs) this->_clearCell(bombIndex);
+	//Every neighbour of an explosive site receives one orb per exploding neighbour and is captured by the owner of the bombs.
+	for (const auto& bombIndex : this->_currentBombs) {
+		const uint32_t* neighbours = &this->_neighbourTable[4 * (size_t)bombIndex];
+		for (uint8_t k = 0; k < this->_criticalMass[bombIndex]; k++) this->_addOrb(neighbours[k], bombOwner);
+	}
+	//Update the current list of explosive sites. Only the neighbours of the exploded sites can become explosive; those are processed in the next blast.
+	this->_waveCount++;
+	this->_nextBombs.clear();
+	for (const auto& bombIndex : this->_currentBombs) {
+		const uint32_t* neighbours = &this->_neighbourTable[4 * (size_t)bombIndex];
+		for (uint8_t k = 0; k < this->_criticalMass[bombIndex]; k++) {
+			const uint32_t neighbourIndex = neighbours[k];
+			if (this->_waveMark[neighbourIndex] == this->_waveCount) continue;
+			this->_waveMark[neighbourIndex] = this->_waveCount;
+			if (this->_isCritical(neighbourIndex)) this->_nextBombs.push_back(neighbourIndex);
+		}
+	}
+	this->_currentBombs.swap(this->_nextBombs);
+	const bool firstRound = this->_turn < this->_numberOfPlayers;
+	//Update the list of eliminated players after a blast. This does not alter the turn variable of the game.
+	this->_eliminatePlayers(false);
+	//Players are not eliminated during the first round. A chain reaction on a board owned by a single player may however never settle (e.g., on a single row board), hence it is stopped here.
+	if (firstRound && this->hasPendingBlast() && this->_playersOnBoard == 1) {
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (player != bombOwner && !(this->isEliminated(player))) this->_eliminate(player);
+		}
+	}
+	//Check if game has ended after a blast:
+	if (this->_eliminatedCount + 1 == this->_numberOfPlayers) {
+		unsigned int winnerIndex = 1;
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (!(this->isEliminated(player))) break;
+			winnerIndex++;
+		}
+		this->_winnerIndex = winnerIndex;
+		this->_gameHasEnded = true;
+		this->_currentBombs.clear();
+		return true;
+	}
+	//A full sequence of blasts is completed. Update the list of eliminated players and pass the turn on to the next player.
+	if (this->_currentBombs.empty()) this->_eliminatePlayers(true);
+	return false;
+}
+void GameEngine::setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers) {
+	this->_ROW_DIV = numberOfRows;
+	this->_COL_DIV = numberOfColumns;
+	if (numberOfPlayers) this->_numberOfPlayers = numberOfPlayers;
+	assert((uint64_t)numberOfRows * numberOfColumns >= this->_numberOfPlayers); //Otherwise a player finds no empty cell for the first move.
+	this->_buildNeighbourTable();
+	this->resetGameVariables();
+}
+bool GameEngine::undo(void) {
+	if (!this->canUndo()) return false; //safeguard against undoing when a blast is ongoing.
+	const size_t moveIndex = --this->_historyPosition;
+	auto& move = this->_history[moveIndex];
+	const size_t lastChange = moveIndex + 1 < this->_history.size() ? this->_history[moveIndex + 1].firstChange : this->_historyChanges.size();
+	const size_t lastElimination = moveIndex + 1 < this->_history.size() ? this->_history[moveIndex + 1].firstElimination : this->_historyEliminations.size();
+	//Keep the state after the move for redoing it later.
+	move.turnAfter = this->_turn;
+	move.winnerIndex = this->_winnerIndex;
+	for (size_t i = move.firstChange; i < lastChange; i++) {
+		auto& change = this->_historyChanges[i];
+		change.after = this->_BOARD[change.cellIndex];
+		this->_setCell(change.cellIndex, change.before);
+	}
+	for (size_t i = move.firstElimination; i < lastElimination; i++) {
+		this->_eliminated[this->_historyEliminations[i]] = 0;
+		this->_eliminatedCount--;
+	}
+	this->_turn = move.turnBefore;
+	this->_winnerIndex = 0;
+	this->_gameHasEnded = false;
+	return true;
+}
+//******************************************* Private methods ************************************
+
+void GameEngine::_buildNeighbourTable(void) {
+	const uint32_t cellCount = this->_ROW_DIV * this->_COL_DIV;
+	this->_criticalMass.assign(cellCount, 0);
+	this->_neighbourTable.assign(4 * (size_t)cellCount, 0);
+	for (uint32_t cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		const uint32_t x = cellIndex % this->_COL_DIV, y = cellIndex / this->_COL_DIV;
+		uint32_t* neighbours = &this->_neighbourTable[4 * (size_t)cellIndex];
+		uint8_t count = 0;
+		if (x + 1 != this->_COL_DIV) neighbours[count++] = cellIndex + 1;
+		if (x >= 1) neighbours[count++] = cellIndex - 1;
+		if (y + 1 != this->_ROW_DIV) neighbours[count++] = cellIndex + this->_COL_DIV;
+		if (y >= 1) neighbours[count++] = cellIndex - this->_COL_DIV;
+		this->_criticalMass[cellIndex] = count;
+	}
+}
+void GameEngine::_eliminatePlayers(bool updateTurnVariable) {
+	//Players are not eliminated during the first round. The turn is only passed on once the move has settled, not after every blast of its chain reaction.
+	if ((this->_turn) < this->_numberOfPlayers) {
+		if (updateTurnVariable) this->_turn++;
+		return;
+	}
+	//Every player without a board-cell is eliminated. The per-player scan is only needed if such a player is not yet marked as eliminated.
+	if (this->_playersOnBoard + this->_eliminatedCount < this->_numberOfPlayers) {
+		for (uint8_t player = 0; player < this->_numberOfPlayers; player++) {
+			if (!(this->isEliminated(player)) && !this->_cellCount[player]) this->_eliminate(player);
+		}
+	}
+	if (updateTurnVariable) {
+		while (1) {
+			this->_turn += 1;
+			if (!(this->isEliminated(this->getCurrentPlayer()))) break;
+		}
+	}
+}
+void GameEngine::_setCell(uint32_t cellIndex, GameUtilities::BoardCell value) {
+	auto& cell = this->_BOARD[cellIndex];
+	this->_boardHash ^= GameEngine::_zobristKey(cellIndex, cell.owner, cell.level) ^ GameEngine::_zobristKey(cellIndex, value.owner, value.level);
+	if (cell.level) {
+		this->_orbCount[cell.owner] -= cell.level;
+		if (!--this->_cellCount[cell.owner]) this->_playersOnBoard--;
+	}
+	cell = value;
+	if (cell.level) {
+		this->_orbCount[cell.owner] += cell.level;
+		if (!this->_cellCount[cell.owner]++) this->_playersOnBoard++;
+	}
+}
+void GameEngine::_startMoveRecord(void) {
+	if (this->_historyPosition < this->_history.size()) {
+		this->_historyChanges.resize(this->_history[this->_historyPosition].firstChange);
+		this->_historyEliminations.resize(this->_history[this->_historyPosition].firstElimination);
+		this->_history.resize(this->_historyPosition);
+	}
+	GameUtilities::MoveRecord move;
+	move.firstChange = (uint32_t)this->_historyChanges.size();
+	move.firstElimination = (uint32_t)this->_historyEliminations.size();
+	move.turnBefore = this->_turn;
+	move.turnAfter = this->_turn;
+	move.winnerIndex = 0;
+	this->_history.push_back(move);
+	this->_historyPosition++;
+	this->_moveCount++;
+}
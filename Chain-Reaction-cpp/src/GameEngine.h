@@ -0,0 +1,300 @@
+#pragma once
+#ifndef GAME_ENGINE_H
+#define GAME_ENGINE_H
+
+/* The game engine is a headless implementation of the chain reaction rules. It is compiled into a separate static library
+ and must therefore not depend on wxWidgets, OpenGL or OpenAL. For this reason it does not include the precompiled header.
+*/
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include <utility>
+
+namespace GameUtilities {
+	/*
+	* @brief A structure for storing the state of a board-cell. The board is stored as a contiguous row-major array of cells,
+	* @brief i.e., the cell at board coordinate (x, y) is located at index x + y * numberOfColumns.
+	* @brief Member variables:
+	* @brief	1. {uint8_t} owner: (0-based) id of the player owning the cell. Only meaningful if the cell is occupied.
+	* @brief	2. {uint8_t} level: number of orbs in the cell. Value 0 indicates an empty cell.
+	*/
+	typedef struct BoardCell {
+		uint8_t owner;
+		uint8_t level;
+		BoardCell() : owner(0), level(0) {};
+	} BoardCell;
+	/*
+	* @brief A structure for storing the change of a single board-cell caused by a move (including the chain reaction that followed it).
+	* @brief Member variables:
+	* @brief	1. {uint32_t} cellIndex: index of the board-cell in the row-major board array.
+	* @brief	2. {BoardCell} before: state of the cell before the move.
+	* @brief	3. {BoardCell} after: state of the cell after the move. It is filled in when the move is undone and used for redoing the move.
+	*/
+	typedef struct CellChange {
+		uint32_t cellIndex;
+		BoardCell before;
+		BoardCell after;
+	} CellChange;
+	/*
+	* @brief A structure for storing a move in the undo/redo history. The cell changes and eliminations of a move are stored contiguously in shared arrays,
+	* @brief the ranges of a move end where the ranges of the next move begin.
+	* @brief Member variables:
+	* @brief	1. {uint32_t} firstChange: index of the first cell change of the move.
+	* @brief	2. {uint32_t} firstElimination: index of the first player eliminated by the move.
+	* @brief	3. {unsigned int} turnBefore, turnAfter: value of the turn variable before and after the move.
+	* @brief	4. {unsigned int} winnerIndex: (1-based) index of the winner if the move ended the game, 0 otherwise.
+	*/
+	typedef struct MoveRecord {
+		uint32_t firstChange;
+		uint32_t firstElimination;
+		unsigned int turnBefore;
+		unsigned int turnAfter;
+		unsigned int winnerIndex;
+	} MoveRecord;
+}
+/*
+* @brief A class implementing the rules of the chain reaction game without any rendering, audio or GUI dependency.
+* @brief Players are identified by their (0-based) id in the order of play. Mapping ids to colors or names is left to the GUI.
+* @brief A move is applied with `processPlayerInput`. If the move creates explosive sites, the resulting chain reaction can either be resolved
+* @brief one blast at a time with `runBlast` (e.g., for animating the explosions) or all at once with `resolveChainReaction`.
+*/
+class GameEngine {
+public:
+	/*
+	* @brief Default constructor of the game engine. Configures a 8 x 6 board with two players.
+	*/
+	GameEngine();
+	inline bool canRedo() const { return !this->hasPendingBlast() && this->_historyPosition < this->_history.size(); }
+	inline bool canUndo() const { return !this->hasPendingBlast() && this->_historyPosition > 0; }
+	inline const std::vector<GameUtilities::BoardCell>& getBoard() const { return this->_BOARD; }
+	/*
+	* @brief Returns the number of board-cells owned by a given player. This is maintained incrementally and costs O(1).
+	*/
+	inline uint32_t getCellCount(uint8_t player) const { return this->_cellCount[player]; }
+	inline const GameUtilities::BoardCell& getCell(uint32_t boardCoordinateX, uint32_t boardCoordinateY) const { return this->_BOARD[this->getCellIndex(boardCoordinateX, boardCoordinateY)]; }
+	/*
+	* @brief Converts a board coordinate to the index of the cell in the (row-major) board array.
+	*/
+	inline uint32_t getCellIndex(uint32_t boardCoordinateX, uint32_t boardCoordinateY) const { return boardCoordinateX + boardCoordinateY * this->_COL_DIV; }
+	/*
+	* @brief Returns the critical mass (i.e., the number of neighbours) of a board-cell. A cell explodes once it holds this many orbs.
+	*/
+	inline uint8_t getCriticalMass(uint32_t cellIndex) const { return this->_criticalMass[cellIndex]; }
+	/*
+	* @brief Returns the list of cell indices of the current explosive sites.
+	*/
+	inline const std::vector<uint32_t>& getCurrentBombs() const { return this->_currentBombs; }
+	/*
+	* @brief Returns the (0-based) id of the player who is to make the next move.
+	*/
+	inline uint8_t getCurrentPlayer() const { return (uint8_t)(this->_turn % this->_numberOfPlayers); }
+	/*
+	* @brief Returns the 64 bit Zobrist hash of the current position, i.e., of the board dimension, the owner and number of orbs of every occupied cell and the player who is to make the next move.
+	* @brief The hash of the board is maintained incrementally, hence this costs O(1).
+	*/
+	inline uint64_t getHash() const { return this->_boardHash ^ this->_dimensionKey ^ GameEngine::_mixHash((1ULL << 63) | this->getCurrentPlayer()); }
+	/*
+	* @brief Returns the (1-based) index of the player who is to make the next move.
+	*/
+	inline unsigned int getCurrentPlayerNumber() const { return 1 + (this->_turn % this->_numberOfPlayers); }
+	inline unsigned int getNumberOfColumns() const { return this->_COL_DIV; }
+	inline unsigned int getNumberOfPlayers() const { return this->_numberOfPlayers; }
+	inline unsigned int getNumberOfRows() const { return this->_ROW_DIV; }
+	/*
+	* @brief Returns the total number of orbs owned by a given player. This is maintained incrementally and costs O(1).
+	*/
+	inline uint32_t getOrbCount(uint8_t player) const { return this->_orbCount[player]; }
+	inline unsigned int getTurn() const { return this->_turn; }
+	/*
+	* @brief Returns the Zobrist key of a board-cell holding a given number of orbs of a given player, i.e., the contribution of the cell to `getHash`. The key of an empty cell is 0.
+	* @brief Exposed for computing the hashes of transformed boards (see BoardSymmetry.h) without building them.
+	*/
+	static inline uint64_t getZobristKey(uint32_t cellIndex, uint8_t owner, uint8_t level) { return GameEngine::_zobristKey(cellIndex, owner, level); }
+	/*
+	* @brief Returns the (1-based) index of the winner of the current game, or 0 if the game has not yet ended.
+	*/
+	inline unsigned int getWinnerIndex() const { return this->_winnerIndex; }
+	inline bool hasGameEnded() const { return this->_gameHasEnded; }
+	/*
+	* @brief Checks whether or not the board contains explosive sites which need to be resolved before the next input can be processed.
+	*/
+	inline bool hasPendingBlast() const { return !this->_currentBombs.empty(); }
+	/*
+	* @brief Checks whether or not a given player is eliminated from the game.
+	* @param {uint8_t} player: (0-based) id of the player that is being searched for.
+	* @returns {bool} true if player is eliminated, false otherwise.
+	*/
+	inline bool isEliminated(uint8_t player) const { return player < this->_eliminated.size() && this->_eliminated[player]; }
+	/*
+	* @brief Checks whether or not a given coordinate in the game board contains an explosive orb.
+	* @param {pair<uint32_t, uint32_t>} boardCoordinate: coordinate in the game board that is being tested.
+	* @returns {bool} true if the given boardCoordinate contains an explosive, false otherwise.
+	*/
+	inline bool isExplosive(std::pair<uint32_t, uint32_t> boardCoordinate) const { return this->hasPendingBlast() && this->_isCritical(this->getCellIndex(boardCoordinate.first, boardCoordinate.second)); }
+	/*
+	* @brief Checks whether or not the player who is to make the next move may place an orb in a given board-cell, i.e., whether the cell is empty or owned by that player.
+	* @param {uint32_t} cellIndex: index of the board-cell in the row-major board array.
+	*/
+	inline bool isLegalMove(uint32_t cellIndex) const { return !this->_gameHasEnded && !this->hasPendingBlast() && cellIndex < this->_BOARD.size() && (!this->_BOARD[cellIndex].level || this->_BOARD[cellIndex].owner == this->getCurrentPlayer()); }
+	/*
+	* @brief Replaces the board with a given (settled) position, e.g., with a checkpoint of a game record. The board dimension and number of players are kept and the undo/redo history is cleared.
+	* @param {vector<BoardCell>} board: row-major array of board-cells. It must match the current board dimension.
+	* @param {unsigned int} turn: value of the turn variable of the position (see `getTurn`).
+	* @param {vector<uint8_t>} eliminated: stores for each player id whether (1) or not (0) the player is eliminated.
+	* @returns {bool} true if the position was loaded, false if it is not a valid settled position (the engine is then left unchanged).
+	*/
+	bool loadPosition(const std::vector<GameUtilities::BoardCell>& board, unsigned int turn, const std::vector<uint8_t>& eliminated);
+	/*
+	* @brief Processes players input in the game board. Inputs must be provided in the board coordinate system (lower-left square is (0,0). x-coordinate (y-coordinate) increases in the right (top) direction.
+	* @brief If the input does not create any explosive site, the turn is passed on to the next player. Otherwise the explosions must be resolved with `runBlast` or `resolveChainReaction`.
+	* @param {uint32_t} boardCoordinateX: x-coordinate of the input square in board coordinate system.
+	* @param {uint32_t} boardCoordinateY: y-coordinate of the input square in board coordiante system.
+	* @returns {bool} true if the input is successfully processed by the engine, false otherwise.
+	*/
+	bool processPlayerInput(uint32_t boardCoordinateX, uint32_t boardCoordinateY);
+	/*
+	* @brief Redoes the last undone move. Any new move discards the moves that can be redone.
+	* @returns {bool} true if a move was redone, false if there is no move to redo or a blast is pending.
+	*/
+	bool redo(void);
+	/*
+	* @brief Resets state variables of the engine, i.e., clears the board, the list of eliminated players and the undo/redo history. The winner of the last game remains available.
+	*/
+	void resetGameVariables(void);
+	/*
+	* @brief Resolves all pending explosions of the current move and passes the turn on to the next player.
+	* @param {vector<vector<uint32_t>>*} waves: (optional) if not null, the cell indices of the explosive sites of every blast are appended to it in order, e.g., for animating the chain reaction.
+	* @returns {bool} true if the current game has ended due to the explosions, false otherwise.
+	*/
+	bool resolveChainReaction(std::vector<std::vector<uint32_t>>* waves = nullptr);
+	/*
+	* @brief Resolves a single blast, i.e., explodes all the current explosive sites simultaneously and updates the list of explosive sites.
+	* @brief Once the last blast of a chain reaction is resolved, the turn is passed on to the next player.
+	* @brief Only the neighbours of the exploded sites are examined for new explosive sites. The chain reaction stops as soon as a single player owns all orbs in the board.
+	* @returns {bool} true if the current game has ended (i.e., all orbs in the board are of same color) due to the blast, false otherwise.
+	*/
+	bool runBlast(void);
+	/*
+	* @brief Configures the board dimension and set of players before the start of a game.
+	* @param {unsigned int} numberOfRows: number of rows in the game board.
+	* @param {unsigned int} numberOfColumns: number of columns in the game board.
+	* @param {uint8_t} numberOfPlayers: number of players in the game. If 0 is given, the current number of players is kept.
+	* @brief The board must have at least as many cells as there are players, as every player needs an empty cell for the first move.
+	*/
+	void setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers);
+	/*
+	* @brief Undos the move of the last player. The history is unbounded, i.e., repeated calls undo the moves back to the start of the game.
+	* @brief Only the board-cells changed by the move are restored, hence the cost is proportional to the size of the move's chain reaction.
+	* @returns {bool} true if the board was restored, false if there is no move to undo or a blast is pending.
+	*/
+	bool undo(void);
+private:
+	std::vector<GameUtilities::BoardCell> _BOARD; //Row-major array of board-cells.
+	uint64_t _boardHash = 0; //Zobrist hash of the occupied board-cells, i.e., xor of the keys of every (cell, owner, level) triplet in the board.
+	std::vector<uint32_t> _cellCount; //Number of board-cells owned by each player.
+	unsigned int _COL_DIV;
+	std::vector<uint8_t> _criticalMass; //Precomputed critical mass (i.e., number of neighbours) of each board-cell.
+	std::vector<uint32_t> _currentBombs; //Stores the cell indices of the current explosive sites.
+	uint64_t _dimensionKey = 0; //Zobrist key of the board dimension. It distinguishes equal cell patterns on boards of different size.
+	std::vector<uint8_t> _eliminated; //Stores for each player id whether (1) or not (0) the player is eliminated.
+	unsigned int _eliminatedCount; //Number of eliminated players.
+	bool _gameHasEnded = false;
+	std::vector<GameUtilities::MoveRecord> _history; //Undo/redo history of the moves. Entries at and after _historyPosition can be redone.
+	std::vector<GameUtilities::CellChange> _historyChanges; //Cell changes of all moves in the history.
+	std::vector<uint8_t> _historyEliminations; //Ids of the players eliminated by the moves in the history.
+	size_t _historyPosition = 0; //Number of moves in the history that are currently applied to the board.
+	std::vector<uint32_t> _moveMark; //Stores for each board-cell the last move in which its change was recorded.
+	uint32_t _moveCount = 0; //Number of moves processed since the start of the game.
+	std::vector<uint32_t> _neighbourTable; //Precomputed cell indices of the neighbours of each board-cell. Entries 4 * i to 4 * i + _criticalMass[i] - 1 belong to cell i.
+	std::vector<uint32_t> _nextBombs; //Scratch buffer for collecting the explosive sites of the next blast.
+	uint8_t _numberOfPlayers;
+	std::vector<uint32_t> _orbCount; //Number of orbs owned by each player.
+	unsigned int _playersOnBoard; //Number of players owning at least one board-cell.
+	unsigned int _ROW_DIV;
+	unsigned int _turn;
+	unsigned int _winnerIndex = 0;
+	std::vector<uint32_t> _waveMark; //Stores for each board-cell the last blast in which it was examined. Used for avoiding duplicates in the list of explosive sites.
+	uint32_t _waveCount = 0; //Number of blasts resolved since the start of the game.
+
+	/*
+	* @brief Computes the critical mass and neighbour table for the current board dimension.
+	*/
+	void _buildNeighbourTable(void);
+	/*
+	* @brief Adds a single orb of a given player to a board-cell, capturing the cell (and its orbs) if it is owned by another player. Updates the per-player counters.
+	*/
+	inline void _addOrb(uint32_t cellIndex, uint8_t player) {
+		this->_recordChange(cellIndex);
+		auto& cell = this->_BOARD[cellIndex];
+		this->_boardHash ^= GameEngine::_zobristKey(cellIndex, cell.owner, cell.level) ^ GameEngine::_zobristKey(cellIndex, player, cell.level + 1);
+		if (!cell.level) {
+			if (!this->_cellCount[player]++) this->_playersOnBoard++;
+		}
+		else if (cell.owner != player) {
+			this->_orbCount[cell.owner] -= cell.level;
+			if (!--this->_cellCount[cell.owner]) this->_playersOnBoard--;
+			this->_orbCount[player] += cell.level;
+			if (!this->_cellCount[player]++) this->_playersOnBoard++;
+		}
+		cell.owner = player;
+		cell.level++;
+		this->_orbCount[player]++;
+	}
+	/*
+	* @brief Removes all orbs from a board-cell. Updates the per-player counters.
+	*/
+	inline void _clearCell(uint32_t cellIndex) {
+		auto& cell = this->_BOARD[cellIndex];
+		if (!cell.level) return;
+		this->_recordChange(cellIndex);
+		this->_boardHash ^= GameEngine::_zobristKey(cellIndex, cell.owner, cell.level);
+		this->_orbCount[cell.owner] -= cell.level;
+		if (!--this->_cellCount[cell.owner]) this->_playersOnBoard--;
+		cell.level = 0;
+	}
+	/*
+	* @brief Marks a player as eliminated and records the elimination in the history of the current move.
+	*/
+	inline void _eliminate(uint8_t player) {
+		this->_eliminated[player] = 1;
+		this->_eliminatedCount++;
+		this->_historyEliminations.push_back(player);
+	}
+	void _eliminatePlayers(bool updateTurnVariable);
+	inline bool _isCritical(uint32_t cellIndex) const { return this->_BOARD[cellIndex].level && this->_BOARD[cellIndex].level >= this->_criticalMass[cellIndex]; }
+	/*
+	* @brief Records the state of a board-cell in the history before it is changed for the first time by the current move.
+	*/
+	inline void _recordChange(uint32_t cellIndex) {
+		if (this->_moveMark[cellIndex] == this->_moveCount) return;
+		this->_moveMark[cellIndex] = this->_moveCount;
+		GameUtilities::CellChange change;
+		change.cellIndex = cellIndex;
+		change.before = this->_BOARD[cellIndex];
+		this->_historyChanges.push_back(change);
+	}
+	/*
+	* @brief Overwrites a board-cell without recording the change. Updates the per-player counters. Used for undoing and redoing moves.
+	*/
+	void _setCell(uint32_t cellIndex, GameUtilities::BoardCell value);
+	/*
+	* @brief Discards the moves that can be redone and opens a new entry in the history for the move that is about to be applied.
+	*/
+	void _startMoveRecord(void);
+	/*
+	* @brief splitmix64 finalizer. Maps distinct inputs to well distributed (and distinct) 64 bit keys.
+	*/
+	static inline uint64_t _mixHash(uint64_t z) {
+		z += 0x9E3779B97F4A7C15ULL;
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+	/*
+	* @brief Returns the Zobrist key of a board-cell holding a given number of orbs of a given player. The key of an empty cell is 0.
+	* @brief Instead of a random table of size (cells x players x levels), the keys are generated on the fly with `_mixHash`.
+	* @brief This keeps the keys identical across runs (required for comparing hashes stored in files) without any memory cost for large boards.
+	*/
+	static inline uint64_t _zobristKey(uint32_t cellIndex, uint8_t owner, uint8_t level) { return level ? GameEngine::_mixHash(((uint64_t)cellIndex << 16) | ((uint64_t)owner << 8) | level) : 0; }
+};
+#endif //!GAME_ENGINE_H
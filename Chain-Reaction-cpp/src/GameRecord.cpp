@@ -0,0 +1,253 @@
+#include "GameRecord.h"
+#include <cstring>
+
+//*************************************** GameRecordWriter ****************************************
+
+GameRecordWriter::~GameRecordWriter() {
+	this->close();
+}
+void GameRecordWriter::beginGame(const GameRecord::Header& header) {
+	if (this->_isRecording) this->endGame(0);
+	this->_game.clear();
+	this->_moveOffsets.clear();
+	this->_moves.clear();
+	this->_redoMoves.clear();
+	for (const auto& byte : GameRecord::MAGIC) this->_game.push_back(byte);
+	this->_game.push_back(GameRecord::VERSION);
+	GameRecord::writeVarint(this->_game, header.rows);
+	GameRecord::writeVarint(this->_game, header.columns);
+	this->_game.push_back((uint8_t)header.playerTypes.size());
+	for (size_t player = 0; player < header.playerTypes.size(); player++) {
+		const std::string name = player < header.playerNames.size() ? header.playerNames[player] : std::string();
+		this->_game.push_back(header.playerTypes[player]);
+		GameRecord::writeVarint(this->_game, name.size());
+		this->_game.insert(this->_game.end(), name.begin(), name.end());
+	}
+	for (int k = 0; k < 8; k++) this->_game.push_back((uint8_t)(header.seed >> (8 * k)));
+	GameRecord::writeVarint(this->_game, header.checkpointInterval);
+	this->_checkpointInterval = header.checkpointInterval;
+	this->_isRecording = true;
+}
+void GameRecordWriter::close(void) {
+	if (this->_isRecording) this->endGame(0);
+	if (this->_file.is_open()) this->_file.close();
+}
+bool GameRecordWriter::endGame(unsigned int winnerIndex) {
+	if (!this->_isRecording) return false;
+	GameRecord::writeVarint(this->_game, GameRecord::END_OF_GAME);
+	GameRecord::writeVarint(this->_game, winnerIndex);
+	this->_isRecording = false;
+	this->_redoMoves.clear();
+	if (!this->_file.is_open()) return true;
+	this->_file.write((const char*)this->_game.data(), (std::streamsize)this->_game.size());
+	this->_file.flush();
+	return this->_file.good();
+}
+bool GameRecordWriter::open(const std::string& path) {
+	this->close();
+	this->_file.clear();
+	this->_file.open(path, std::ios::binary | std::ios::app);
+	return this->_file.is_open();
+}
+void GameRecordWriter::recordMove(const GameEngine& position, uint32_t cellIndex) {
+	if (!this->_isRecording) return;
+	this->_redoMoves.clear();
+	this->_appendMove(position, cellIndex);
+}
+bool GameRecordWriter::redoMove(const GameEngine& position) {
+	if (!this->_isRecording || this->_redoMoves.empty()) return false;
+	const uint32_t cellIndex = this->_redoMoves.back();
+	this->_redoMoves.pop_back();
+	this->_appendMove(position, cellIndex);
+	return true;
+}
+bool GameRecordWriter::undoMove(void) {
+	if (!this->_isRecording || this->_moveOffsets.empty()) return false;
+	this->_redoMoves.push_back(this->_moves.back());
+	this->_game.resize(this->_moveOffsets.back());
+	this->_moveOffsets.pop_back();
+	this->_moves.pop_back();
+	return true;
+}
+//******************************************* Private methods ************************************
+
+void GameRecordWriter::_appendMove(const GameEngine& position, uint32_t cellIndex) {
+	const uint32_t ply = (uint32_t)this->_moveOffsets.size();
+	this->_moveOffsets.push_back(this->_game.size());
+	this->_moves.push_back(cellIndex);
+	if (this->_checkpointInterval && ply && ply % this->_checkpointInterval == 0) {
+		const auto& board = position.getBoard();
+		const unsigned int numberOfPlayers = position.getNumberOfPlayers();
+		GameRecord::writeVarint(this->_game, GameRecord::CHECKPOINT);
+		GameRecord::writeVarint(this->_game, position.getTurn());
+		for (unsigned int player = 0; player < numberOfPlayers; player += 8) {
+			uint8_t mask = 0;
+			for (unsigned int k = 0; k < 8 && player + k < numberOfPlayers; k++) {
+				if (position.isEliminated((uint8_t)(player + k))) mask |= (uint8_t)(1 << k);
+			}
+			this->_game.push_back(mask);
+		}
+		//A settled position holds less than 4 orbs per cell, hence the level fits into 2 bits.
+		for (const auto& cell : board) GameRecord::writeVarint(this->_game, cell.level ? (cell.level | ((uint64_t)cell.owner << 2)) : 0);
+		const uint64_t hash = position.getHash();
+		for (int k = 0; k < 8; k++) this->_game.push_back((uint8_t)(hash >> (8 * k)));
+	}
+	GameRecord::writeVarint(this->_game, cellIndex + GameRecord::FIRST_MOVE);
+}
+//*************************************** GameRecordReader ****************************************
+
+bool GameRecordReader::nextGame(void) {
+	uint32_t cellIndex;
+	while (this->_isInGame && this->nextMove(cellIndex));
+	if (this->_hasError || this->_cursor == this->_end) return false;
+	this->_gameOffset = (size_t)(this->_cursor - this->_begin);
+	return this->_readHeader();
+}
+bool GameRecordReader::nextMove(uint32_t& cellIndex) {
+	while (this->_isInGame) {
+		uint64_t value;
+		if (!GameRecord::readVarint(this->_cursor, this->_end, value)) return this->_setError();
+		if (value >= GameRecord::FIRST_MOVE) {
+			if (value - GameRecord::FIRST_MOVE >= (uint64_t)this->_header.rows * this->_header.columns) return this->_setError();
+			cellIndex = (uint32_t)(value - GameRecord::FIRST_MOVE);
+			this->_ply++;
+			return true;
+		}
+		if (value == GameRecord::CHECKPOINT) {
+			if (!this->_readCheckpoint(nullptr)) return false;
+			continue;
+		}
+		uint64_t winnerIndex;
+		if (!GameRecord::readVarint(this->_cursor, this->_end, winnerIndex) || winnerIndex > this->_header.playerTypes.size()) return this->_setError();
+		this->_winnerIndex = (unsigned int)winnerIndex;
+		this->_isInGame = false;
+	}
+	return false;
+}
+bool GameRecordReader::open(const std::string& path) {
+	std::ifstream file(path, std::ios::binary | std::ios::ate);
+	if (!file.is_open()) return false;
+	this->_fileData.resize((size_t)file.tellg());
+	file.seekg(0);
+	if (!file.read((char*)this->_fileData.data(), (std::streamsize)this->_fileData.size())) return false;
+	this->open(this->_fileData.data(), this->_fileData.size());
+	return true;
+}
+void GameRecordReader::open(const uint8_t* data, size_t size) {
+	this->_begin = data;
+	this->_cursor = data;
+	this->_gameOffset = 0;
+	this->_end = data + size;
+	this->_hasError = false;
+	this->_isInGame = false;
+	this->_ply = 0;
+	this->_winnerIndex = 0;
+}
+bool GameRecordReader::replay(GameEngine& game) {
+	if (!this->seek(game, 0)) return false;
+	uint32_t cellIndex;
+	const uint32_t columns = this->_header.columns;
+	while (this->nextMove(cellIndex)) {
+		if (!game.processPlayerInput(cellIndex % columns, cellIndex / columns)) return false;
+		game.resolveChainReaction();
+	}
+	return !this->_hasError;
+}
+bool GameRecordReader::seek(GameEngine& game, uint32_t ply) {
+	if (!this->_isInGame || this->_ply) return false;
+	const uint8_t numberOfPlayers = (uint8_t)this->_header.playerTypes.size();
+	//Reconfiguring the engine rebuilds its neighbour table, which is avoided when consecutive games are played on the same board.
+	if (game.getNumberOfRows() == this->_header.rows && game.getNumberOfColumns() == this->_header.columns && game.getNumberOfPlayers() == numberOfPlayers) game.resetGameVariables();
+	else game.setAttribute(this->_header.rows, this->_header.columns, numberOfPlayers);
+	const uint32_t interval = this->_header.checkpointInterval;
+	//The checkpoint before the last move to be applied exists whenever the game has enough moves, even if the game ends right after it.
+	const uint32_t checkpointPly = interval && ply ? (ply - 1) / interval * interval : 0;
+	uint32_t cellIndex;
+	const uint32_t columns = this->_header.columns;
+	//Skip (without replaying) the moves before the checkpoint, then load it.
+	if (checkpointPly) {
+		while (this->_ply < checkpointPly) {
+			if (!this->nextMove(cellIndex)) return false;
+		}
+		uint64_t value;
+		const uint8_t* tag = this->_cursor;
+		if (!GameRecord::readVarint(this->_cursor, this->_end, value)) return this->_setError();
+		if (value == GameRecord::END_OF_GAME) {
+			//The game ended before the checkpoint; its terminator is left for `nextMove`.
+			this->_cursor = tag;
+			return false;
+		}
+		if (value != GameRecord::CHECKPOINT) return this->_setError();
+		if (!this->_readCheckpoint(&game)) return false;
+	}
+	while (this->_ply < ply) {
+		if (!this->nextMove(cellIndex)) return false;
+		if (!game.processPlayerInput(cellIndex % columns, cellIndex / columns)) return false;
+		game.resolveChainReaction();
+	}
+	return true;
+}
+//******************************************* Private methods ************************************
+
+bool GameRecordReader::_readCheckpoint(GameEngine* game) {
+	const size_t cellCount = (size_t)this->_header.rows * this->_header.columns;
+	const size_t numberOfPlayers = this->_header.playerTypes.size();
+	const size_t maskBytes = (numberOfPlayers + 7) / 8;
+	uint64_t turn;
+	if (!GameRecord::readVarint(this->_cursor, this->_end, turn) || (size_t)(this->_end - this->_cursor) < maskBytes) return this->_setError();
+	if (game != nullptr) {
+		this->_eliminated.resize(numberOfPlayers);
+		for (size_t player = 0; player < numberOfPlayers; player++) this->_eliminated[player] = (this->_cursor[player / 8] >> (player % 8)) & 1;
+		this->_board.resize(cellCount);
+	}
+	this->_cursor += maskBytes;
+	for (size_t cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		uint64_t value;
+		if (!GameRecord::readVarint(this->_cursor, this->_end, value)) return this->_setError();
+		if (game == nullptr) continue;
+		this->_board[cellIndex].level = (uint8_t)(value & 3);
+		this->_board[cellIndex].owner = (uint8_t)(value >> 2);
+	}
+	if (this->_end - this->_cursor < 8) return this->_setError();
+	uint64_t hash = 0;
+	for (int k = 0; k < 8; k++) hash |= (uint64_t)this->_cursor[k] << (8 * k);
+	this->_cursor += 8;
+	if (game == nullptr) return true;
+	//The hash guards against a checkpoint that does not match the engine (e.g., of a record written by a different version of the rules).
+	if (!game->loadPosition(this->_board, (unsigned int)turn, this->_eliminated) || game->getHash() != hash) return this->_setError();
+	return true;
+}
+bool GameRecordReader::_readHeader(void) {
+	this->_isInGame = false;
+	this->_ply = 0;
+	this->_winnerIndex = 0;
+	if (this->_end - this->_cursor < 4 || std::memcmp(this->_cursor, GameRecord::MAGIC, 3) || this->_cursor[3] != GameRecord::VERSION) return this->_setError();
+	this->_cursor += 4;
+	uint64_t rows, columns;
+	if (!GameRecord::readVarint(this->_cursor, this->_end, rows) || !GameRecord::readVarint(this->_cursor, this->_end, columns) || this->_cursor == this->_end) return this->_setError();
+	//Bound the dimension, so that malformed data cannot trigger a huge allocation.
+	if (!rows || !columns || rows > 0xFFFF || columns > 0xFFFF) return this->_setError();
+	this->_header.rows = (uint32_t)rows;
+	this->_header.columns = (uint32_t)columns;
+	const uint8_t numberOfPlayers = *this->_cursor++;
+	if (!numberOfPlayers || rows * columns < numberOfPlayers) return this->_setError();
+	this->_header.playerTypes.resize(numberOfPlayers);
+	this->_header.playerNames.resize(numberOfPlayers);
+	for (uint8_t player = 0; player < numberOfPlayers; player++) {
+		uint64_t length;
+		if (this->_cursor == this->_end) return this->_setError();
+		this->_header.playerTypes[player] = *this->_cursor++;
+		if (!GameRecord::readVarint(this->_cursor, this->_end, length) || (uint64_t)(this->_end - this->_cursor) < length) return this->_setError();
+		this->_header.playerNames[player].assign((const char*)this->_cursor, (size_t)length);
+		this->_cursor += length;
+	}
+	if (this->_end - this->_cursor < 8) return this->_setError();
+	this->_header.seed = 0;
+	for (int k = 0; k < 8; k++) this->_header.seed |= (uint64_t)this->_cursor[k] << (8 * k);
+	this->_cursor += 8;
+	uint64_t checkpointInterval;
+	if (!GameRecord::readVarint(this->_cursor, this->_end, checkpointInterval) || checkpointInterval > UINT32_MAX) return this->_setError();
+	this->_header.checkpointInterval = (uint32_t)checkpointInterval;
+	this->_isInGame = true;
+	return true;
+}
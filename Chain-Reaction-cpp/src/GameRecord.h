@@ -0,0 +1,226 @@
+#pragma once
+#ifndef GAME_RECORD_H
+#define GAME_RECORD_H
+
+/* Compact binary format for archiving games. It is part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+ A record file is a plain concatenation of games, hence games are appended to an archive without rewriting it. Layout of a single game:
+	1. Header: magic "CRG", format version (1 byte), rows and columns (varints), number of players (1 byte), for every player its type (1 byte, see `PlayerType`)
+	   and name (varint length followed by the characters), seed (8 bytes, little endian) and checkpoint interval (varint, 0 disables checkpoints).
+	2. Body: a sequence of varints. A value v >= 2 is a move in cell index v - 2. The value 1 introduces a checkpoint, i.e., the position before the next move:
+	   turn variable (varint), eliminated players (bitmask of ceil(players / 8) bytes), every board-cell as varint (level | owner << 2) and the Zobrist hash (8 bytes).
+	   Checkpoints are written before every move whose (0-based) number is a positive multiple of the checkpoint interval.
+	3. Terminator: the value 0 followed by the (1-based) index of the winner as varint. A winner index 0 marks a game that was abandoned.
+ Varints are unsigned LEB128, i.e., 7 bits per byte with the high bit set on every byte but the last. Moves on boards with less than 127 cells thus take a single byte.
+*/
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "GameEngine.h"
+
+namespace GameRecord {
+	const uint8_t MAGIC[3] = { 'C', 'R', 'G' };
+	const uint8_t VERSION = 1;
+	const uint64_t END_OF_GAME = 0;
+	const uint64_t CHECKPOINT = 1;
+	const uint64_t FIRST_MOVE = 2; //Varint value of a move in cell 0.
+	/*
+	* @brief Header of a recorded game.
+	* @brief Member variables:
+	* @brief	1. {uint32_t} rows, columns: dimension of the board.
+	* @brief	2. {vector<uint8_t>} playerTypes: controller of each player in the order of play (see `GameUtilities::PlayerType`). Its size is the number of players.
+	* @brief	3. {vector<string>} playerNames: name of each player, e.g., its color in the GUI or its policy in a tournament. May be empty strings.
+	* @brief	4. {uint64_t} seed: seed of the random number generators of the game, e.g., of the computer players.
+	* @brief	5. {uint32_t} checkpointInterval: number of moves between two checkpoints, 0 if the game has no checkpoints.
+	*/
+	typedef struct Header {
+		uint32_t rows = 0;
+		uint32_t columns = 0;
+		std::vector<uint8_t> playerTypes;
+		std::vector<std::string> playerNames;
+		uint64_t seed = 0;
+		uint32_t checkpointInterval = 0;
+	} Header;
+
+	inline void writeVarint(std::vector<uint8_t>& buffer, uint64_t value) {
+		while (value >= 0x80) {
+			buffer.push_back((uint8_t)(value | 0x80));
+			value >>= 7;
+		}
+		buffer.push_back((uint8_t)value);
+	}
+	/*
+	* @brief Decodes a varint and advances the cursor past it.
+	* @returns {bool} true if a complete varint was decoded, false if the data ends before its last byte (or it is longer than 10 bytes).
+	*/
+	inline bool readVarint(const uint8_t*& cursor, const uint8_t* end, uint64_t& value) {
+		//Fast path for the single byte values, i.e., for nearly every move.
+		if (cursor != end && *cursor < 0x80) {
+			value = *cursor++;
+			return true;
+		}
+		value = 0;
+		for (unsigned int shift = 0; cursor != end && shift < 64; shift += 7) {
+			const uint8_t byte = *cursor++;
+			value |= (uint64_t)(byte & 0x7F) << shift;
+			if (byte < 0x80) return true;
+		}
+		return false;
+	}
+}
+/*
+* @brief Records games in the binary game-record format. Moves are passed to the writer as they are played and are kept in memory until the game is ended;
+* @brief the complete game is then appended to the record file with a single write. A crash thus never leaves a partially written game in the archive.
+* @brief Undone moves are removed from the record, i.e., a record always holds the line of play that led to the final position.
+*/
+class GameRecordWriter {
+public:
+	GameRecordWriter() = default;
+	/*
+	* @brief Ends the current game (as abandoned) and closes the record file.
+	*/
+	~GameRecordWriter();
+	/*
+	* @brief Starts recording a new game. A game which is still being recorded is ended as abandoned.
+	*/
+	void beginGame(const GameRecord::Header& header);
+	void close(void);
+	/*
+	* @brief Finishes the current game and appends it to the record file (if one is open). The encoded game remains available through `getGameData` until the next game begins.
+	* @param {unsigned int} winnerIndex: (1-based) index of the winner, 0 if the game was abandoned.
+	* @returns {bool} true if the game was written, false if no game is being recorded or the file could not be written.
+	*/
+	bool endGame(unsigned int winnerIndex);
+	/*
+	* @brief Returns the encoded bytes of the current (or, after `endGame`, of the last) game.
+	*/
+	inline const std::vector<uint8_t>& getGameData() const { return this->_game; }
+	inline uint32_t getMoveCount() const { return (uint32_t)this->_moveOffsets.size(); }
+	inline bool isOpen() const { return this->_file.is_open(); }
+	inline bool isRecording() const { return this->_isRecording; }
+	/*
+	* @brief Opens a record file for appending games. The file is created if it does not exist.
+	* @returns {bool} true if the file is open, false otherwise.
+	*/
+	bool open(const std::string& path);
+	/*
+	* @brief Records a move. Must be called before the move is applied, since a checkpoint is taken from the position before the move.
+	* @param {GameEngine} position: position in which the move is made. It must not have a pending blast.
+	* @param {uint32_t} cellIndex: index of the board-cell of the move in the row-major board array.
+	*/
+	void recordMove(const GameEngine& position, uint32_t cellIndex);
+	/*
+	* @brief Records the last undone move again. Must be called before the move is redone (see `recordMove`).
+	* @returns {bool} true if a move was recorded, false if there is no undone move.
+	*/
+	bool redoMove(const GameEngine& position);
+	/*
+	* @brief Removes the last move (and its checkpoint) from the current game. The move is kept for `redoMove` until a new move is recorded.
+	* @returns {bool} true if a move was removed, false if the current game has no move.
+	*/
+	bool undoMove(void);
+private:
+	uint32_t _checkpointInterval = 0;
+	std::ofstream _file;
+	std::vector<uint8_t> _game; //Encoded bytes of the current game.
+	bool _isRecording = false;
+	std::vector<size_t> _moveOffsets; //Offset (in _game) of every recorded move, including the checkpoint preceding it.
+	std::vector<uint32_t> _moves; //Cell indices of the recorded moves.
+	std::vector<uint32_t> _redoMoves; //Cell indices of the undone moves, the last undone move is at the back.
+
+	void _appendMove(const GameEngine& position, uint32_t cellIndex);
+};
+/*
+* @brief Reads files in the binary game-record format. The data is scanned sequentially without any allocation per move, so that archives can be replayed
+* @brief through the headless engine at the speed of the engine itself.
+* @brief Typical use: `while (reader.nextGame()) { reader.replay(engine); ... }`.
+*/
+class GameRecordReader {
+public:
+	GameRecordReader() = default;
+	/*
+	* @brief Returns the offset (in bytes from the start of the data) of the header of the current game. Together with `getOffset` after the last move of the game,
+	* @brief it delimits the encoded game, e.g., for copying it into another record file without re-encoding it.
+	*/
+	inline size_t getGameOffset() const { return this->_gameOffset; }
+	/*
+	* @brief Returns the header of the current game, i.e., of the game selected by the last call of `nextGame`.
+	*/
+	inline const GameRecord::Header& getHeader() const { return this->_header; }
+	/*
+	* @brief Returns the current read offset (in bytes from the start of the data).
+	*/
+	inline size_t getOffset() const { return (size_t)(this->_cursor - this->_begin); }
+	/*
+	* @brief Returns the number of moves read from the current game so far.
+	*/
+	inline uint32_t getPly() const { return this->_ply; }
+	/*
+	* @brief Returns the (1-based) index of the winner of the current game, once all of its moves are read. 0 indicates an abandoned (or not yet completely read) game.
+	*/
+	inline unsigned int getWinnerIndex() const { return this->_winnerIndex; }
+	/*
+	* @brief Checks whether or not malformed data was encountered. Reading stops at the first error.
+	*/
+	inline bool hasError() const { return this->_hasError; }
+	/*
+	* @brief Skips the rest of the current game (if any) and reads the header of the next game.
+	* @returns {bool} true if a game was found, false at the end of the data or on malformed data.
+	*/
+	bool nextGame(void);
+	/*
+	* @brief Reads the next move of the current game. Checkpoints are skipped.
+	* @param {uint32_t&} cellIndex: receives the index of the board-cell of the move.
+	* @returns {bool} true if a move was read, false at the end of the game (see `getWinnerIndex`) or on malformed data.
+	*/
+	bool nextMove(uint32_t& cellIndex);
+	/*
+	* @brief Reads a record file into memory.
+	* @returns {bool} true if the file was read, false otherwise.
+	*/
+	bool open(const std::string& path);
+	/*
+	* @brief Reads records from a memory buffer. The buffer is not copied and must stay valid while it is read.
+	*/
+	void open(const uint8_t* data, size_t size);
+	/*
+	* @brief Replays the remaining moves of the current game through a game engine. Must be called right after `nextGame`, the engine is then configured from the header.
+	* @param {GameEngine&} game: engine that receives the final position of the game.
+	* @returns {bool} true if every move was legal, false otherwise.
+	*/
+	bool replay(GameEngine& game);
+	/*
+	* @brief Sets up the position before a given move of the current game. The nearest checkpoint before the move is loaded and only the moves after it are replayed.
+	* @brief Must be called right after `nextGame`; the engine is configured from the header. Reading may continue with `nextMove` afterwards.
+	* @param {GameEngine&} game: engine that receives the position. Its undo history only reaches back to the loaded checkpoint.
+	* @param {uint32_t} ply: number of moves that are to be applied.
+	* @returns {bool} true if the position was set up, false if the game has less moves or the data is malformed.
+	*/
+	bool seek(GameEngine& game, uint32_t ply);
+private:
+	const uint8_t* _begin = nullptr;
+	std::vector<GameUtilities::BoardCell> _board; //Scratch buffer for decoding checkpoints.
+	const uint8_t* _cursor = nullptr;
+	const uint8_t* _end = nullptr;
+	std::vector<uint8_t> _eliminated; //Scratch buffer for decoding checkpoints.
+	std::vector<uint8_t> _fileData; //Contents of the file opened with `open(path)`.
+	size_t _gameOffset = 0;
+	bool _hasError = false;
+	GameRecord::Header _header;
+	bool _isInGame = false;
+	uint32_t _ply = 0;
+	unsigned int _winnerIndex = 0;
+
+	/*
+	* @brief Decodes a checkpoint (the cursor must point after its tag) and loads it into a game engine, or skips it if no engine is given.
+	*/
+	bool _readCheckpoint(GameEngine* game);
+	bool _readHeader(void);
+	inline bool _setError(void) {
+		this->_hasError = true;
+		this->_isInGame = false;
+		this->_cursor = this->_end;
+		return false;
+	}
+};
+#endif //!GAME_RECORD_H
@@ -0,0 +1,34 @@
+#include "GreedyPlayer.h"
+
+//*************************************** Public methods ****************************************
+
+GreedyPlayer::GreedyPlayer(uint64_t seed) {
+	this->seed(seed);
+}
+bool GreedyPlayer::findMove(const GameEngine& game, uint32_t& cellIndex) {
+	this->_nodeCount = 0;
+	if (game.hasGameEnded() || game.hasPendingBlast()) return false;
+	this->_position = game;
+	const uint8_t player = this->_position.getCurrentPlayer();
+	const uint32_t columns = this->_position.getNumberOfColumns();
+	int64_t bestScore = INT64_MIN;
+	uint32_t bestMove = UINT32_MAX, ties = 0;
+	for (uint32_t index = 0; index < (uint32_t)this->_position.getBoard().size(); index++) {
+		if (!this->_position.isLegalMove(index)) continue;
+		this->_position.processPlayerInput(index % columns, index / columns);
+		this->_position.resolveChainReaction();
+		this->_nodeCount++;
+		const int64_t score = this->_position.hasGameEnded() ? INT64_MAX : ((int64_t)this->_position.getCellCount(player) << 32) + this->_position.getOrbCount(player);
+		this->_position.undo();
+		if (score > bestScore) {
+			bestScore = score;
+			bestMove = index;
+			ties = 1;
+		}
+		//Reservoir sampling among the moves with equal score, i.e., every best move is chosen with equal probability.
+		else if (score == bestScore && this->_random.below(++ties) == 0) bestMove = index;
+	}
+	if (bestMove == UINT32_MAX) return false;
+	cellIndex = bestMove;
+	return true;
+}
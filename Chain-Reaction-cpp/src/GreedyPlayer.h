@@ -0,0 +1,23 @@
+#pragma once
+#ifndef GREEDY_PLAYER_H
+#define GREEDY_PLAYER_H
+
+#include "ComputerPlayer.h"
+
+/*
+* @brief A computer player choosing the move which captures the most board-cells, i.e., it maximizes the number of cells it owns after the chain reaction of the move.
+* @brief Ties are broken by the number of orbs and then at random. A move that wins the game is always preferred.
+*/
+class GreedyPlayer : public ComputerPlayer {
+public:
+	/*
+	* @param {uint64_t} seed: seed of the pseudo random number generator used for breaking ties.
+	*/
+	GreedyPlayer(uint64_t seed = 0);
+	bool findMove(const GameEngine& game, uint32_t& cellIndex) override;
+	inline uint64_t getNodeCount() const override { return this->_nodeCount; }
+private:
+	uint64_t _nodeCount = 0;
+	GameEngine _position; //Scratch copy of the position on which the candidate moves are tried.
+};
+#endif //!GREEDY_PLAYER_H
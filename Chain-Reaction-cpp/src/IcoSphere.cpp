@@ -11,6 +11,9 @@ IcoSphere::IcoSphere(){
 }
 
 IcoSphere::~IcoSphere(){
+    this->deleteBuffers();
+}
+void IcoSphere::deleteBuffers() {
     if (this->_vao != nullptr) {
         delete this->_vao;
         this->_vao = nullptr;
@@ -27,6 +30,7 @@ IcoSphere::~IcoSphere(){
         delete this->_iboForLevelThree;
         this->_iboForLevelThree = nullptr;
     }
+    this->_vbo.deleteBuffer();
 }
 void IcoSphere::init(glm::vec3 center, float radius, uint32_t order, bool generateTextureCoord, glm::vec4 color){
     this->_center = center;
@@ -144,6 +148,22 @@ void IcoSphere::draw(uint8_t level) {
     }
     _vao->unbind();
 }
+void IcoSphere::drawInstanced(uint8_t level, const VertexBufferObject& instanceBuffer, VertexLayout instanceLayout, uint32_t firstInstance, uint32_t instanceCount) {
+    if (!instanceCount) return;
+    this->_vao->setInstanceBuffer(instanceBuffer, instanceLayout, (GLuint64)firstInstance * instanceLayout.getStride());
+    if (level == 1) this->_vao->setIndexBuffer(*this->_iboForLevelOne);
+    else if (level == 2) this->_vao->setIndexBuffer(*this->_iboForLevelTwo);
+    else this->_vao->setIndexBuffer(*this->_iboForLevelThree);
+    this->_vao->bind();
+    for (GLuint i = 0; i < _vao->numAttr(); i++) {
+        glEnableVertexAttribArray(i);
+    }
+    glDrawElementsInstanced(GL_TRIANGLES, this->_vao->numIndices(), GL_UNSIGNED_INT, nullptr, instanceCount);
+    for (GLuint i = 0; i < _vao->numAttr(); i++) {
+        glDisableVertexAttribArray(i);
+    }
+    _vao->unbind();
+}
 void IcoSphere::_generateData(uint32_t order, std::vector<double>& verticesDestination, std::vector<uint32_t>& trianglesDestination, std::vector<double>& textureDestination, bool generateTextureCoord) {
     assert(order <= 10);
 
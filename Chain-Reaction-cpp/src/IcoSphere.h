@@ -21,8 +21,21 @@ public:
 	inline glm::vec3 getCenter() const { return this->_center; }
 	void init(glm::vec3 center, float radius, uint32_t order, bool generateTextureCoord = false, glm::vec4 color = glm::vec4(1.0f, 1.0f, 1.0f, 1.0f));
 	void draw(uint8_t level = 1);
+	/*
+	* @brief Draws the spheres of a given level once per instance in a single draw call. The per-instance attributes follow the vertex attributes (see `VertexArrayObject::setInstanceBuffer`).
+	* @param {uint8_t} level: number of spheres (1 to 3) drawn per instance.
+	* @param {const VertexBufferObject&} instanceBuffer: buffer of the per-instance attributes.
+	* @param {VertexLayout} instanceLayout: layout of the per-instance attributes.
+	* @param {uint32_t} firstInstance: index of the first instance to draw in the buffer.
+	* @param {uint32_t} instanceCount: number of instances to draw.
+	*/
+	void drawInstanced(uint8_t level, const VertexBufferObject& instanceBuffer, VertexLayout instanceLayout, uint32_t firstInstance, uint32_t instanceCount);
 	inline const char* getColor() const { return _currentColor.c_str(); }
 	inline void setColor(const char* color) { _currentColor = std::string(color); }
+	/*
+	* @brief Frees the vertex array and the vertex and index buffers. It must be called on the thread whose OpenGL context created them. The sphere can be initialized again afterwards.
+	*/
+	void deleteBuffers();
 private:
 	glm::vec3 _center = { 0, 0, 0 };
 	std::string _currentColor = "white";
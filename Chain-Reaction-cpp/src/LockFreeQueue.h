@@ -0,0 +1,86 @@
+#pragma once
+#ifndef LOCK_FREE_QUEUE_H
+#define LOCK_FREE_QUEUE_H
+
+#include "PrecompiledHeader.h" //precompiled header
+
+/*
+* @brief A bounded single-producer single-consumer queue. One thread pushes and one other thread pops; neither of them ever blocks or takes a lock.
+* @brief The head and tail indices are kept on separate cache lines, hence the two threads do not contend for the same line.
+* @tparam T: type of the elements. It must be copy-assignable.
+* @tparam CAPACITY: maximum number of elements in the queue. It must be a power of 2.
+*/
+template <typename T, size_t CAPACITY>
+class LockFreeQueue {
+	static_assert(CAPACITY > 0 && (CAPACITY & (CAPACITY - 1)) == 0, "Capacity of the queue must be a power of 2.");
+public:
+	/*
+	* @brief Appends an element to the queue. Must only be called by the producer thread.
+	* @param {const T&} element: element to be appended.
+	* @returns {bool} true if the element was appended, false if the queue is full.
+	*/
+	bool push(const T& element) {
+		const size_t tail = this->_tail.load(std::memory_order_relaxed);
+		if (tail - this->_head.load(std::memory_order_acquire) == CAPACITY) return false;
+		this->_elements[tail & (CAPACITY - 1)] = element;
+		this->_tail.store(tail + 1, std::memory_order_release); //Publishes the element to the consumer.
+		return true;
+	}
+	/*
+	* @brief Removes the oldest element from the queue. Must only be called by the consumer thread.
+	* @param[out] {T&} element: receives the removed element.
+	* @returns {bool} true if an element was removed, false if the queue is empty.
+	*/
+	bool pop(T& element) {
+		const size_t head = this->_head.load(std::memory_order_relaxed);
+		if (head == this->_tail.load(std::memory_order_acquire)) return false;
+		element = this->_elements[head & (CAPACITY - 1)];
+		this->_head.store(head + 1, std::memory_order_release); //Hands the slot back to the producer.
+		return true;
+	}
+private:
+	alignas(64) std::atomic<size_t> _head = 0; //Number of elements popped so far. Only written by the consumer.
+	alignas(64) std::atomic<size_t> _tail = 0; //Number of elements pushed so far. Only written by the producer.
+	T _elements[CAPACITY];
+};
+/*
+* @brief A lock-free triple buffer, which hands the latest state from one producer thread to one consumer thread.
+* @brief The producer fills the back buffer and publishes it; the consumer picks up the most recently published buffer. States published in between are skipped,
+* @brief hence neither thread ever waits for the other, and the buffers are reused without any allocation once they have grown to their working size.
+* @tparam T: type of the state.
+*/
+template <typename T>
+class TripleBuffer {
+public:
+	/*
+	* @brief Returns the back buffer, which the producer fills before publishing it. Must only be called by the producer thread.
+	*/
+	inline T& getBackBuffer(void) { return this->_buffers[this->_backIndex]; }
+	/*
+	* @brief Returns the buffer which the consumer picked up last with `update`. Must only be called by the consumer thread.
+	*/
+	inline const T& getFrontBuffer(void) const { return this->_buffers[this->_frontIndex]; }
+	/*
+	* @brief Publishes the back buffer to the consumer and takes over a free buffer as the new back buffer. Must only be called by the producer thread.
+	*/
+	void publish(void) {
+		this->_backIndex = this->_middleIndex.exchange(this->_backIndex | TripleBuffer::_IS_NEW, std::memory_order_acq_rel) & TripleBuffer::_INDEX_MASK;
+	}
+	/*
+	* @brief Picks up the most recently published buffer as the front buffer, unless nothing was published since the last call. Must only be called by the consumer thread.
+	* @returns {bool} true if a new buffer was picked up, false otherwise.
+	*/
+	bool update(void) {
+		if (!(this->_middleIndex.load(std::memory_order_relaxed) & TripleBuffer::_IS_NEW)) return false;
+		this->_frontIndex = this->_middleIndex.exchange(this->_frontIndex, std::memory_order_acq_rel) & TripleBuffer::_INDEX_MASK;
+		return true;
+	}
+private:
+	static constexpr uint8_t _INDEX_MASK = 3;
+	static constexpr uint8_t _IS_NEW = 4; //Marks the middle buffer as published but not yet picked up.
+	T _buffers[3];
+	uint8_t _backIndex = 0; //Buffer written by the producer.
+	std::atomic<uint8_t> _middleIndex = 1; //Buffer exchanged between the two threads, together with the _IS_NEW flag.
+	uint8_t _frontIndex = 2; //Buffer read by the consumer.
+};
+#endif // !LOCK_FREE_QUEUE_H
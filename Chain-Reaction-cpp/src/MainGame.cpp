@@ -8,34 +8,37 @@ const std::unordered_map<std::string, glm::vec4> MainGame::_colorMap = MainGame:
 //***********************************************************************************************
 //*************************************** Public methods ****************************************
 
-bool MainGame::drawBoard(unsigned long deltaTime) {
-	bool gameHasEnded = false; //Boolean flag to detect the end of a game.
-	bool empty_bomb_list = this->_currentBombs.empty(); //Check if the board contains any explosive or not.
-	if (this->isBlastAnimationRunning() && empty_bomb_list) { //A full sequence of blast is completed as blast animation was running and right now there are no more bombs left.
-		this->_blastAnimationRunning = false; //Reset the boolean flag for blast animation runtime.
-		this->_eliminatePlayers(true); //Update the list of eliminated players after a full sequence of blasts.
+MainGame::BoardMotion MainGame::drawBoard(double deltaTime) {
+	this->_boardStates.update(); //Picks up the most recently published board, if there is a new one.
+	const BoardState& board = this->_boardStates.getFrontBuffer();
+	if (!this->_areShadersInitialized) {
+		wxLogDebug("[Chain-Reaction] Initializing default variables and uploading vertex data to GPU for rendering orbs ...");
+		float radius = (this->_CUBE_WIDTH) / 4.5f;
+		this->_sphere.init(glm::vec3(0, 0, 0), radius, 4);
+		wxLogDebug("[Chain-Reaction] Processing shader-settings for rendering orbs ...");
+		this->_applyOrbShaderSettings();
+		wxLogDebug("[Chain-Reaction] Processing shader-settings for rendering grid-lines ...");
+		this->_applyGridShaderSettings();
+		this->_areShadersInitialized = true;
 	}
-	if (!empty_bomb_list) {
-		if (!this->isBlastAnimationRunning()) this->_blastAnimationRunning = true;
-		gameHasEnded = this->_runBlastAnimation(deltaTime);
+	glViewport(0, 0, board.viewport[0], board.viewport[1]);
+	if (!(board.numberOfRows && board.numberOfColumns)) { //No board has been published yet.
+		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+		return MainGame::STATIC_BOARD;
 	}
-	else {
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); //Clear color and depth buffer before rendering new frame.
-		this->_drawGrid();
-		double angle = remainder(this->_angleOfRotation, 360.0);
-		for (const auto& boardEntry : this->_BOARD) {
-			const auto& key = boardEntry.second.boardCoordinate;
-			glm::vec3 center = { (key.first + 0.5f) * this->_CUBE_WIDTH + this->_lowerleft[0],
-								(key.second + 0.5f) * this->_CUBE_WIDTH + this->_lowerleft[1],
-								0.0f };
-			this->_drawOrb(center, boardEntry.second.rotationAxes, angle, boardEntry.second.level, boardEntry.second.color.c_str());
-		}
-		if (!(this->_BOARD.empty())) this->_angleOfRotation += ((this->_ROTATION_SPEED * deltaTime) / 1000.0);
+	//A single upload serves the grid and orb shaders. The binding point is shared with the scene of the welcome screen.
+	this->_frameStateBuffer.loadData(&board.frameState, sizeof(Shaders::FrameState));
+	this->_frameStateBuffer.bindBase(Shaders::FRAME_STATE_BINDING);
+	if (board.isRotating) this->_angleOfRotation += ((this->_ROTATION_SPEED * deltaTime) / 1000.0);
+	double blastDisplacement = 0.0;
+	if (board.blastSpeed > 0.0) {
+		//The orbs move on from their published position until the UI thread resolves the blast, but never beyond the neighbouring cells.
+		double elapsedTime = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - board.time).count();
+		blastDisplacement = (std::min)(board.blastDisplacement + board.blastSpeed * elapsedTime, (double)this->_CUBE_WIDTH);
 	}
-	if (gameHasEnded){
-		this->resetGameVariables();
-	}
-	return gameHasEnded;
+	this->_renderBoard(board, blastDisplacement);
+	if (board.blastSpeed > 0.0) return MainGame::RUNNING_BLAST;
+	return board.isRotating ? MainGame::ROTATING_ORBS : MainGame::STATIC_BOARD;
 }
 glm::vec2 MainGame::getBoardCoordinates(double mouseX, double mouseY) {
 	glm::vec2 output = { -1, -1 };
@@ -52,20 +55,6 @@ glm::vec2 MainGame::getBoardCoordinates(double mouseX, double mouseY) {
 	output.y = boxy;
 	return output;
 }
-bool MainGame::isEliminated(std::string player) const {
-	bool found = std::find(this->_eliminated.begin(), this->_eliminated.end(), player) == this->_eliminated.end() ? false : true;
-	return found;
-}
-bool MainGame::isExplosive(pair<uint32_t, uint32_t> boardCoordinate) const {
-	bool isBomb = false;
-	for (const auto& value : this->_currentBombs) {
-		if (value.second.boardCoordinate.first == boardCoordinate.first && value.second.boardCoordinate.second == boardCoordinate.second) {
-			isBomb = true;
-			break;
-		}
-	}
-	return isBomb;
-}
 MainGame::MainGame(const char* soundSourceName, const char* gridShaderVertexSource, const char* gridShaderFragmentSource, const char* orbShaderVertexSource, const char* orbShaderFragmentSource) {
 	if (gridShaderVertexSource) this->_gridShaderVertexSource = gridShaderVertexSource;
 	if (gridShaderFragmentSource) this->_gridShaderFragmentSource = gridShaderFragmentSource;
@@ -84,160 +73,237 @@ MainGame::MainGame(const void *soundSource, size_t size, const char* gridShaderV
 }
 MainGame::~MainGame(void) {
 	this->resetGameVariables();
-	if (!this->_GRID_VAO_ID.empty()) {
-		wxLogDebug("[Chain-Reaction] Freeing memory allocated to vertex array object for grid-lines ...");
-		for (auto entry : this->_GRID_VAO_ID) {
-			wxLogDebug(wxString::Format("[Chain-Reaction] Freeing vertex array object for grid-lines at %p ...", entry.second));
-			delete entry.second;
-		}
-		this->_GRID_VAO_ID.clear();
+	if (!this->_gridGeometryCache.empty()) {
+		wxLogDebug("[Chain-Reaction] Freeing memory allocated to vertex array objects for grid-lines ...");
+		this->_gridGeometryIndex.clear();
+		this->_gridGeometryCache.clear();
 	}
 }
+void MainGame::releaseGraphics(void) {
+	wxLogDebug("[Chain-Reaction] Freeing OpenGL objects of the game board ...");
+	this->_gridGeometryIndex.clear();
+	this->_gridGeometryCache.clear();
+	this->_sphere.deleteBuffers();
+	this->_orbInstanceBuffer.deleteBuffer();
+	this->_blastInstanceBuffer.deleteBuffer();
+	this->_blastInstanceCount = 0;
+	this->_loadedBlastWave = UINT64_MAX;
+	this->_frameStateBuffer.deleteBuffer();
+	this->_gridShaderProgram.deleteProgram();
+	this->_orbShaderProgram.deleteProgram();
+	this->_loadedPalette.clear();
+	this->_areShadersInitialized = false;
+}
 bool MainGame::processPlayerInput(uint32_t boardCoordinateX, uint32_t boardCoordinateY) {
 	if (this->isBlastAnimationRunning()) return false; //Current board has bombs which needs to be taken care of before processing any input.
-	const auto& key = (GameUtilities::BoardKey)this->_boardKey(boardCoordinateX, boardCoordinateY);
-	if (!(this->_BOARD.count(key))) {
-		GameUtilities::BoardValue value;
-		value.rotationAxes.x = Random::random(-1, 1); value.rotationAxes.y = Random::random(-3, 3); value.rotationAxes.z = Random::random(-4, 4);
-		if ((value.rotationAxes.x == 0) && (value.rotationAxes.y == 0) && (value.rotationAxes.z == 0)) {
-			value.rotationAxes.x += Random::random(0, 1);
-			value.rotationAxes.y += Random::random(0, 1);
-			value.rotationAxes.z += Random::random(0, 1);
-		}
-		this->_undoBoard = std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue>(this->_BOARD.begin(), this->_BOARD.end());
-		this->_undoTurn = this->_turn;
-		this->_undoEliminated = std::vector<std::string>(this->_eliminated.begin(), this->_eliminated.end());
-
-		value.color = this->_players[this->_turn % (int)(this->_players.size())];
-		value.level = 1;
-		value.boardCoordinate = std::make_pair(boardCoordinateX, boardCoordinateY);
-		this->_BOARD[key] = value;
+	if (boardCoordinateX >= this->_COL_DIV || boardCoordinateY >= this->_ROW_DIV) return false;
+	const uint32_t cellIndex = this->_engine.getCellIndex(boardCoordinateX, boardCoordinateY);
+	if (!this->_engine.isLegalMove(cellIndex)) return false;
+	//The move is recorded before it is applied, since a checkpoint of the game record holds the position before the move.
+	if (this->_recordWriter.isOpen()) {
+		this->_beginRecord();
+		this->_recordWriter.recordMove(this->_engine, cellIndex);
 	}
-	else {
-		if ((this->_players[this->_turn % (int)(this->_players.size())]) != this->_BOARD[key].color) return false;
-		this->_undoBoard = std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue>(this->_BOARD.begin(), this->_BOARD.end());
-		this->_undoTurn = this->_turn;
-		this->_undoEliminated = std::vector<std::string>(this->_eliminated.begin(), this->_eliminated.end());
-		this->_BOARD[key].level += 1;
-		this->_currentBombs = this->_getBombs(this->_BOARD);
-		this->_currentAllNeighbours = this->_getBombNeighbours();
-	}
-	if (this->_currentBombs.empty()) this->_eliminatePlayers(true);
+	this->_engine.processPlayerInput(boardCoordinateX, boardCoordinateY);
+	this->_blastWave++;
+	if (!this->_engine.hasPendingBlast()) this->updateTurn(); //The input did not create any explosive. The turn was passed on to the next player.
 	return true;
 }
+void MainGame::publishBoard(void) {
+	BoardState& board = this->_boardStates.getBackBuffer();
+	board.numberOfRows = this->_ROW_DIV;
+	board.numberOfColumns = this->_COL_DIV;
+	board.cells.clear(); //The capacity is kept, hence the buffers are not reallocated from board to board.
+	const auto& cells = this->_engine.getBoard();
+	for (uint32_t cellIndex = 0; cellIndex < (uint32_t)cells.size(); cellIndex++) {
+		const auto& cell = cells[cellIndex];
+		if (!cell.level) continue;
+		OrbCell orbCell;
+		orbCell.cellIndex = cellIndex;
+		orbCell.owner = cell.owner;
+		orbCell.level = cell.level;
+		orbCell.isExplosive = this->isExplosive(std::make_pair(cellIndex % this->_COL_DIV, cellIndex / this->_COL_DIV));
+		orbCell.rotationAxes = this->_getRotationAxes(cellIndex);
+		board.cells.push_back(orbCell);
+	}
+	board.palette.assign(this->_palette.begin(), this->_palette.end());
+	board.gridColor = this->_gridColor;
+	board.frameState = this->_frameState;
+	this->_getViewportSize(board.viewport[0], board.viewport[1]);
+	const bool isBlastRunning = this->_engine.hasPendingBlast() && !this->_engine.hasGameEnded();
+	board.blastDisplacement = isBlastRunning ? this->_blastDisplacement : 0.0;
+	board.blastSpeed = isBlastRunning ? (this->_CUBE_WIDTH / this->_BLAST_TIME) / 1000.0 : 0.0;
+	board.blastWave = this->_publishedBlastWave = this->_blastWave;
+	board.isRotating = this->hasMovingOrbs();
+	board.time = std::chrono::steady_clock::now();
+	this->_boardStates.publish();
+}
+void MainGame::redo(void) {
+	if (this->isBlastAnimationRunning()) return; //safeguard against redoing when a blast animation is ongoing.
+	this->_stopComputerSearch();
+	this->_blastWave++;
+	if (!this->_engine.canRedo()) return;
+	this->_recordWriter.redoMove(this->_engine);
+	if (this->_engine.redo()) this->updateTurn();
+}
 void MainGame::resetGameVariables(void) {
-	this->_BOARD.clear();
-	this->_undoBoard.clear();
-	this->_eliminated.clear();
-	this->_currentBombs.clear();
-	this->_currentAllNeighbours.clear();
-	this->_undoEliminated.clear();
-	this->_turn = 0;
-	this->_undoTurn = 0;
-	this->_angleOfRotation = 0.0;
+	this->_stopComputerSearch();
+	this->_endRecord();
+	this->_engine.resetGameVariables();
+	this->_blastWave++;
+	this->_rotationAxes.assign(this->_engine.getBoard().size(), glm::vec3(0.0f));
 	this->_blastAnimationRunning = false;
 	this->_blastDisplacement = 0.0;
-	this->_gameHasEnded = false;
+	this->_pendingAnimationTime = 0.0;
 }
 void MainGame::setAttribute(unsigned int numberOfRows, unsigned int numberOfColumns, const std::vector<std::string>& playerList) {
 	this->_ROW_DIV = numberOfRows;
 	this->_COL_DIV = numberOfColumns;
 
-	this->_players.clear();
-	for (const auto& p : playerList) {
-		wxString lowercaseWString = wxString(p.c_str()).Lower();
-		this->_players.push_back(std::string(lowercaseWString));
+	if (!playerList.empty()) {
+		this->_playerColors.clear();
+		this->_palette.clear();
+		for (const auto& p : playerList) {
+			wxString lowercaseWString = wxString(p.c_str()).Lower();
+			this->_playerColors.push_back(std::string(lowercaseWString));
+			this->_palette.push_back(MainGame::_colorMap.at(this->_playerColors.back()));
+		}
 	}
+	this->_stopComputerSearch();
+	this->_endRecord();
+	this->_computerPlayers.clear();
+	this->_playerTypes.clear();
+	this->_engine.setAttribute(numberOfRows, numberOfColumns, (uint8_t)playerList.size());
+	this->_rotationAxes.assign(this->_engine.getBoard().size(), glm::vec3(0.0f));
 
 	this->_lowerleft[0] = -0.5 * (this->_COL_DIV) * (this->_CUBE_WIDTH);
 	this->_lowerleft[1] = -0.5 * (this->_ROW_DIV) * (this->_CUBE_WIDTH);
-
-	const auto& key = (GameUtilities::BoardKey)this->_boardKey(this->_ROW_DIV, this->_COL_DIV);
-	if (!this->_GRID_VAO_ID.count(key)) {
-		VertexArrayObject* va = new VertexArrayObject();
-		this->_createGridData(this->_ROW_DIV, this->_COL_DIV, va, &this->_GRID_VBO_ID[this->_ROW_DIV - 6][this->_COL_DIV - 6], &this->_GRID_IBO_ID[this->_ROW_DIV - 6][this->_COL_DIV - 6], this->_CUBE_WIDTH);
-		this->_GRID_VAO_ID[key] = va;
-	}
 }
 void MainGame::setCanvasSize(unsigned int width, unsigned int height) {
 	this->_DISPLAY[0] = width;
 	this->_DISPLAY[1] = height;
 }
+void MainGame::setComputerPlayers(const std::vector<GameUtilities::PlayerType>& playerTypes) {
+	this->_stopComputerSearch();
+	this->_computerPlayers.clear();
+	this->_computerPlayers.resize(this->_engine.getNumberOfPlayers());
+	this->_playerTypes.assign(this->_engine.getNumberOfPlayers(), GameUtilities::HUMAN_PLAYER);
+	//Player i is seeded with gameSeed + i, hence the seed in the game record reproduces the random choices of the computer players.
+	this->_gameSeed = this->_random.next();
+	for (size_t i = 0; i < playerTypes.size() && i < this->_computerPlayers.size(); i++) {
+		this->_playerTypes[i] = playerTypes[i];
+		if (playerTypes[i] == GameUtilities::ALPHA_BETA_PLAYER) this->_computerPlayers[i] = std::make_unique<AlphaBetaPlayer>(this->_COMPUTER_TIME_BUDGET);
+		else if (playerTypes[i] == GameUtilities::MCTS_PLAYER) this->_computerPlayers[i] = std::make_unique<MctsPlayer>(this->_COMPUTER_TIME_BUDGET);
+		if (this->_computerPlayers[i]) this->_computerPlayers[i]->seed(this->_gameSeed + i);
+	}
+}
 void MainGame::setFrame(AppGUIFrame* frame){
 	this->_mainframe = frame;
 }
 void MainGame::setupCamera() {
-	glViewport(0, 0, (int) this->_pixelCorrectionFactor * this->_DISPLAY[0], (int) this->_pixelCorrectionFactor * this->_DISPLAY[1]);
-	double cameraDistance = glm::length(this->_cameraTarget - this->_cameraPosition); //Distance between camera and target
-	double focusHeight = 0.5 * (this->_ROW_DIV) * (this->_CUBE_WIDTH);
+	//The board is fitted into the view by its rows or, if it is wider than the canvas, by its columns.
+	double focusHeight = 0.5 * (std::max)((double)this->_ROW_DIV, (double)this->_COL_DIV * this->_DISPLAY[1] / this->_DISPLAY[0]) * (this->_CUBE_WIDTH);
+	//Up to a board of 10 rows this widens the field of view. A larger board would need a field of view close to 180 degrees, hence the camera is moved away from the board instead.
+	const double maximumFocusHeight = 5.0 * this->_CUBE_WIDTH;
+	double cameraDistance = this->_cameraDistance;
+	if (focusHeight > maximumFocusHeight) cameraDistance = this->_CUBE_WIDTH + (this->_cameraDistance - this->_CUBE_WIDTH) * focusHeight / maximumFocusHeight;
+	this->_cameraPosition = this->_cameraTarget + (float)cameraDistance * glm::normalize(this->_cameraPosition - this->_cameraTarget);
 	double calibratedDistance = cameraDistance - this->_CUBE_WIDTH; //Zoom out the camera to avoid rendering near the screen edges.
-	glm::mat4 projection = glm::perspective(2 * atan(focusHeight / calibratedDistance), (double)this->_DISPLAY[0] / this->_DISPLAY[1], 1.0, cameraDistance + 100.0);
+	//The board lies within 100 units of the camera target. The near plane is placed accordingly, since depth precision is lost for a distant camera with a close near plane.
+	glm::mat4 projection = glm::perspective(2 * atan(focusHeight / calibratedDistance), (double)this->_DISPLAY[0] / this->_DISPLAY[1], (std::max)(1.0, cameraDistance - 100.0), cameraDistance + 100.0);
 	glm::mat4 view = glm::lookAt(this->_cameraPosition, this->_cameraTarget, this->_cameraUp);
 	glm::mat4 final_mat = projection * view;
-	glm::mat4 _model = glm::mat4(1.0f);
 
 	this->_projection = projection;
 	this->_modelview = view;
-	if (!this->_areShadersInitialized) {
-		wxLogDebug("[Chain-Reaction] Initializing default variables and uploading vertex data to GPU for rendering orbs ...");
-		float radius = (this->_CUBE_WIDTH) / 4.5f;
-		this->_sphere.init(glm::vec3(0, 0, 0), radius, 4);
-		wxLogDebug("[Chain-Reaction] Processing shader-settings for rendering orbs ...");
-		this->_applyOrbShaderSettings();
-		wxLogDebug("[Chain-Reaction] Processing shader-settings for rendering grid-lines ...");
-		this->_applyGridShaderSettings();
-		this->_areShadersInitialized = true;
-	}
-	GLint location = _gridShaderProgram.getUniformLocation("transform");
-	this->_gridShaderProgram.use();
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &final_mat[0][0]);
-	this->_gridShaderProgram.unuse();
-
-	this->_orbShaderProgram.use();
-	location = _orbShaderProgram.getUniformLocation("projectionView");
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &final_mat[0][0]);
-	location = _orbShaderProgram.getUniformLocation("modelTransform");
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &_model[0][0]);
-	this->_orbShaderProgram.unuse();
+	this->_frameState.projectionView = final_mat;
+	this->_frameState.cameraPosition = this->_cameraPosition;
+}
+bool MainGame::startRecording(const std::string& path, uint32_t checkpointInterval) {
+	this->_endRecord();
+	this->_checkpointInterval = checkpointInterval;
+	return this->_recordWriter.open(path);
+}
+void MainGame::stopRecording(void) {
+	this->_endRecord();
+	this->_recordWriter.close();
 }
 void MainGame::undo(void) {
 	if (this->isBlastAnimationRunning()) return; //safeguard against undoing when a blast animation is ongoing.
-	this->_BOARD = std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue>(this->_undoBoard.begin(), this->_undoBoard.end());
-	this->_turn = this->_undoTurn;
-	this->updateTurn();
-	this->_eliminated = std::vector<std::string>(this->_undoEliminated.begin(), this->_undoEliminated.end());
+	this->_stopComputerSearch();
+	this->_blastWave++;
+	//Undo the moves of the computer players as well, so that the turn goes back to the last human player.
+	const bool hasHumanPlayer = std::find(this->_computerPlayers.begin(), this->_computerPlayers.end(), nullptr) != this->_computerPlayers.end() || this->_computerPlayers.empty();
+	bool isUndone = false;
+	while (this->_engine.undo()) {
+		this->_recordWriter.undoMove();
+		isUndone = true;
+		if (!hasHumanPlayer || !this->isComputerTurn()) break;
+	}
+	if (isUndone) this->updateTurn();
+}
+bool MainGame::updateBoard(double deltaTime) {
+	//The game is advanced in fixed time steps, hence a blast takes the same time at any frame rate. Time left over from an update is simulated in the next one.
+	this->_pendingAnimationTime += deltaTime;
+	bool gameHasEnded = false; //Boolean flag to detect the end of a game.
+	while (!gameHasEnded && this->_pendingAnimationTime >= MainGame::_ANIMATION_STEP) {
+		gameHasEnded = this->_updateAnimation(MainGame::_ANIMATION_STEP);
+		this->_pendingAnimationTime -= MainGame::_ANIMATION_STEP;
+	}
+	return gameHasEnded;
+}
+bool MainGame::updateComputerPlayer(void) {
+	if (this->_computerSearch.valid()) {
+		if (this->_computerSearch.wait_for(std::chrono::seconds(0)) != std::future_status::ready) return false;
+		const uint32_t cellIndex = this->_computerSearch.get();
+		//The position may have changed in the meantime (e.g., by undoing a move). A search is then started again on the next call.
+		if (cellIndex == UINT32_MAX || this->_engine.getHash() != this->_computerSearchHash || this->isBlastAnimationRunning()) return false;
+		return this->processPlayerInput(cellIndex % this->_COL_DIV, cellIndex / this->_COL_DIV);
+	}
+	if (this->isBlastAnimationRunning() || !this->isComputerTurn()) return false;
+	ComputerPlayer* player = this->_computerPlayers[this->_engine.getCurrentPlayer()].get();
+	this->_computerSearchHash = this->_engine.getHash();
+	//The search runs on its own copy of the engine, so that rendering and animating the board continues in the meantime.
+	this->_computerSearch = std::async(std::launch::async, [player, position = this->_engine]() {
+		uint32_t cellIndex = UINT32_MAX;
+		if (!player->findMove(position, cellIndex)) return (uint32_t)UINT32_MAX;
+		return cellIndex;
+	});
+	return false;
 }
 void MainGame::updateTurn(void){
-	unsigned int playerNumber = 1 + (this->_turn % this->_players.size());
-	glm::vec4 playerColor = this->_colorMap.at(this->_players[playerNumber - 1]);
-	this->_setColorOfBacksideGrid(0.5f * playerColor.r, 0.5f * playerColor.g, 0.5f * playerColor.b);
-	this->_setColorOfFrontsideGrid(playerColor.r, playerColor.g, playerColor.b);
+	unsigned int playerNumber = this->_engine.getCurrentPlayerNumber();
+	this->_gridColor = this->_palette[this->_engine.getCurrentPlayer()]; //The grid-lines are drawn in the color of the next player (see `publishBoard`).
 	if (this->_mainframe != nullptr) this->_mainframe->UpdateTurnInGUI(playerNumber);
 }
 //************************************************************************************************
 //******************************************* Private methods ************************************
 
+void MainGame::_addOrb(glm::vec3 center, glm::vec3 axes, double angleOfRotation, unsigned int level, uint8_t player) {
+	VertexStructure::OrbInstance orb;
+	if (level == 1) { //A single orb jitters instead of rotating.
+		orb.center = VertexStructure::Position((GLfloat)(center.x + this->_renderRandom.random(0, 1) / 3.0), (GLfloat)(center.y + this->_renderRandom.random(0, 1) / 3.0), (GLfloat)(center.z + this->_renderRandom.random(0, 1) / 3.0));
+		axes = glm::vec3(0.0f, 0.0f, 1.0f);
+		angleOfRotation = 0.0;
+	}
+	else orb.center = VertexStructure::Position(center.x, center.y, center.z);
+	orb.direction[0] = orb.direction[1] = 0.0f; //At rest.
+	orb.rotation[0] = axes.x;
+	orb.rotation[1] = axes.y;
+	orb.rotation[2] = axes.z;
+	orb.rotation[3] = (GLfloat)angleOfRotation;
+	orb.colorIndex = (GLfloat)player;
+	this->_orbInstances[(std::min)(level, 3u) - 1].push_back(orb);
+}
 void MainGame::_applyGridShaderSettings(void) {
 	//***************************************************************************
 	//**************************************  Grid-data setup *******************
-	const auto& key = (GameUtilities::BoardKey)this->_boardKey(this->_ROW_DIV, this->_COL_DIV);
-	if (!this->_GRID_VAO_ID.count(key)) {
-		VertexArrayObject* vao = new VertexArrayObject();
-		this->_createGridData(this->_ROW_DIV, this->_COL_DIV, vao, &this->_GRID_VBO_ID[this->_ROW_DIV - 6][this->_COL_DIV - 6], &this->_GRID_IBO_ID[this->_ROW_DIV - 6][this->_COL_DIV - 6], this->_CUBE_WIDTH);
-		this->_GRID_VAO_ID[key] = vao;
-		wxLogDebug(wxString::Format("[Chain-Reaction] Created vertex array object for grid-lines at %p ...", vao));
-	}
+	//The grid-lines of a board dimension are generated when it is drawn for the first time (see `_drawGrid`).
 	wxLogDebug("[Chain-Reaction] Compiling shaders for rendering grid-lines ...");
 	this->_gridShaderProgram.compileShaders(this->_gridShaderVertexSource.c_str(), this->_gridShaderFragmentSource.c_str(), true);
-	glm::mat4 defaultMatrix = glm::mat4(1.0f);
-	this->_gridShaderProgram.use();
-	GLint location = this->_gridShaderProgram.getUniformLocation("transform");
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &defaultMatrix[0][0]);
-	location = this->_gridShaderProgram.getUniformLocation("backsideColor");
-	if (location != -1) glUniform4f(location, 0.0f, 0.5f, 0.0f, 1.0f);
-	location = this->_gridShaderProgram.getUniformLocation("frontsideColor");
-	if (location != -1) glUniform4f(location, 0.0f, 1.0f, 0.0f, 1.0f);
-	this->_gridShaderProgram.unuse();
+	//The colors of the grid-lines are set whenever they are drawn, as they change from turn to turn.
+	this->_gridBacksideColor = this->_gridShaderProgram.getUniform("backsideColor");
+	this->_gridFrontsideColor = this->_gridShaderProgram.getUniform("frontsideColor");
 }
 void MainGame::_applyOrbShaderSettings(void) {
 	//******************************************************************************************************
@@ -245,31 +311,14 @@ void MainGame::_applyOrbShaderSettings(void) {
 	wxLogDebug("[Chain-Reaction] Compiling shader for rendering orbs ...");
 	this->_orbShaderProgram.compileShaders(this->_orbShaderVertexSource.c_str(), this->_orbShaderFragmentSource.c_str(), true);
 	this->_orbShaderProgram.use();
-	//Update orbColor uniform variable
-	GLint location = this->_orbShaderProgram.getUniformLocation("orbColor");
-	GLfloat defaultOrbColor[] = { 1.0f, 0.0f, 1.0f, 1.0f };
-	if (location != -1) glUniform4fv(location, 1, defaultOrbColor);
-	//***********************************************************
-	//Update uniform variable (modelview matrix) in shader
-	glm::mat4 defaultMatrix = glm::mat4(1.0f);
-	location = this->_orbShaderProgram.getUniformLocation("modelTransform");
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &defaultMatrix[0][0]);
-	//********************************************************************************
-	//Update uniform variable (projection matrix) in shader
-	location = this->_orbShaderProgram.getUniformLocation("projectionView");
-	if (location != -1) glUniformMatrix4fv(location, 1, GL_FALSE, &defaultMatrix[0][0]);
-	//******************************************************************************
-	//Update Lightdirection calculated from latitude and longitude in OpenGL coordinate system
-	glm::vec3 lightDir = this->getGlCompatibleCoordinate(1.0f, this->_lightDirLatitude, this->_lightDirLongitude);
-	location = this->_orbShaderProgram.getUniformLocation("lightDirection");
-	if (location != -1) glUniform3f(location, lightDir.x, lightDir.y, lightDir.z);
-	//*************************************************************************
-	//Update camera position 
-	location = this->_orbShaderProgram.getUniformLocation("cameraPosition");
-	if (location != -1) glUniform3f(location, this->_cameraPosition.x, this->_cameraPosition.y, this->_cameraPosition.z); //Update uniform variable (camera position) in shader
+	//The palette of orb colors is loaded before the orbs are drawn next.
+	this->_orbPalette = this->_orbShaderProgram.getUniform("palette[0]");
+	this->_orbBlastDisplacement = this->_orbShaderProgram.getUniform("blastDisplacement");
+	this->_loadedPalette.clear();
+	//Projection, camera position and light direction are read from the uniform block FrameState (see `drawBoard`).
 	//*************************************************************
 	//Update uniform variable (vDiffuse) in shader
-	location = this->_orbShaderProgram.getUniformLocation("vDiffuse");
+	GLint location = this->_orbShaderProgram.getUniformLocation("vDiffuse");
 	if (location != -1) glUniform3f(location, 0.0f, 0.0f, 0.0f);
 	//********************************************************************
 	//Update uniform variable (vSpecular) in shader
@@ -283,6 +332,19 @@ void MainGame::_applyOrbShaderSettings(void) {
 	this->_orbShaderProgram.unuse();
 	//*************************************************************
 }
+void MainGame::_beginRecord(void) {
+	if (!this->_recordWriter.isOpen() || this->_recordWriter.isRecording()) return;
+	GameRecord::Header header;
+	header.rows = this->_engine.getNumberOfRows();
+	header.columns = this->_engine.getNumberOfColumns();
+	for (uint8_t player = 0; player < this->_engine.getNumberOfPlayers(); player++) {
+		header.playerTypes.push_back((uint8_t)(player < this->_playerTypes.size() ? this->_playerTypes[player] : GameUtilities::HUMAN_PLAYER));
+		header.playerNames.push_back(player < this->_playerColors.size() ? this->_playerColors[player] : std::string());
+	}
+	header.seed = this->_gameSeed;
+	header.checkpointInterval = this->_checkpointInterval;
+	this->_recordWriter.beginGame(header);
+}
 std::unordered_map<std::string, glm::vec4> MainGame::_createColorMap() {
 	std::unordered_map<std::string, glm::vec4> colorMap;
 	colorMap["green 1"] = { 0.0f, 1.0f, 127.0f / 255.0f, 1.0f };
@@ -307,6 +369,8 @@ void MainGame::_createGridData(unsigned int numberOfRows, unsigned int numberOfC
 	unsigned int height = numberOfRows * cubeWidth;
 	VertexStructure::Vertex v;
 	std::vector<VertexStructure::Vertex > vertex_list, front_face; //first stores all vertices of back face and then stores vertices of front face;
+	vertex_list.reserve(2 * (size_t)(numberOfRows + 1) * (numberOfColumns + 1));
+	front_face.reserve((size_t)(numberOfRows + 1) * (numberOfColumns + 1));
 	for (int i = 0; i != numberOfRows + 1; i++) {
 		for (int j = 0; j != numberOfColumns + 1; j++) {
 			v.position.x = (float)(centerX - 0.5 * width) + j * cubeWidth;
@@ -330,6 +394,7 @@ void MainGame::_createGridData(unsigned int numberOfRows, unsigned int numberOfC
 	vao->setVertexBuffer(*vbo, layout);
 
 	std::vector<GLuint> indices;
+	indices.reserve(4 * (size_t)(numberOfRows + numberOfColumns + 2) + 2 * (size_t)(numberOfRows + 1) * (numberOfColumns + 1));
 
 	for (int i = 0; i != numberOfRows + 1; i++) {
 		indices.push_back(i * (numberOfColumns + 1));
@@ -350,10 +415,11 @@ void MainGame::_createGridData(unsigned int numberOfRows, unsigned int numberOfC
 	ibo->loadNewBuffer(&indices[0], indices.size());
 	vao->setIndexBuffer(*ibo);
 }
-void MainGame::_drawGrid(){
+void MainGame::_drawGrid(const BoardState& board){
 	this->_gridShaderProgram.use();
-	const auto& key = (GameUtilities::BoardKey)this->_boardKey(this->_ROW_DIV, this->_COL_DIV);
-	VertexArrayObject* vao = this->_GRID_VAO_ID[key];
+	this->_gridBacksideColor.set(glm::vec4(0.5f * glm::vec3(board.gridColor), 1.0f));
+	this->_gridFrontsideColor.set(glm::vec4(glm::vec3(board.gridColor), 1.0f));
+	VertexArrayObject* vao = this->_getGridGeometry(board.numberOfRows, board.numberOfColumns);
 	vao->bind();
 	for (GLuint i = 0; i < vao->numAttr(); i++) {
 		glEnableVertexAttribArray(i);
@@ -365,96 +431,66 @@ void MainGame::_drawGrid(){
 	vao->unbind();
 	this->_gridShaderProgram.unuse();
 }
-void MainGame::_drawOrb(glm::vec3 center, glm::vec3 axes, double angleOfRotation, unsigned int level, const char* colorName) {
+void MainGame::_drawOrbs(const std::vector<glm::vec4>& palette, double blastDisplacement) {
 	this->_orbShaderProgram.use();
-	glm::mat4 _model = glm::mat4(1.0f);
-	std::string currentColorName = this->_sphere.getColor();
-	if (std::strcmp(currentColorName.c_str(), colorName)) {
-		this->_sphere.setColor(colorName);
-		const auto& color = MainGame::_colorMap.at(colorName);
-		GLint location = this->_orbShaderProgram.getUniformLocation("orbColor");
-		glUniform4f(location, color.r, color.g, color.b, 1.0f);
+	this->_orbBlastDisplacement.set((GLfloat)blastDisplacement); //Only the orbs of the blast wave have a direction, hence the other orbs stay at rest.
+	if (!palette.empty() && palette != this->_loadedPalette) {
+		this->_orbPalette.set(&palette[0], (GLsizei)(std::min)(palette.size(), MainGame::_PALETTE_SIZE));
+		this->_loadedPalette = palette;
 	}
-	if (level == 1) {
-		_model = glm::translate(glm::mat4(1.0f), glm::vec3(center.x + Random::random(0, 1) / 3.0, center.y + Random::random(0, 1) / 3.0, center.z + Random::random(0, 1) / 3.0));
-		GLint location = this->_orbShaderProgram.getUniformLocation("modelTransform");
-		glUniformMatrix4fv(location, 1, GL_FALSE, &_model[0][0]);
-		this->_sphere.draw(1);
-	}
-	else {
-		_model = glm::translate(glm::mat4(1.0f), center) * glm::rotate(glm::mat4(1.0f), (float)angleOfRotation, axes);
-		GLint location = this->_orbShaderProgram.getUniformLocation("modelTransform");
-		glUniformMatrix4fv(location, 1, GL_FALSE, &_model[0][0]);
-		this->_sphere.draw(level);
+	//The orbs of all levels are uploaded at once; each level is drawn from its own range of the instance buffer.
+	const uint32_t singleOrbCount = (uint32_t)this->_orbInstances[0].size(), doubleOrbCount = (uint32_t)this->_orbInstances[1].size(), tripleOrbCount = (uint32_t)this->_orbInstances[2].size();
+	auto& instances = this->_orbInstances[0];
+	instances.insert(instances.end(), this->_orbInstances[1].begin(), this->_orbInstances[1].end());
+	instances.insert(instances.end(), this->_orbInstances[2].begin(), this->_orbInstances[2].end());
+	if (!instances.empty()) {
+		this->_orbInstanceBuffer.streamData(&instances[0], (unsigned int)(instances.size() * sizeof(VertexStructure::OrbInstance)));
+		this->_sphere.drawInstanced(1, this->_orbInstanceBuffer, this->_orbInstanceLayout, 0, singleOrbCount);
+		this->_sphere.drawInstanced(2, this->_orbInstanceBuffer, this->_orbInstanceLayout, singleOrbCount, doubleOrbCount);
+		this->_sphere.drawInstanced(3, this->_orbInstanceBuffer, this->_orbInstanceLayout, singleOrbCount + doubleOrbCount, tripleOrbCount);
 	}
+	for (auto& orbs : this->_orbInstances) orbs.clear();
+	this->_sphere.drawInstanced(1, this->_blastInstanceBuffer, this->_orbInstanceLayout, 0, this->_blastInstanceCount);
 	this->_orbShaderProgram.unuse();
 }
-void MainGame::_eliminatePlayers(bool updateTurnVariable) {
-	if ((this->_turn) < (unsigned int)(this->_players.size())) {
-		this->_turn++;
-		this->updateTurn();
-		return;
-	}
-	bool valid = false;
-	for (const auto& player : this->_players) {
-		if (!(this->isEliminated(player))) {
-			valid = true;
-			for (const auto& boardEntry : this->_BOARD) {
-				if (player == boardEntry.second.color) {
-					valid = false;
-					break;
-				}
-			}
-			if (valid) this->_eliminated.push_back(player);
-		}
-	}
-	if (updateTurnVariable) {
-		while (1) {
-			this->_turn += 1;
-			const std::string& tempPlayer = this->_players[this->_turn % this->_players.size()];
-			if (!(this->isEliminated(tempPlayer))) break;
-		}
-		this->updateTurn();
+void MainGame::_endRecord(void) {
+	if (!this->_recordWriter.isRecording()) return;
+	if (!this->_recordWriter.endGame(this->_engine.hasGameEnded() ? this->_engine.getWinnerIndex() : 0)) wxLogDebug("[Chain-Reaction] Error: could not write the record of the last game ...");
+}
+const glm::vec3& MainGame::_getRotationAxes(uint32_t cellIndex) {
+	glm::vec3& rotationAxes = this->_rotationAxes[cellIndex];
+	if ((rotationAxes.x != 0) || (rotationAxes.y != 0) || (rotationAxes.z != 0)) return rotationAxes;
+	rotationAxes.x = this->_random.random(-1, 1); rotationAxes.y = this->_random.random(-3, 3); rotationAxes.z = this->_random.random(-4, 4);
+	if ((rotationAxes.x == 0) && (rotationAxes.y == 0) && (rotationAxes.z == 0)) {
+		rotationAxes.x += this->_random.random(0, 1);
+		rotationAxes.y += this->_random.random(0, 1);
+		rotationAxes.z += this->_random.random(0, 1);
 	}
-}
-std::vector<std::pair<GameUtilities::BoardKey, GameUtilities::BoardValue>> MainGame::_getBombs(const std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue>& board) {
-	std::vector<std::pair<GameUtilities::BoardKey, GameUtilities::BoardValue>> bombList;
-	for (const auto& boardEntry : board) {
-		const auto& boardCoordinate = boardEntry.second.boardCoordinate;
-		unsigned int neighbourCount = 0;
-		if (boardCoordinate.first + 1 != this->_COL_DIV) neighbourCount++;
-		if (boardCoordinate.first >= 1) neighbourCount++;
-		if (boardCoordinate.second + 1 != this->_ROW_DIV) neighbourCount++;
-		if (boardCoordinate.second >= 1) neighbourCount++;
-		if (neighbourCount <= boardEntry.second.level) bombList.push_back(boardEntry);
+	return rotationAxes;
+}
+VertexArrayObject* MainGame::_getGridGeometry(unsigned int numberOfRows, unsigned int numberOfColumns) {
+	const auto key = (GameUtilities::BoardKey)this->_boardKey(numberOfRows, numberOfColumns);
+	const auto entry = this->_gridGeometryIndex.find(key);
+	if (entry != this->_gridGeometryIndex.end()) {
+		this->_gridGeometryCache.splice(this->_gridGeometryCache.begin(), this->_gridGeometryCache, entry->second);
+		return &entry->second->second->vao;
 	}
-	return bombList;
-}
-std::unordered_map<GameUtilities::BoardKey, uint32_t> MainGame::_getBombNeighbours() {
-	std::unordered_map<GameUtilities::BoardKey, uint32_t> allNeighbours;
-	for (const auto& bomb : this->_currentBombs) {
-		const auto& boxCoordinate = bomb.second.boardCoordinate;
-		const std::set<std::pair<uint32_t, uint32_t> >& listOfNeighbours = this->_getNeighbours(boxCoordinate.first, boxCoordinate.second);
-		for (const auto& neighbour : listOfNeighbours) {
-			const auto& key = (GameUtilities::BoardKey)this->_boardKey(neighbour.first, neighbour.second);
-			if (!allNeighbours.count(key)) allNeighbours[key] = 1;
-			else allNeighbours[key] += 1;
-		}
+	while (!this->_gridGeometryCache.empty() && this->_gridGeometryCache.size() >= this->_GRID_CACHE_SIZE) {
+		wxLogDebug(wxString::Format("[Chain-Reaction] Freeing vertex array object for grid-lines at %p ...", &this->_gridGeometryCache.back().second->vao));
+		this->_gridGeometryIndex.erase(this->_gridGeometryCache.back().first);
+		this->_gridGeometryCache.pop_back();
 	}
-	return allNeighbours;
-}
-std::set<std::pair<uint32_t, uint32_t> > MainGame::_getNeighbours(uint32_t boardCoordinateX, uint32_t boardCoordinateY){
-	std::set<std::pair<uint32_t,uint32_t> > neighbours;
-	if (boardCoordinateX + 1 != this->_COL_DIV) neighbours.insert(std::make_pair(boardCoordinateX + 1, boardCoordinateY));
-	if (boardCoordinateX >= 1) neighbours.insert(std::make_pair(boardCoordinateX - 1, boardCoordinateY));
-	if (boardCoordinateY + 1 != this->_ROW_DIV) neighbours.insert(std::make_pair(boardCoordinateX, boardCoordinateY + 1));
-	if (boardCoordinateY >= 1) neighbours.insert(std::make_pair(boardCoordinateX, boardCoordinateY - 1));
-	return neighbours;
+	std::unique_ptr<GridGeometry> geometry = std::make_unique<GridGeometry>();
+	this->_createGridData(numberOfRows, numberOfColumns, &geometry->vao, &geometry->vbo, &geometry->ibo, this->_CUBE_WIDTH);
+	wxLogDebug(wxString::Format("[Chain-Reaction] Created vertex array object for grid-lines at %p ...", &geometry->vao));
+	this->_gridGeometryCache.emplace_front(key, std::move(geometry));
+	this->_gridGeometryIndex[key] = this->_gridGeometryCache.begin();
+	return &this->_gridGeometryCache.front().second->vao;
 }
 void MainGame::_getWorldCoordinates(double x, double y, double& worldCoordinateX, double& worldCoordinateY, double& worldCoordinateZ){
-	GLint viewport[4];
-	glGetIntegerv(GL_VIEWPORT, viewport);
-	glm::vec4 currentViewport = glm::vec4(viewport[0], viewport[1], viewport[2], viewport[3]);
+	int viewportWidth = 0, viewportHeight = 0;
+	this->_getViewportSize(viewportWidth, viewportHeight); //The viewport is set by the render thread, hence it is not queried from OpenGL.
+	glm::vec4 currentViewport = glm::vec4(0, 0, viewportWidth, viewportHeight);
 	glm::vec3 objectLocation = glm::vec3((double) this->_lowerleft[0] * this->_pixelCorrectionFactor, (double) this->_lowerleft[1] * this->_pixelCorrectionFactor, 0);
 	glm::vec3 output = glm::project(objectLocation, this->_modelview, this->_projection, currentViewport);
 	glm::vec3 windowLocation = glm::vec3((double) x * this->_pixelCorrectionFactor, (double)(this->_DISPLAY[1] - y) * this->_pixelCorrectionFactor, output.z);
@@ -471,24 +507,58 @@ void MainGame::_initDefaults(void) {
 	this->_COL_DIV = 6;
 	this->_CUBE_WIDTH = 20;
 	this->_ROTATION_SPEED = 2; // degree/sec rotation speed
-	this->_players.push_back("red"); this->_players.push_back("blue");
 	this->_blastAnimationRunning = false;
 	this->_BLAST_TIME = 0.22; //total time to finish one blast in seconds
 	this->_blastDisplacement = 0.0;
 
 	this->_lowerleft[0] = -0.5 * (this->_COL_DIV) * (this->_CUBE_WIDTH);
 	this->_lowerleft[1] = -0.5 * (this->_ROW_DIV) * (this->_CUBE_WIDTH);
+	this->_rotationAxes.assign(this->_engine.getBoard().size(), glm::vec3(0.0f));
+	this->_playerColors = { "red", "blue" };
+	this->_palette = { MainGame::_colorMap.at("red"), MainGame::_colorMap.at("blue") };
+	this->_gridColor = MainGame::_colorMap.at("green");
+	this->_orbInstanceLayout.addLayout(GL_FLOAT, 3, GL_FALSE); //Center
+	this->_orbInstanceLayout.addLayout(GL_FLOAT, 4, GL_FALSE); //Rotation axis and angle
+	this->_orbInstanceLayout.addLayout(GL_FLOAT, 1, GL_FALSE); //Color index in the palette
+	this->_orbInstanceLayout.addLayout(GL_FLOAT, 2, GL_FALSE); //Blast direction
+	static_assert(sizeof(VertexStructure::OrbInstance) == 40, "The orb instance layout must match the byte size of VertexStructure::OrbInstance.");
 
 	this->_DISPLAY[0] = 510;
 	this->_DISPLAY[1] = 680;
+	this->_cameraDistance = 300.0;
 	this->_cameraPosition = { 0.0f, 0.0f, 300.0f };
 	this->_cameraTarget = { 0.0f, 0.0f, 0.0f };
 	this->_cameraUp = { 0.0f, 1.0f, 0.0f };
 	this->_lightDirLatitude = 0.0f;
 	this->_lightDirLongitude = 180.0f;
+	this->_frameState.lightDirection = this->getGlCompatibleCoordinate(1.0f, this->_lightDirLatitude, this->_lightDirLongitude);
 	this->_audioID = 0;
 	this->_audioSourceID = 0;
 }
+void MainGame::_loadBlastWave(const BoardState& board) {
+	static const GLfloat directions[4][2] = { { 1.0f, 0.0f }, { -1.0f, 0.0f }, { 0.0f, 1.0f }, { 0.0f, -1.0f } };
+	std::vector<VertexStructure::OrbInstance> orbs;
+	const double lowerleft[2] = { -0.5 * board.numberOfColumns * this->_CUBE_WIDTH, -0.5 * board.numberOfRows * this->_CUBE_WIDTH };
+	for (const auto& cell : board.cells) {
+		if (!cell.isExplosive) continue;
+		const unsigned int column = cell.cellIndex % board.numberOfColumns, row = cell.cellIndex / board.numberOfColumns;
+		//Every neighbouring site of an explosive receives an orb.
+		const bool hasNeighbour[4] = { column + 1 < board.numberOfColumns, column >= 1, row + 1 < board.numberOfRows, row >= 1 };
+		VertexStructure::OrbInstance orb;
+		orb.center = VertexStructure::Position((GLfloat)((column + 0.5) * this->_CUBE_WIDTH + lowerleft[0]), (GLfloat)((row + 0.5) * this->_CUBE_WIDTH + lowerleft[1]), 0.0f);
+		orb.rotation[0] = 0.0f; orb.rotation[1] = 0.0f; orb.rotation[2] = 1.0f; orb.rotation[3] = 0.0f;
+		orb.colorIndex = (GLfloat)cell.owner;
+		for (int i = 0; i < 4; i++) {
+			if (!hasNeighbour[i]) continue;
+			orb.direction[0] = directions[i][0];
+			orb.direction[1] = directions[i][1];
+			orbs.push_back(orb);
+		}
+	}
+	this->_blastInstanceCount = (uint32_t)orbs.size();
+	if (!orbs.empty()) this->_blastInstanceBuffer.streamData(&orbs[0], (unsigned int)(orbs.size() * sizeof(VertexStructure::OrbInstance)));
+	this->_loadedBlastWave = board.blastWave;
+}
 bool MainGame::_initSound(const char* soundSourceName) {
 	ALuint soundID = SoundSystem::addAudioData(soundSourceName);
 	ALuint sourceID = SoundSystem::addAudioSource(1.0f, 1.0f);
@@ -505,107 +575,48 @@ bool MainGame::_initSound(const void* soundSource, size_t size) {
 	this->_audioSourceID = sourceID;
 	return true;
 }
-bool MainGame::_runBlastAnimation(unsigned long deltaTime) {
-	if (this->_gameHasEnded) return true;
-	bool gameHasEnded = false; //boolean flag to detect the end of a game.
-	if (this->_blastDisplacement == 0.0) SoundSystem::play(this->_audioID, this->_audioSourceID); //play game audio at the beginning of each blast animation.
-	glm::vec3 displacedCenter = { 0.0f, 0.0f, 0.0f };
-	this->_blastDisplacement += ((this->_CUBE_WIDTH / this->_BLAST_TIME) * deltaTime) / 1000.0;
-	if (this->_blastDisplacement < this->_CUBE_WIDTH) { //A blast animation is still running.
-		glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); //Clear color and depth buffer before rendering new frame.
-		this->_drawGrid();
-		for (const auto& boardEntry : this->_BOARD) {
-			const auto& key = boardEntry.second.boardCoordinate;
-			glm::vec3 center = { (key.first + 0.5f) * this->_CUBE_WIDTH + this->_lowerleft[0],
-								(key.second + 0.5f) * this->_CUBE_WIDTH + this->_lowerleft[1],
-								0.0f };
-			const char* color = boardEntry.second.color.c_str();
-			double angle = remainder(this->_angleOfRotation, 360.0);
-			if (!(this->isExplosive(key))) this->_drawOrb(center, boardEntry.second.rotationAxes, angle, boardEntry.second.level, color);
-			else {
-				if (this->_currentAllNeighbours.count((GameUtilities::BoardKey)this->_boardKey(key.first + 1, key.second))) {
-					displacedCenter.x = center.x + this->_blastDisplacement; displacedCenter.y = center.y; displacedCenter.z = center.z;
-					this->_drawOrb(displacedCenter, boardEntry.second.rotationAxes, angle, 1, color);
-				}
-				if (this->_currentAllNeighbours.count((GameUtilities::BoardKey)this->_boardKey(key.first - 1, key.second))) {
-					displacedCenter.x = center.x - this->_blastDisplacement; displacedCenter.y = center.y; displacedCenter.z = center.z;
-					this->_drawOrb(displacedCenter, boardEntry.second.rotationAxes, angle, 1, color);
-				}
-				if (this->_currentAllNeighbours.count((GameUtilities::BoardKey)this->_boardKey(key.first, key.second + 1))) {
-					displacedCenter.x = center.x; displacedCenter.y = center.y + this->_blastDisplacement; displacedCenter.z = center.z;
-					this->_drawOrb(displacedCenter, boardEntry.second.rotationAxes, angle, 1, color);
-				}
-				if (this->_currentAllNeighbours.count((GameUtilities::BoardKey)this->_boardKey(key.first, key.second - 1))) {
-					displacedCenter.x = center.x; displacedCenter.y = center.y - this->_blastDisplacement; displacedCenter.z = center.z;
-					this->_drawOrb(displacedCenter, boardEntry.second.rotationAxes, angle, 1, color);
-				}
-			}
-		}
-		this->_angleOfRotation += ((this->_ROTATION_SPEED * deltaTime) / 1000.0);
+void MainGame::_renderBoard(const BoardState& board, double blastDisplacement) {
+	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT); //Clear color and depth buffer before rendering new frame.
+	this->_drawGrid(board);
+	if (board.blastWave != this->_loadedBlastWave) this->_loadBlastWave(board);
+	const double lowerleft[2] = { -0.5 * board.numberOfColumns * this->_CUBE_WIDTH, -0.5 * board.numberOfRows * this->_CUBE_WIDTH };
+	const double angle = remainder(this->_angleOfRotation, 360.0);
+	for (const auto& cell : board.cells) {
+		if (cell.isExplosive) continue; //Its orbs are drawn from the instance buffer of the blast wave.
+		glm::vec3 center = { (cell.cellIndex % board.numberOfColumns + 0.5f) * this->_CUBE_WIDTH + lowerleft[0],
+							(cell.cellIndex / board.numberOfColumns + 0.5f) * this->_CUBE_WIDTH + lowerleft[1],
+							0.0f };
+		this->_addOrb(center, cell.rotationAxes, angle, cell.level, cell.owner);
 	}
-	else { //A blast animation is completed. Update board.
-		const auto& bomb = this->_currentBombs[0];
-		GameUtilities::BoardKey key = bomb.first;
-		std::string bombColorName = bomb.second.color;
-		for (const auto& bombEntry : this->_currentBombs) this->_BOARD.erase(bombEntry.first);
-		for (const auto& neighbourEntry : this->_currentAllNeighbours) {
-			key = neighbourEntry.first;
-			if (this->_BOARD.count(key)) {
-				this->_BOARD[key].level += neighbourEntry.second;
-				this->_BOARD[key].color.assign(bombColorName);
-			}
-			else {
-				GameUtilities::BoardValue value;
-				value.rotationAxes.x = Random::random(-1, 1); value.rotationAxes.y = Random::random(-3, 3); value.rotationAxes.z = Random::random(-4, 4);
-				if ((value.rotationAxes.x == 0) && (value.rotationAxes.y == 0) && (value.rotationAxes.z == 0)) {
-					value.rotationAxes.x += Random::random(0, 1);
-					value.rotationAxes.y += Random::random(0, 1);
-					value.rotationAxes.z += Random::random(0, 1);
-				}
-				value.level = neighbourEntry.second;
-				value.color = bombColorName;
-				value.boardCoordinate = this->_inverseKey(key);
-				this->_BOARD[key] = value;
-			}
-		}
-		//Update the current list of explosive sites. If new explosive sites are created after the preceeding blasts, those are processed in the next animation.
-		this->_currentBombs = this->_getBombs(this->_BOARD);
-		//Update the current list of sites that have an explosive neighbouring site.
-		this->_currentAllNeighbours = this->_getBombNeighbours();
-		//Reset the variable for processing the next blast animation.
-		this->_blastDisplacement = 0.0;
-		//Update the list of eliminated players after a blast. This does not alter the turn variable of the game.
-		this->_eliminatePlayers(false);
-		//Check if game has ended after a blast:
-		if ((int)this->_eliminated.size() == (int)this->_players.size() - 1) {
-			AppGUIFrame* frame = this->getFrame();
-			if (frame != nullptr) frame->swapBuffers();
-			std::string winnerName = "";
-			int winnerIndex = 1;
-			for (const auto& player : this->_players) {
-				if (!(this->isEliminated(player))) {
-					winnerName = player;
-					break;
-				}
-				winnerIndex++;
-			}
-			this->_winnerIndex = winnerIndex;
-			this->_winnerName.assign(winnerName);
-			this->_gameHasEnded = true;
-			gameHasEnded = true; //game has ended.
+	this->_drawOrbs(board.palette, blastDisplacement);
+}
+void MainGame::_stopComputerSearch(void) {
+	if (!this->_computerSearch.valid()) return;
+	//The stop request is repeated until the search has finished, since a request made before the search started is reset by it.
+	while (this->_computerSearch.wait_for(std::chrono::milliseconds(1)) != std::future_status::ready) {
+		for (auto& player : this->_computerPlayers) {
+			if (player) player->stop();
 		}
 	}
-	return gameHasEnded; //game has not yet ended.
+	this->_computerSearch.get();
 }
-void MainGame::_setColorOfBacksideGrid(float colorR, float colorG, float colorB) {
-	this->_gridShaderProgram.use();
-	GLint location = this->_gridShaderProgram.getUniformLocation("backsideColor");
-	if (location != -1) glUniform4f(location, colorR, colorG, colorB, 1.0f);
-	this->_gridShaderProgram.unuse();
-}
-void MainGame::_setColorOfFrontsideGrid(float colorR, float colorG, float colorB) {
-	this->_gridShaderProgram.use();
-	GLint location = this->_gridShaderProgram.getUniformLocation("frontsideColor");
-	if (location != -1) glUniform4f(location, colorR, colorG, colorB, 1.0f);
-	this->_gridShaderProgram.unuse();
+bool MainGame::_updateAnimation(double timeStep) {
+	bool gameHasEnded = false; //boolean flag to detect the end of a game.
+	if (this->_engine.hasPendingBlast()) {
+		if (this->_engine.hasGameEnded()) return true;
+		this->_blastAnimationRunning = true;
+		if (this->_blastDisplacement == 0.0) SoundSystem::play(this->_audioID, this->_audioSourceID); //play game audio at the beginning of each blast animation.
+		this->_blastDisplacement += ((this->_CUBE_WIDTH / this->_BLAST_TIME) * timeStep) / 1000.0;
+		if (this->_blastDisplacement >= this->_CUBE_WIDTH) { //A blast animation is completed. Update board.
+			for (const auto& bombIndex : this->_engine.getCurrentBombs()) this->_rotationAxes[bombIndex] = glm::vec3(0.0f); //Exploded sites are emptied.
+			//Resolve the blast in the rules engine. If new explosive sites are created after the preceeding blasts, those are processed in the next animation.
+			gameHasEnded = this->_engine.runBlast();
+			this->_blastWave++;
+			//Reset the variable for processing the next blast animation.
+			this->_blastDisplacement = 0.0;
+			if (!gameHasEnded && !this->_engine.hasPendingBlast()) this->updateTurn(); //A full sequence of blasts is completed and the turn was passed on to the next player.
+		}
+	}
+	else this->_blastAnimationRunning = false; //A full sequence of blasts is completed.
+	return gameHasEnded;
 }
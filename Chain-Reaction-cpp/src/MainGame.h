@@ -4,9 +4,9 @@
 
 #include "PrecompiledHeader.h" //precompiled header
 #include "AppGUIFrame.h"
-#include "Random.h"
 #include "VertexArrayObject.h"
 #include "VertexBufferObject.h"
+#include "UniformBufferObject.h"
 #include "IndexBufferObject.h"
 #include "VertexLayout.h"
 #include "Shaders.h"
@@ -14,15 +14,41 @@
 #include "Utilities.h"
 #include "AudioFile.h"
 #include "SoundSystem.h"
+#include "GameEngine.h"
+#include "GameRecord.h"
+#include "AlphaBetaPlayer.h"
+#include "MctsPlayer.h"
+#include "OpeningBook.h"
+#include "RandomGenerator.h"
+#include "LockFreeQueue.h"
 
+/*
+* @brief The game object is shared by two threads: the UI thread runs the game (i.e., inputs, computer players, blasts) and publishes the board with `publishBoard`,
+* @brief while the render thread of the canvas draws the most recently published board with `drawBoard`. The render thread owns every OpenGL object of the game.
+*/
 class MainGame{
 public:
 	/*
-	* @brief Draws the current board of the game and animates a blast if there are any.
-	* @param {unsigned long} deltaTime: average time (in milliseconds) taken to render each frame.
-	* @returns {bool} true if the current game has ended (i.e., all orbs in the board are of same color), false otherwise.
+	* @brief Motion of a drawn board, which determines how often the render thread redraws it.
+	*/
+	enum BoardMotion {
+		STATIC_BOARD = 0, //The board is redrawn only when a new board is published.
+		ROTATING_ORBS = 1, //The orbs rotate, hence the board is redrawn at a low frame rate.
+		RUNNING_BLAST = 2 //Orbs of a blast are moving, hence the board is redrawn at the full frame rate.
+	};
+	/*
+	* @brief Draws the board most recently published with `publishBoard`. Must be called on the render thread with the OpenGL context being current.
+	* @brief The orbs are rotated by the render thread itself, and the orbs of a blast are moved on from the time the board was published.
+	* @brief Hence they move smoothly even while the UI thread is held up, e.g., by a modal dialog.
+	* @param {double} deltaTime: time (in milliseconds) elapsed since the last frame.
+	* @returns {BoardMotion} motion of the drawn board.
+	*/
+	BoardMotion drawBoard(double deltaTime);
+	/*
+	* @brief Frees every OpenGL object of the game, i.e., shaders, grid-lines, orb mesh and buffers. Must be called on the render thread with the OpenGL context
+	* @brief being current, before the context is released. The next call to `drawBoard` creates them again.
 	*/
-	bool drawBoard(unsigned long deltaTime);
+	void releaseGraphics(void);
 	/**
 	* @brief Converts a 2D mouse coordinate to board coordinate.
 	* @param {double} mouseX: x-coordinate of the mouse position.
@@ -30,23 +56,50 @@ public:
 	* @returns {vec2} value of the board coordinate if the mouse position falls within the game board, {-1, -1} otherwise.
 	*/
 	glm::vec2 getBoardCoordinates(double mouseX, double mouseY);
+	/*
+	* @brief Looks up the moves of the opening book (see `openBook`) for the player who is to make the next move.
+	* @param {vector<BookMove>&} moves: receives the book moves, most played first.
+	* @returns {bool} true if the current position is in the book, false otherwise (or if no book is open).
+	*/
+	inline bool getBookMoves(std::vector<OpeningBook::BookMove>& moves) const { return this->_openingBook.findMoves(this->_engine, moves); }
+	/*
+	* @brief Returns the headless rules engine which holds the board state of the current game.
+	*/
+	inline const GameEngine& getEngine() const { return this->_engine; }
 	inline AppGUIFrame* getFrame() const { return this->_mainframe; }
 	inline glm::vec3 getGlCompatibleCoordinate(float radius, float latitudeDegree, float longitudeDegree) const { return glm::vec3({ radius * sin(glm::radians(longitudeDegree)) * cos(glm::radians(latitudeDegree)), radius * sin(glm::radians(latitudeDegree)), radius * cos(glm::radians(longitudeDegree)) * cos(glm::radians(latitudeDegree)) }); }
-	inline unsigned int getWinnerIndex() const { return this->_winnerIndex; }
-	inline const char* getWinnerName() const { return this->_winnerName.c_str(); }
+	inline unsigned int getWinnerIndex() const { return this->_engine.getWinnerIndex(); }
+	inline const char* getWinnerName() const { return this->getWinnerIndex() ? this->_playerColors[this->getWinnerIndex() - 1].c_str() : ""; }
 	inline bool isBlastAnimationRunning() const { return this->_blastAnimationRunning; }
 	/*
+	* @brief Checks whether or not the board has changed by a move, a resolved blast, undo, redo or reset since it was published last (see `publishBoard`).
+	* The orbs of a running blast are moved on by the render thread, hence the board does not need to be published in between.
+	*/
+	inline bool hasUnpublishedBoard() const { return this->_publishedBlastWave != this->_blastWave; }
+	/*
+	* @brief Checks whether or not the game must be updated at the full frame rate, i.e., while a blast is pending or a computer player is to move.
+	*/
+	inline bool isAnimating() const { return this->_engine.hasPendingBlast() || this->isComputerTurn(); }
+	/*
+	* @brief Checks whether or not the orbs on the board rotate. The board is empty (hence static) until the first move is made.
+	*/
+	inline bool hasMovingOrbs() const { return this->_engine.getTurn() > 0 && this->_ROTATION_SPEED > 0; }
+	/*
+	* @brief Checks whether or not the player who is to make the next move is controlled by the computer. Mouse inputs are ignored during such a turn.
+	*/
+	inline bool isComputerTurn() const { return !this->_engine.hasGameEnded() && this->_engine.getCurrentPlayer() < this->_computerPlayers.size() && this->_computerPlayers[this->_engine.getCurrentPlayer()]; }
+	/*
 	* @brief Checks whether or not a given player is eliminated from the game.
-	* @param {string} player: color of the player that is being searched for.
+	* @param {uint8_t} player: (0-based) id of the player that is being searched for.
 	* @returns {bool} true if player is eliminated, false otherwise.
 	*/
-	bool isEliminated(std::string player) const;
+	inline bool isEliminated(uint8_t player) const { return this->_engine.isEliminated(player); }
 	/*
 	* @brief Checks whether or not a given coordinate in the game board contains an explosive orb.
 	* @param {pair<uint32_t, uint32_t>} boardCoordinate: coordinate in the game board that is being tested.
 	* @returns {bool} true if the given boardCoordinate contains an explosive, false otherwise.
 	*/
-	bool isExplosive(std::pair<uint32_t, uint32_t> boardCoordinate) const;
+	inline bool isExplosive(std::pair<uint32_t, uint32_t> boardCoordinate) const { return this->_engine.isExplosive(boardCoordinate); }
 	/*
 	* @brief Default constructor for the game object.
 	* @param {const char*} soundSourceName: path to the audio source file. Supported audio formats are '.wav', '.aiff'.
@@ -71,6 +124,12 @@ public:
 	*/
 	~MainGame(void);
 	/*
+	* @brief Opens an opening book (see OpeningBook.h) for suggesting moves to the players. The book is memory-mapped, hence a lookup costs a single binary search.
+	* @param {string} path: path to the book file.
+	* @returns {bool} true if the book was opened, false otherwise.
+	*/
+	inline bool openBook(const std::string& path) { return this->_openingBook.open(path); }
+	/*
 	* @brief Processes players input in the game board. Inputs must be provided in the board coordinate system (lower-left square is (0,0). x-coordinate (y-coordinate) increases in the right (top) direction.
 	* @param {uint32_t} boardCoordinateX: x-coordinate of the input square in board coordinate system.
 	* @param {uint32_t} boardCoordinateY: y-coordinate of the input square in board coordiante system.
@@ -78,6 +137,15 @@ public:
 	*/
 	bool processPlayerInput(uint32_t boardCoordinateX, uint32_t boardCoordinateY);
 	/*
+	* @brief Hands the current board (i.e., orbs, grid color, camera and viewport) over to the render thread, which draws it with `drawBoard`. Must be called on the UI thread.
+	* @brief The board is copied into a lock-free triple buffer, hence neither thread waits for the other.
+	*/
+	void publishBoard(void);
+	/*
+	* @brief Redoes the last undone move and updates the game board accordingly.
+	*/
+	void redo(void);
+	/*
 	* @brief Resets state variables of the game object.
 	*/
 	void resetGameVariables(void);
@@ -94,49 +162,134 @@ public:
 	* @param {unsigned int} height: height of the canvas.
 	*/
 	void setCanvasSize(unsigned int width, unsigned int height);
+	/*
+	* @brief Selects which players are controlled by the computer. Must be called after `setAttribute`.
+	* @param {vector<PlayerType>} playerTypes: controller of each player in the order of play.
+	*/
+	void setComputerPlayers(const std::vector<GameUtilities::PlayerType>& playerTypes);
 	inline void setPixelScaling(double correctionFactor) {this->_pixelCorrectionFactor = correctionFactor;}
 	/**
 	* @brief Sets the frame object (which handles graphical user inputs) of the game instance.
 	* @param {AppGUIFrame*} frame: pointer to the frame object.
 	*/
 	void setFrame(AppGUIFrame* frame);
+	/*
+	* @brief Replaces the random number generator of the game, e.g., with a seeded one for reproducing the rendering of a replay.
+	* @brief It drives the rotation axes of the orbs and seeds the computer players created afterwards. The jitter of single orbs is drawn by the render thread from its own generator.
+	*/
+	inline void setRandomGenerator(const RandomGenerator& generator) { this->_random = generator; }
 	inline void setGridShaderVertexSource(std::string source) { this->_gridShaderVertexSource = source; }
 	inline void setGridShaderFragmentSource(std::string source) { this->_gridShaderFragmentSource = source; }
 	inline void setOrbShaderVertexSource(std::string source) { this->_orbShaderVertexSource = source; }
 	inline void setOrbShaderFragmentSource(std::string source) { this->_orbShaderFragmentSource = source; }
 	/*
 	* @brief Configures the camera settings, e.g., updates projection matrix, modelview matrix, camera position, eye direction etc.
+	* @brief The camera is handed over to the render thread with the next published board (see `publishBoard`).
 	*/
 	void setupCamera();
 	/*
-	* @brief Undos the move of the last player and updates the game board accordingly.
+	* @brief Starts recording every game in the binary game-record format. A game is appended to the record file once it ends (or is abandoned).
+	* @param {string} path: path to the record file. Games are appended if the file exists.
+	* @param {uint32_t} checkpointInterval: number of moves between two position checkpoints, 0 disables checkpoints.
+	* @returns {bool} true if the record file was opened, false otherwise.
+	*/
+	bool startRecording(const std::string& path, uint32_t checkpointInterval = 0);
+	/*
+	* @brief Stops recording games. The current game is written as abandoned.
+	*/
+	void stopRecording(void);
+	/*
+	* @brief Undos the move of the last player and updates the game board accordingly. Repeated calls undo the moves back to the start of the game.
 	*/
 	void undo(void);
 	/*
+	* @brief Advances the game (i.e., the blasts, if there are any) by the time elapsed since the last update. Must be called on the UI thread.
+	* The game is advanced in fixed steps of _ANIMATION_STEP, hence it does not depend on the frame rate.
+	* @param {double} deltaTime: time (in milliseconds) elapsed since the last update.
+	* @returns {bool} true if the current game has ended (i.e., all orbs in the board are of same color), false otherwise.
+	*/
+	bool updateBoard(double deltaTime);
+	/*
+	* @brief Drives the computer players. If the computer is to make the next move, a search is started on a worker thread; once it is finished, the move is applied.
+	* @brief Must be called regularly from the game loop. It never blocks the calling (UI) thread.
+	* @returns {bool} true if a move of the computer was applied, false otherwise.
+	*/
+	bool updateComputerPlayer(void);
+	/*
 	* @brief Updates the color of the gridlines and the player label in GUI in accordance with the current player.
 	*/
 	void updateTurn(void);
 private:
+	/*
+	* @brief GPU buffers of the grid-lines of one board dimension. They are generated when the dimension is played for the first time (see `_getGridGeometry`).
+	*/
+	typedef struct GridGeometry {
+		VertexArrayObject vao;
+		VertexBufferObject vbo;
+		IndexBufferObject ibo;
+	} GridGeometry;
+	/*
+	* @brief Orbs of an occupied board-cell in a published board.
+	*/
+	typedef struct OrbCell {
+		uint32_t cellIndex; //Index of the board-cell in the row-major board array.
+		uint8_t owner; //(0-based) id of the player owning the orbs.
+		uint8_t level; //Number of orbs.
+		bool isExplosive; //Whether or not the orbs are on their way to the neighbouring cells.
+		glm::vec3 rotationAxes;
+	} OrbCell;
+	/*
+	* @brief A board as published by the UI thread for the render thread (see `publishBoard`).
+	*/
+	typedef struct BoardState {
+		unsigned int numberOfRows = 0, numberOfColumns = 0;
+		std::vector<OrbCell> cells; //Occupied board-cells.
+		std::vector<glm::vec4> palette; //Maps player ids to orb colors.
+		glm::vec4 gridColor = { 0.0f, 1.0f, 0.0f, 1.0f }; //Color of the front side grid-lines. The back side is drawn at half the brightness.
+		Shaders::FrameState frameState;
+		int viewport[2] = { 0, 0 }; //Size (in pixels) of the viewport.
+		double blastDisplacement = 0.0; //Displacement of the orbs of the pending blast at the time of publishing.
+		double blastSpeed = 0.0; //Speed (in units per millisecond) of the orbs of the pending blast, 0 if there is none.
+		uint64_t blastWave = 0; //Id of the blast wave, i.e., of the exploding board-cells. The orbs of a wave are uploaded to the GPU once.
+		bool isRotating = false;
+		std::chrono::steady_clock::time_point time; //Time of publishing.
+	} BoardState;
+
 	//*********************** Declaration of private member variables *************************
-	double _angleOfRotation;
+	static constexpr double _ANIMATION_STEP = 1000.0 / 240.0; //Fixed time step (in milliseconds) by which the animation is advanced.
+	double _angleOfRotation = 0.0; //Rotation (in degree) of the orbs. Only used by the render thread.
 	ALuint _audioID, _audioSourceID;
-	bool _areShadersInitialized = false;
-	std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue> _BOARD;
+	bool _areShadersInitialized = false; //Whether or not the shaders of the board are compiled. Only used by the render thread.
 	bool _blastAnimationRunning;
 	double _blastDisplacement;
+	VertexBufferObject _blastInstanceBuffer; //Per-instance attributes of the orbs of the loaded blast wave. Only used by the render thread.
+	uint32_t _blastInstanceCount = 0; //Number of orbs of the loaded blast wave. Only used by the render thread.
+	uint64_t _blastWave = 0; //Id of the current blast wave. It changes whenever the board changes by a move, a resolved blast, undo, redo or reset.
 	double _BLAST_TIME;
+	double _cameraDistance; //Distance between the camera and its target from which a board of up to 10 rows is fitted into the view. Larger boards move the camera away.
 	glm::vec3 _cameraPosition = {0.0f, 0.0f, 0.0f};
 	glm::vec3 _cameraTarget = { 0.0f, 0.0f, 1.0f };
 	glm::vec3 _cameraUp = { 0.0f, 1.0f, 0.0f };
 	unsigned int _COL_DIV;
 	static const std::unordered_map<std::string, glm::vec4> _colorMap;
+	static const size_t _PALETTE_SIZE = 8; //Number of orb colors the orb shader can hold (see uniform `palette`).
+	uint32_t _COMPUTER_TIME_BUDGET = 1000; //Time budget (in milliseconds) of a single move of a computer player.
+	std::vector<std::unique_ptr<ComputerPlayer>> _computerPlayers; //Computer player of each player id, or null for human players.
+	uint32_t _checkpointInterval = 0; //Number of moves between two position checkpoints in the game record.
+	std::future<uint32_t> _computerSearch; //Result (i.e., cell index) of the running search of a computer player. UINT32_MAX indicates that no move was found.
+	uint64_t _computerSearchHash = 0; //Hash of the position in which the running search was started. A result for any other position is discarded.
+	TripleBuffer<BoardState> _boardStates; //Boards handed over from the UI thread to the render thread.
 	unsigned int _CUBE_WIDTH;
-	std::unordered_map<GameUtilities::BoardKey, uint32_t> _currentAllNeighbours;
-	std::vector<std::pair<GameUtilities::BoardKey, GameUtilities::BoardValue>> _currentBombs;
 	unsigned int _DISPLAY[2]; //Stores the current dimension of the OpenGL canvas.
-	std::vector<std::string> _eliminated; //Stores the colors (in lowercase) of the elminiated players.
-	bool _gameHasEnded = false;
-	IndexBufferObject _GRID_IBO_ID[5][5]; //Stores index_buffer_object for (row, col) grid data. Row and col range from 6 to 10, index 0 maps to 6.
+	GameEngine _engine; //Headless rules engine holding the board state and the turn of the current game.
+	Shaders::FrameState _frameState; //Camera and light of the game board, shared by the grid and orb shaders. It is published with the board.
+	UniformBufferObject _frameStateBuffer; //Uniform buffer holding the camera and light of the drawn board.
+	uint64_t _gameSeed = 0; //Seed of the computer players of the current game. It is stored in the game record.
+	size_t _GRID_CACHE_SIZE = 4; //Maximum number of board dimensions whose grid data is kept on the GPU. The least recently used one is freed first.
+	std::list<std::pair<GameUtilities::BoardKey, std::unique_ptr<GridGeometry>>> _gridGeometryCache; //Grid data of the recently played board dimensions, most recently used first.
+	std::unordered_map<GameUtilities::BoardKey, std::list<std::pair<GameUtilities::BoardKey, std::unique_ptr<GridGeometry>>>::iterator> _gridGeometryIndex; //Maps a board dimension (see `_boardKey`) to its entry in _gridGeometryCache.
+	Shaders::Uniform _gridBacksideColor, _gridFrontsideColor; //Uniforms of the grid shader, resolved whenever it is compiled.
+	glm::vec4 _gridColor; //Color of the grid-lines, i.e., color of the player who is to make the next move.
 	//Default fragment shader for rendering grid lines in the game board.
 	std::string _gridShaderFragmentSource = "#version 400\r\n"
 		"in vec4 fragmentColor;\r\n"
@@ -154,15 +307,18 @@ private:
 		"layout(location = 2) in vec2 texCoord;\r\n"
 		"layout(location = 3) in vec4 vertexColor;\r\n"
 		"out vec4 fragmentColor;\r\n"
-		"uniform mat4 transform;\r\n"
+		"layout(std140) uniform FrameState {\r\n" //Per-frame state, see Shaders::FrameState.
+		"	mat4 projectionView;\r\n"
+		"	vec3 cameraPosition;\r\n"
+		"	vec3 lightDirection;\r\n"
+		"};\r\n"
 		"void main() {\r\n"
-		"	gl_Position = transform * vec4(vertexPosition, 1.0);\r\n"
+		"	gl_Position = projectionView * vec4(vertexPosition, 1.0);\r\n"
 		"	fragmentColor = vertexColor;\r\n"
 		"}";
-	std::unordered_map<GameUtilities::BoardKey, VertexArrayObject*> _GRID_VAO_ID; //Stores vao_id for (row x column) grid data. Row and column range from 6 to 10, index 0 maps to 6.
-	VertexBufferObject _GRID_VBO_ID[5][5]; //Stores vertex_buffer_object for (row, col) grid data. Row and col range from 6 to 10, index 0 maps to 6.
 	float _lightDirLatitude = 0.0f;
 	float _lightDirLongitude = 0.0f;
+	uint64_t _loadedBlastWave = UINT64_MAX; //Id of the blast wave whose orbs are in _blastInstanceBuffer. Only used by the render thread.
 	double _lowerleft[2];
 	AppGUIFrame* _mainframe = nullptr;
 	glm::mat4 _modelview; //Stores the current modelview matrix.
@@ -171,12 +327,15 @@ private:
 		"in vec3 normalWorld;\r\n"
 		"in vec4 vPosition;\r\n"
 		"out vec4 outputColor;\r\n"
-		"uniform vec3 cameraPosition;\r\n" //Current camera position
-		"uniform vec4 orbColor;\r\n"
+		"in vec4 orbColor;\r\n"
+		"layout(std140) uniform FrameState {\r\n" //Per-frame state, see Shaders::FrameState.
+		"	mat4 projectionView;\r\n"
+		"	vec3 cameraPosition;\r\n"
+		"	vec3 lightDirection;\r\n"
+		"};\r\n"
 		"uniform vec3 vDiffuse;\r\n" //diffusive color property specification.
 		"uniform vec3 vSpecular;\r\n" //specular color property specification.
 		"uniform float vSpecularExponent;\r\n" //specular exponent property specification.
-		"uniform vec3 lightDirection;\r\n" //only considers directional light;
 		"void main(){\r\n"
 		"	vec3 viewDir = normalize(cameraPosition - vec3(vPosition.xyz));\r\n"
 		"	vec3 sunDir = normalize(lightDirection);\r\n"
@@ -188,77 +347,138 @@ private:
 		"	outputColor = vec4(color * brightness, 1.0f);\r\n"
 		"}";
 	Shaders _orbShaderProgram; //Compiled shader program that handles rendering of the orbs in the game.
+	Shaders::Uniform _orbBlastDisplacement; //Uniform `blastDisplacement` of the orb shader, resolved whenever it is compiled.
+	Shaders::Uniform _orbPalette; //Uniform `palette` of the orb shader, resolved whenever it is compiled.
 	//Default vertex shader for rendering grid orbs in the game board.
 	std::string _orbShaderVertexSource = "#version 400\r\n"
 		"layout(location = 0) in vec3 vertexPosition;\r\n"
 		"layout(location = 1) in vec3 vertexNormal;\r\n"
 		"layout(location = 2) in vec2 texCoord;\r\n" //Texture coordinates are not used for now.
 		"layout(location = 3) in vec4 vertexColor;\r\n"
+		"layout(location = 4) in vec3 instanceCenter;\r\n" //Per-instance attributes, see VertexStructure::OrbInstance.
+		"layout(location = 5) in vec4 instanceRotation;\r\n"
+		"layout(location = 6) in float instanceColorIndex;\r\n"
+		"layout(location = 7) in vec2 instanceDirection;\r\n"
 		"out vec3 normalWorld;\r\n"
 		"out vec4 vPosition;\r\n"
-		"uniform mat4 projectionView;\r\n"
-		"uniform mat4 modelTransform;\r\n"
+		"out vec4 orbColor;\r\n"
+		"layout(std140) uniform FrameState {\r\n" //Per-frame state, see Shaders::FrameState.
+		"	mat4 projectionView;\r\n"
+		"	vec3 cameraPosition;\r\n"
+		"	vec3 lightDirection;\r\n"
+		"};\r\n"
+		"uniform vec4 palette[8];\r\n" //Orb color of each player.
+		"uniform float blastDisplacement;\r\n" //Distance which the orbs of the blast wave have travelled.
 		"void main() {\r\n"
-		"	vPosition = modelTransform * vec4(vertexPosition, 1.0);\r\n"
+		"	vec3 axis = normalize(instanceRotation.xyz);\r\n" //Rotation about the axis by the angle (Rodrigues' formula).
+		"	float c = cos(instanceRotation.w);\r\n"
+		"	float s = sin(instanceRotation.w);\r\n"
+		"	mat3 rotation = mat3(c) + (1.0 - c) * outerProduct(axis, axis) + s * mat3(0.0, axis.z, -axis.y, -axis.z, 0.0, axis.x, axis.y, -axis.x, 0.0);\r\n"
+		"	vPosition = vec4(rotation * vertexPosition + instanceCenter + vec3(blastDisplacement * instanceDirection, 0.0), 1.0);\r\n"
 		"	gl_Position = projectionView * vPosition;\r\n"
-		"	normalWorld = normalize(vec3(modelTransform * vec4(vertexNormal, 0)));\r\n"
+		"	normalWorld = normalize(rotation * vertexNormal);\r\n"
+		"	orbColor = palette[int(instanceColorIndex)];\r\n"
 		"}";
+	std::vector<VertexStructure::OrbInstance> _orbInstances[3]; //Orbs of the frame being drawn, grouped by level (i.e., index 0 holds the single orbs).
+	VertexBufferObject _orbInstanceBuffer; //Per-instance attributes of the orbs of the frame being drawn.
+	VertexLayout _orbInstanceLayout; //Layout of VertexStructure::OrbInstance.
+	BookReader _openingBook; //Opening book of the move hints. It is empty unless opened with `openBook`.
+	std::vector<glm::vec4> _loadedPalette; //Orb colors which are loaded in the palette of the orb shader. Only used by the render thread.
+	std::vector<glm::vec4> _palette; //Maps player ids to orb colors. Only used for rendering.
+	double _pendingAnimationTime = 0.0; //Time (in milliseconds) elapsed but not yet simulated by the animation, as it is less than _ANIMATION_STEP.
 	double _pixelCorrectionFactor = 1.0;
-	std::vector<std::string> _players; //List of colors (in lowercase) of the current players.
+	uint64_t _publishedBlastWave = UINT64_MAX; //Id of the blast wave of the board published last. Only used by the UI thread.
+	std::vector<std::string> _playerColors; //Maps player ids to color names (in lowercase). Only used by the GUI.
+	std::vector<GameUtilities::PlayerType> _playerTypes; //Controller of each player id, as selected with `setComputerPlayers`.
 	glm::mat4 _projection; //Stores the current projection (i.e., perspective) matrix.
+	RandomGenerator _random; //Random number generator of the game. It is seeded from the current time unless replaced with `setRandomGenerator`.
+	RandomGenerator _renderRandom; //Random number generator of the render thread, which drives the jitter of single orbs.
+	GameRecordWriter _recordWriter; //Records the moves of the current game if recording is enabled with `startRecording`.
+	std::vector<glm::vec3> _rotationAxes; //Stores the (render only) rotation axes of the orbs in each board-cell. It is parallel to the row-major board array of the engine; a zero vector indicates that no axes have been generated yet.
 	unsigned int _ROTATION_SPEED, _ROW_DIV;
 	//UvSphere _sphere;
 	IcoSphere _sphere;
 	const MeshData* _sphereMeshData;
-	unsigned int _turn;
-	std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue> _undoBoard; //Stores the game-board configuration before the last input.
-	std::vector<std::string> _undoEliminated; //Stores the list of (colors in lowercase) players that were eliminated before the last input.
-	unsigned int _undoTurn; //Stores the value of the turn variable before the last input.
-	unsigned int _winnerIndex = 0;
-	std::string _winnerName = "";
 
 	//******************************************* Private Method declaraction ******************************
 	void _applyGridShaderSettings(void);
 	void _applyOrbShaderSettings(void);
 	/*
+	* @brief Starts the record of the current game, unless recording is disabled or a record is already running.
+	*/
+	void _beginRecord(void);
+	/*
 	* @brief Cantor pairing function to map (injectively) two 32 bit positive intergers to a single 64 bit positive integer.
-	* @brief It can be used as a hash function to encode two positive integers into a single positive integer.
-	* @see MainGame::_inverseKey.
 	* @param {unsigned int} i, j : input value of the two positive integers.
 	* @returns {unsigned long long} output value obtained from Cantor pairing.
 	*/
 	inline uint64_t _boardKey(uint32_t i, uint32_t j) const { return (uint64_t)(0.5 * (i + j) * (i + j + 1) + j); }
 	static std::unordered_map<std::string, glm::vec4> _createColorMap();
 	void _createGridData(unsigned int numberOfRows, unsigned int numberOfColumns, VertexArrayObject* vao, VertexBufferObject* vbo, IndexBufferObject* ibo, unsigned int cubeWidth, unsigned int centerX = 0, unsigned int centerY = 0);
-	void _drawGrid();
-	void _drawOrb(glm::vec3 center, glm::vec3 axes, double angleOfRotation, unsigned int level, const char* colorName);
-	void _eliminatePlayers(bool updateTurnVariable);
+	/*
+	* @brief Draws the grid-lines of a published board.
+	* @param {const BoardState&} board: published board.
+	*/
+	void _drawGrid(const BoardState& board);
+	/*
+	* @brief Adds the orbs of a board-cell to the orbs of the frame being drawn. They are drawn by `_drawOrbs`.
+	* @param {vec3} center: center of the board-cell. Single orbs jitter around it.
+	* @param {vec3} axes, {double} angleOfRotation: rotation of a group of 2 or 3 orbs.
+	* @param {unsigned int} level: number of orbs (1 to 3).
+	* @param {uint8_t} player: (0-based) id of the player owning the orbs.
+	*/
+	void _addOrb(glm::vec3 center, glm::vec3 axes, double angleOfRotation, unsigned int level, uint8_t player);
+	/*
+	* @brief Draws the orbs added by `_addOrb` with one instanced draw call per level, then clears them. The orbs of the loaded blast wave are drawn with one more call.
+	* @param {const vector<vec4>&} palette: orb colors of the players. They are loaded in the orb shader if they have changed.
+	* @param {double} blastDisplacement: distance which the orbs of the blast wave have travelled.
+	*/
+	void _drawOrbs(const std::vector<glm::vec4>& palette, double blastDisplacement);
+	/*
+	* @brief Finishes the record of the current game (if any) and appends it to the record file. A game that has not ended is recorded as abandoned.
+	*/
+	void _endRecord(void);
+	/*
+	* @brief Returns the rotation axes of the orbs in a board-cell. The axes are randomly generated when a cell is drawn for the first time.
+	* @param {uint32_t} cellIndex: index of the board-cell in the row-major board array.
+	* @returns {vec3} rotation axes of the orbs in the board-cell.
+	*/
+	const glm::vec3& _getRotationAxes(uint32_t cellIndex);
+	/*
+	* @brief Returns the grid-lines of a board dimension. They are generated on first use and cached; once more than _GRID_CACHE_SIZE dimensions are cached, the grid-lines of the least recently used one are freed.
+	* @param {unsigned int} numberOfRows, numberOfColumns: board dimension.
+	* @returns {VertexArrayObject*} vertex array object of the grid-lines.
+	*/
+	VertexArrayObject* _getGridGeometry(unsigned int numberOfRows, unsigned int numberOfColumns);
+	/*
+	* @brief Returns the size (in pixels) of the viewport of the board, i.e., of the canvas.
+	* @param[out] {int&} width, height: receive the size of the viewport.
+	*/
+	inline void _getViewportSize(int& width, int& height) const { width = (int) this->_pixelCorrectionFactor * this->_DISPLAY[0]; height = (int) this->_pixelCorrectionFactor * this->_DISPLAY[1]; }
 	void _getWorldCoordinates(double x, double y, double& worldCoordinateX, double& worldCoordinateY, double& worldCoordinateZ);
-	std::set<std::pair<uint32_t, uint32_t> > _getNeighbours(uint32_t boardCoordinateX, uint32_t boardCoordinateY);
-	std::vector<std::pair<GameUtilities::BoardKey, GameUtilities::BoardValue>> _getBombs(const std::unordered_map<GameUtilities::BoardKey, GameUtilities::BoardValue>& board);
-	std::unordered_map<GameUtilities::BoardKey, uint32_t> _getBombNeighbours();
 	void _initDefaults(void);
-	/**
-	* @brief Inverse of the Cantor pairing function to map (injectively) a single 64 bit positive integer to two 32 bit positive intergers.
-	* @see MainGame::_boardKey
-	* @param {unsigned int} key : input value of the 64 bit positive integer.
-	* @returns {pair<unsigned long long, unsigned long long>} output value obtained from inverse Cantor pairing.
-	*/
-	inline std::pair<uint32_t, uint32_t> _inverseKey(uint64_t key) const {
-		const auto w = floor(0.5 * (sqrt(8 * key + 1) - 1));
-		const auto t = 0.5 * (w + 1) * w;
-		const uint32_t y = key - t;
-		const uint32_t x = w - y;
-		return std::make_pair(x, y);
-	}
-	/**
-	* @brief Performs animation of an explosion if there are any.
-	* @param {unsigned long} delta_t: average time (in miliseconds) taken to render each frame.
-	* @returns {bool} true if the current game has ended (i.e., all orbs in the board are of same color) due to the explosion, false otherwise.
+	/*
+	* @brief Uploads the orbs of the exploding board-cells of a published board to _blastInstanceBuffer: one orb per neighbouring cell, which flies in its direction.
+	* @brief It is called once per blast wave; the orbs are then moved by the orb shader, hence a frame costs the same for any number of exploding cells.
+	* @param {const BoardState&} board: published board.
+	*/
+	void _loadBlastWave(const BoardState& board);
+	/*
+	* @brief Draws the grid and the orbs of a published board. Orbs of the exploding board-cells are drawn on their way to the neighbouring cells (see `_loadBlastWave`).
+	* @param {const BoardState&} board: published board.
+	* @param {double} blastDisplacement: displacement of the orbs of the exploding board-cells.
+	*/
+	void _renderBoard(const BoardState& board, double blastDisplacement);
+	/*
+	* @brief Aborts the running search of a computer player (if any) and waits for its worker thread to finish.
+	*/
+	void _stopComputerSearch(void);
+	/*
+	* @brief Advances the animation by one time step: moves the orbs of a pending blast, and resolves the blast once they reach the neighbouring cells.
+	* @param {double} timeStep: time step (in milliseconds).
+	* @returns {bool} true if the current game has ended due to a blast, false otherwise.
 	*/
-	bool _runBlastAnimation(unsigned long deltaTime);
-	void _setColorOfBacksideGrid(float colorR, float colorG, float colorB);
-	void _setColorOfFrontsideGrid(float colorR, float colorG, float colorB);
+	bool _updateAnimation(double timeStep);
 	/**
 	* @brief Adds an audio source at the origin in the 3D world and uploads the audio data specified by sourceName to the source for using in the game play.
 	* @param {const char*} sourceName: path to the audio data that is to be uploaded.
@@ -0,0 +1,80 @@
+#include "MappedFile.h"
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif //!NOMINMAX
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif //!WIN32_LEAN_AND_MEAN
+#include <Windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif //_WIN32
+
+//*************************************** Public methods ****************************************
+
+MappedFile::~MappedFile() {
+	this->close();
+}
+void MappedFile::close(void) {
+#if defined(_WIN32)
+	if (this->_data) UnmapViewOfFile(this->_data);
+	if (this->_mappingHandle) CloseHandle(this->_mappingHandle);
+	if (this->_fileHandle) CloseHandle(this->_fileHandle);
+	this->_mappingHandle = nullptr;
+	this->_fileHandle = nullptr;
+#else
+	if (this->_data) munmap((void*)this->_data, this->_size);
+#endif //_WIN32
+	this->_data = nullptr;
+	this->_size = 0;
+	this->_isOpen = false;
+}
+bool MappedFile::open(const std::string& path) {
+	this->close();
+#if defined(_WIN32)
+	HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) return false;
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(file, &size)) {
+		CloseHandle(file);
+		return false;
+	}
+	this->_fileHandle = file;
+	this->_size = (size_t)size.QuadPart;
+	//A file mapping of an empty file cannot be created.
+	if (this->_size) {
+		this->_mappingHandle = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (this->_mappingHandle) this->_data = (const uint8_t*)MapViewOfFile(this->_mappingHandle, FILE_MAP_READ, 0, 0, 0);
+		if (!this->_data) {
+			this->close();
+			return false;
+		}
+	}
+#else
+	const int file = ::open(path.c_str(), O_RDONLY);
+	if (file < 0) return false;
+	struct stat status;
+	if (fstat(file, &status) != 0) {
+		::close(file);
+		return false;
+	}
+	this->_size = (size_t)status.st_size;
+	//An empty file cannot be mapped. The mapping stays valid after the file descriptor is closed.
+	if (this->_size) {
+		void* data = mmap(nullptr, this->_size, PROT_READ, MAP_SHARED, file, 0);
+		if (data == MAP_FAILED) {
+			::close(file);
+			this->_size = 0;
+			return false;
+		}
+		this->_data = (const uint8_t*)data;
+	}
+	::close(file);
+#endif //_WIN32
+	this->_isOpen = true;
+	return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#ifndef MAPPED_FILE_H
+#define MAPPED_FILE_H
+
+/* Memory-mapped files are part of the headless engine library (they back the replay corpus) and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+*/
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+/*
+* @brief A read-only memory mapping of a whole file. Pages are loaded on demand by the operating system, hence files larger than the available RAM can be read
+* @brief as if they were in memory. Uses mmap on POSIX platforms and file mappings on Windows.
+*/
+class MappedFile {
+public:
+	MappedFile() = default;
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator=(const MappedFile&) = delete;
+	~MappedFile();
+	void close(void);
+	inline const uint8_t* getData() const { return this->_data; }
+	inline size_t getSize() const { return this->_size; }
+	inline bool isOpen() const { return this->_isOpen; }
+	/*
+	* @brief Maps a file into memory. A previously mapped file is unmapped.
+	* @param {string} path: path to the file.
+	* @returns {bool} true if the file was mapped (an empty file is mapped with a null data pointer), false otherwise.
+	*/
+	bool open(const std::string& path);
+private:
+	const uint8_t* _data = nullptr;
+	bool _isOpen = false;
+	size_t _size = 0;
+#if defined(_WIN32)
+	void* _fileHandle = nullptr;
+	void* _mappingHandle = nullptr;
+#endif //_WIN32
+};
+#endif //!MAPPED_FILE_H
@@ -0,0 +1,206 @@
+#include "MctsPlayer.h"
+#include <algorithm>
+#include <cmath>
+
+//*************************************** Public methods ****************************************
+
+MctsPlayer::MctsPlayer(unsigned int timeBudgetMilliseconds, unsigned int numberOfThreads, size_t treeBytes) {
+	this->_timeBudget = std::chrono::milliseconds(timeBudgetMilliseconds);
+	if (!numberOfThreads) numberOfThreads = std::max(1u, std::thread::hardware_concurrency());
+	this->_workers.resize(numberOfThreads);
+	const size_t nodesPerWorker = std::max<size_t>(1024, treeBytes / (sizeof(Node) * numberOfThreads));
+	for (auto& worker : this->_workers) worker.nodes.resize(nodesPerWorker);
+	this->seed(this->_random.next());
+	for (unsigned int i = 0; i < numberOfThreads; i++) this->_threads.emplace_back(&MctsPlayer::_workerLoop, this, i);
+}
+MctsPlayer::~MctsPlayer() {
+	{
+		std::lock_guard<std::mutex> lock(this->_mutex);
+		this->_shutdown = true;
+	}
+	this->_jobCondition.notify_all();
+	for (auto& thread : this->_threads) thread.join();
+}
+bool MctsPlayer::findMove(const GameEngine& game, uint32_t& cellIndex) {
+	this->_stopRequested.store(false, std::memory_order_relaxed);
+	this->_playoutCount = 0;
+	if (game.hasGameEnded() || game.hasPendingBlast()) return false;
+	//Hand the position over to the workers and wait until all of them are done.
+	{
+		std::unique_lock<std::mutex> lock(this->_mutex);
+		this->_rootPosition = &game;
+		this->_deadline = std::chrono::steady_clock::now() + this->_timeBudget;
+		this->_unfinishedWorkers = (unsigned int)this->_workers.size();
+		this->_jobGeneration++;
+		this->_jobCondition.notify_all();
+		this->_doneCondition.wait(lock, [this]() { return this->_unfinishedWorkers == 0; });
+		this->_rootPosition = nullptr;
+	}
+	//Sum the visit counts of the root moves over all trees. Every tree lists the root moves in the same (board) order.
+	const Worker& first = this->_workers[0];
+	const Node& firstRoot = first.nodes[0];
+	if (!firstRoot.isExpanded || !firstRoot.childCount) return false;
+	uint32_t bestMove = UINT32_MAX;
+	uint64_t bestVisits = 0;
+	for (uint32_t k = 0; k < firstRoot.childCount; k++) {
+		uint64_t visits = 0;
+		for (const auto& worker : this->_workers) {
+			if (worker.nodes[0].isExpanded) visits += worker.nodes[worker.nodes[0].firstChild + k].visits;
+		}
+		if (bestMove == UINT32_MAX || visits > bestVisits) {
+			bestVisits = visits;
+			bestMove = first.nodes[firstRoot.firstChild + k].move;
+		}
+	}
+	for (const auto& worker : this->_workers) this->_playoutCount += worker.playouts;
+	cellIndex = bestMove;
+	return true;
+}
+void MctsPlayer::seed(uint64_t value) {
+	this->_random.seed(value);
+	RandomGenerator generator = this->_random;
+	for (auto& worker : this->_workers) {
+		generator.jump();
+		worker.random = generator;
+	}
+}
+//******************************************* Private methods ************************************
+
+bool MctsPlayer::_expand(Worker& worker, uint32_t nodeIndex) {
+	MctsPlayer::_generateMoves(worker);
+	if (worker.nodeCount + worker.moves.size() > worker.nodes.size()) return false;
+	Node& node = worker.nodes[nodeIndex];
+	node.firstChild = worker.nodeCount;
+	node.childCount = (uint32_t)worker.moves.size();
+	node.isExpanded = true;
+	const uint8_t player = worker.game.getCurrentPlayer();
+	for (const auto& move : worker.moves) {
+		Node& child = worker.nodes[worker.nodeCount++];
+		child = Node();
+		child.move = move;
+		child.player = player;
+	}
+	return true;
+}
+void MctsPlayer::_generateMoves(Worker& worker) {
+	worker.moves.clear();
+	const uint32_t cellCount = (uint32_t)worker.game.getBoard().size();
+	for (uint32_t cellIndex = 0; cellIndex < cellCount; cellIndex++) {
+		if (worker.game.isLegalMove(cellIndex)) worker.moves.push_back(cellIndex);
+	}
+}
+void MctsPlayer::_playMove(GameEngine& game, uint32_t cellIndex) {
+	const uint32_t columns = game.getNumberOfColumns();
+	game.processPlayerInput(cellIndex % columns, cellIndex / columns);
+	game.resolveChainReaction();
+}
+void MctsPlayer::_search(Worker& worker) {
+	worker.game = *this->_rootPosition;
+	worker.nodes[0] = Node();
+	worker.nodeCount = 1;
+	worker.playouts = 0;
+	const uint32_t cellCount = (uint32_t)worker.game.getBoard().size();
+	worker.moves.reserve(cellCount);
+	//A playout that does not end within this many moves is decided by the number of orbs.
+	const uint32_t playoutLimit = 4 * cellCount;
+	worker.path.reserve(playoutLimit + cellCount);
+	if (!MctsPlayer::_expand(worker, 0)) return;
+	while (1) {
+		if ((worker.playouts & 15) == 0) {
+			if (this->_stopRequested.load(std::memory_order_relaxed) || std::chrono::steady_clock::now() >= this->_deadline) break;
+		}
+		if (this->_playoutLimit && worker.playouts >= this->_playoutLimit) break;
+		worker.path.clear();
+		worker.path.push_back(0);
+		uint32_t movesPlayed = 0;
+		uint32_t nodeIndex = 0;
+		//Selection: descend through the expanded nodes.
+		while (worker.nodes[nodeIndex].isExpanded && worker.nodes[nodeIndex].childCount && !worker.game.hasGameEnded()) {
+			nodeIndex = MctsPlayer::_selectChild(worker, nodeIndex);
+			MctsPlayer::_playMove(worker.game, worker.nodes[nodeIndex].move);
+			movesPlayed++;
+			worker.path.push_back(nodeIndex);
+		}
+		//Expansion: a leaf is expanded on its second visit, which keeps the trees small.
+		if (!worker.game.hasGameEnded() && worker.nodes[nodeIndex].visits && MctsPlayer::_expand(worker, nodeIndex)) {
+			const Node& node = worker.nodes[nodeIndex];
+			nodeIndex = node.firstChild + worker.random.below(node.childCount);
+			MctsPlayer::_playMove(worker.game, worker.nodes[nodeIndex].move);
+			movesPlayed++;
+			worker.path.push_back(nodeIndex);
+		}
+		//Playout: uniformly random moves until the game ends.
+		const uint8_t winner = MctsPlayer::_runPlayout(worker, playoutLimit);
+		//Backpropagation: every node is credited from the point of view of the player who made its move.
+		for (const auto& pathIndex : worker.path) {
+			Node& node = worker.nodes[pathIndex];
+			node.visits++;
+			if (node.player == winner) node.wins += 1.0f;
+		}
+		for (uint32_t i = 0; i < movesPlayed; i++) worker.game.undo();
+		worker.playouts++;
+	}
+}
+uint8_t MctsPlayer::_runPlayout(Worker& worker, uint32_t playoutLimit) {
+	GameEngine& game = worker.game;
+	uint8_t winner = 0;
+	//The bitboard playout draws the same random numbers and picks the same moves (legal moves in ascending cell order) as the engine playout.
+	if (worker.playout.loadPosition(game)) {
+		BitboardEngine& playout = worker.playout;
+		for (uint32_t playoutMoves = 0; !playout.hasGameEnded() && playoutMoves < playoutLimit; playoutMoves++) {
+			const Bitboard::Mask moves = playout.getLegalMoves();
+			playout.playMove(Bitboard::selectCell(moves, worker.random.below(Bitboard::popCount(moves))));
+		}
+		if (playout.hasGameEnded()) return (uint8_t)(playout.getWinnerIndex() - 1);
+		for (uint8_t player = 1; player < playout.getNumberOfPlayers(); player++) {
+			if (playout.getOrbCount(player) > playout.getOrbCount(winner)) winner = player;
+		}
+		return winner;
+	}
+	uint32_t playoutMoves = 0;
+	while (!game.hasGameEnded() && playoutMoves < playoutLimit) {
+		MctsPlayer::_generateMoves(worker);
+		MctsPlayer::_playMove(game, worker.moves[worker.random.below((uint32_t)worker.moves.size())]);
+		playoutMoves++;
+	}
+	if (game.hasGameEnded()) winner = (uint8_t)(game.getWinnerIndex() - 1);
+	else {
+		for (uint8_t player = 1; player < game.getNumberOfPlayers(); player++) {
+			if (game.getOrbCount(player) > game.getOrbCount(winner)) winner = player;
+		}
+	}
+	for (uint32_t i = 0; i < playoutMoves; i++) game.undo();
+	return winner;
+}
+uint32_t MctsPlayer::_selectChild(const Worker& worker, uint32_t nodeIndex) {
+	const Node& node = worker.nodes[nodeIndex];
+	const float logVisits = std::log((float)node.visits + 1.0f);
+	uint32_t bestChild = node.firstChild;
+	float bestValue = -1.0f;
+	for (uint32_t childIndex = node.firstChild; childIndex < node.firstChild + node.childCount; childIndex++) {
+		const Node& child = worker.nodes[childIndex];
+		if (!child.visits) return childIndex; //Unvisited children are tried first.
+		const float value = child.wins / child.visits + 1.2f * std::sqrt(logVisits / child.visits);
+		if (value > bestValue) {
+			bestValue = value;
+			bestChild = childIndex;
+		}
+	}
+	return bestChild;
+}
+void MctsPlayer::_workerLoop(unsigned int workerIndex) {
+	uint64_t lastGeneration = 0;
+	while (1) {
+		{
+			std::unique_lock<std::mutex> lock(this->_mutex);
+			this->_jobCondition.wait(lock, [this, lastGeneration]() { return this->_shutdown || this->_jobGeneration != lastGeneration; });
+			if (this->_shutdown) return;
+			lastGeneration = this->_jobGeneration;
+		}
+		this->_search(this->_workers[workerIndex]);
+		{
+			std::lock_guard<std::mutex> lock(this->_mutex);
+			if (!--this->_unfinishedWorkers) this->_doneCondition.notify_all();
+		}
+	}
+}
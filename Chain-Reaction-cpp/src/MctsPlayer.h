@@ -0,0 +1,119 @@
+#pragma once
+#ifndef MCTS_PLAYER_H
+#define MCTS_PLAYER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "BitboardEngine.h"
+#include "ComputerPlayer.h"
+
+/*
+* @brief A computer player based on Monte-Carlo tree search (UCT). Unlike alpha-beta search it handles any number of players without treating the opponents as a single team.
+* @brief The search is root parallel: every worker of a persistent thread pool grows its own tree from the current position, and the visit counts of the moves at the root are summed at the end.
+* @brief The workers share no mutable state during a search, so the number of playouts per second scales with the number of cores.
+* @brief Every worker owns a preallocated node pool, a copy of the engine (moves are undone after each playout) and its own random number generator, hence no memory is allocated per move.
+* @brief On boards supported by the bitboard engine (see BitboardEngine.h) the random playouts are run on a bitboard copy of the leaf position instead of the engine.
+*/
+class MctsPlayer : public ComputerPlayer {
+public:
+	/*
+	* @param {unsigned int} timeBudgetMilliseconds: time budget of a single search.
+	* @param {unsigned int} numberOfThreads: number of worker threads. If 0 is given, one worker per hardware thread is used.
+	* @param {size_t} treeBytes: upper bound of the memory used by the search trees of all workers together.
+	*/
+	MctsPlayer(unsigned int timeBudgetMilliseconds = 1000, unsigned int numberOfThreads = 0, size_t treeBytes = 64 * 1024 * 1024);
+	~MctsPlayer();
+	bool findMove(const GameEngine& game, uint32_t& cellIndex) override;
+	void seed(uint64_t value) override;
+	/*
+	* @brief Returns the number of playouts run by all workers during the last search.
+	*/
+	inline uint64_t getNodeCount() const override { return this->_playoutCount; }
+	inline unsigned int getNumberOfThreads() const { return (unsigned int)this->_workers.size(); }
+	/*
+	* @brief Limits the number of playouts of each worker per search. Value 0 (default) removes the limit, i.e., only the time budget applies.
+	*/
+	inline void setPlayoutLimit(uint64_t playoutsPerThread) { this->_playoutLimit = playoutsPerThread; }
+	inline void setTimeBudget(unsigned int timeBudgetMilliseconds) { this->_timeBudget = std::chrono::milliseconds(timeBudgetMilliseconds); }
+private:
+	/*
+	* @brief Node of a search tree. The children of a node are stored contiguously in the node pool of the worker.
+	* @brief Member variables:
+	* @brief	1. {uint32_t} move: cell index of the move leading to the node.
+	* @brief	2. {uint32_t} firstChild: index of the first child in the node pool.
+	* @brief	3. {uint32_t} visits: number of playouts through the node.
+	* @brief	4. {float} wins: number of playouts through the node won by the player who made the move.
+	* @brief	5. {uint32_t} childCount: number of children. Only meaningful if the node is expanded.
+	* @brief	6. {uint8_t} player: (0-based) id of the player who made the move.
+	* @brief	7. {bool} isExpanded: whether or not the children of the node have been created.
+	*/
+	typedef struct Node {
+		uint32_t move = UINT32_MAX;
+		uint32_t firstChild = 0;
+		uint32_t visits = 0;
+		float wins = 0.0f;
+		uint32_t childCount = 0; //A board of up to 1000 x 1000 cells has more legal moves than fit in 16 bits.
+		uint8_t player = 0;
+		bool isExpanded = false;
+	} Node;
+	/*
+	* @brief State owned by a single worker thread.
+	*/
+	typedef struct alignas(64) Worker { //Aligned to a cache line, so that workers do not share counters in a line.
+		GameEngine game; //Copy of the root position. Moves applied during an iteration are undone at its end.
+		BitboardEngine playout; //Position of the current playout, if the board is supported by the bitboard engine.
+		std::vector<Node> nodes; //Node pool; node 0 is the root.
+		uint32_t nodeCount = 0;
+		std::vector<uint32_t> moves; //Scratch buffer for the legal moves of a position.
+		std::vector<uint32_t> path; //Node indices visited by the current iteration.
+		RandomGenerator random; //Jumped ahead from the generator of the player, i.e., the workers draw non-overlapping sequences.
+		uint64_t playouts = 0;
+	} Worker;
+
+	std::condition_variable _doneCondition;
+	std::chrono::steady_clock::time_point _deadline;
+	std::condition_variable _jobCondition;
+	uint64_t _jobGeneration = 0; //Incremented for every search; workers wait for a change of this value.
+	std::mutex _mutex;
+	uint64_t _playoutCount = 0;
+	uint64_t _playoutLimit = 0;
+	const GameEngine* _rootPosition = nullptr;
+	bool _shutdown = false;
+	std::vector<std::thread> _threads;
+	std::chrono::milliseconds _timeBudget;
+	unsigned int _unfinishedWorkers = 0;
+	std::vector<Worker> _workers;
+
+	/*
+	* @brief Creates the children of a node for all legal moves of the current position. Returns false if the node pool is exhausted.
+	*/
+	static bool _expand(Worker& worker, uint32_t nodeIndex);
+	/*
+	* @brief Fills the scratch buffer of a worker with the legal moves of the current position.
+	*/
+	static void _generateMoves(Worker& worker);
+	static void _playMove(GameEngine& game, uint32_t cellIndex);
+	/*
+	* @brief Plays uniformly random moves from the current position of a worker until the game ends or the move limit is reached.
+	* @returns {uint8_t} (0-based) id of the winner, or of the player owning the most orbs if the game has not ended.
+	*/
+	static uint8_t _runPlayout(Worker& worker, uint32_t playoutLimit);
+	/*
+	* @brief Runs iterations (selection, expansion, playout, backpropagation) on the tree of a worker until the time budget is used up.
+	*/
+	void _search(Worker& worker);
+	/*
+	* @brief Chooses the child of a node with the highest upper confidence bound.
+	*/
+	static uint32_t _selectChild(const Worker& worker, uint32_t nodeIndex);
+	/*
+	* @brief Main loop of a worker thread. Waits for a search, runs it, and reports back.
+	*/
+	void _workerLoop(unsigned int workerIndex);
+};
+#endif //!MCTS_PLAYER_H
@@ -0,0 +1,145 @@
+#include "OpeningBook.h"
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include "BoardSymmetry.h"
+
+//*************************************** BookBuilder ****************************************
+
+BookBuilder::BookBuilder(unsigned int maxPly) {
+	this->_maxPly = maxPly;
+}
+bool BookBuilder::addGame(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers, const std::vector<uint32_t>& moves, unsigned int winnerIndex) {
+	if (!winnerIndex || winnerIndex > numberOfPlayers || (uint64_t)numberOfRows * numberOfColumns < numberOfPlayers) return false;
+	if (this->_engine.getNumberOfRows() != numberOfRows || this->_engine.getNumberOfColumns() != numberOfColumns || this->_engine.getNumberOfPlayers() != numberOfPlayers) {
+		this->_engine.setAttribute(numberOfRows, numberOfColumns, numberOfPlayers);
+	}
+	else this->_engine.resetGameVariables();
+	//Collect the moves of the opening first, so that a game with an illegal move leaves the statistics unchanged.
+	std::vector<OpeningBook::Entry> gameEntries;
+	for (uint32_t ply = 0; ply < moves.size() && ply < this->_maxPly; ply++) {
+		const uint32_t cellIndex = moves[ply];
+		if (!this->_engine.isLegalMove(cellIndex)) return false;
+		OpeningBook::Entry entry;
+		entry.cellIndex = BoardSymmetry::getCanonicalMove(this->_engine, cellIndex, entry.hash);
+		entry.games = 1;
+		entry.wins = (winnerIndex == this->_engine.getCurrentPlayerNumber()) ? 1 : 0;
+		entry.ply = ply;
+		gameEntries.push_back(entry);
+		this->_engine.processPlayerInput(cellIndex % numberOfColumns, cellIndex / numberOfColumns);
+		this->_engine.resolveChainReaction();
+	}
+	for (const auto& entry : gameEntries) this->_addEntry(entry);
+	this->_gameCount++;
+	return true;
+}
+uint64_t BookBuilder::addRecords(const uint8_t* data, size_t size) {
+	GameRecordReader reader;
+	reader.open(data, size);
+	uint64_t addedGames = 0;
+	std::vector<uint32_t> moves;
+	while (reader.nextGame()) {
+		moves.clear();
+		uint32_t cellIndex;
+		while (reader.nextMove(cellIndex)) moves.push_back(cellIndex);
+		if (reader.hasError()) break;
+		const auto& header = reader.getHeader();
+		if (header.playerTypes.size() < 2 || header.playerTypes.size() > UINT8_MAX) continue;
+		if (this->addGame(header.rows, header.columns, (uint8_t)header.playerTypes.size(), moves, reader.getWinnerIndex())) addedGames++;
+	}
+	return addedGames;
+}
+bool BookBuilder::load(const std::string& path) {
+	BookReader book;
+	if (!book.open(path)) return false;
+	for (uint64_t k = 0; k < book.getEntryCount(); k++) this->_addEntry(book.getEntries()[k]);
+	return true;
+}
+void BookBuilder::merge(const BookBuilder& other) {
+	for (const auto& entry : other._entries) this->_addEntry(entry.second);
+	this->_gameCount += other._gameCount;
+}
+bool BookBuilder::write(const std::string& path, uint32_t minGames) const {
+	std::vector<OpeningBook::Entry> table;
+	table.reserve(this->_entries.size());
+	for (const auto& entry : this->_entries) {
+		if (entry.second.games >= minGames) table.push_back(entry.second);
+	}
+	std::sort(table.begin(), table.end(), [](const OpeningBook::Entry& a, const OpeningBook::Entry& b) {
+		return a.hash != b.hash ? a.hash < b.hash : a.cellIndex < b.cellIndex;
+	});
+	OpeningBook::Header header;
+	std::memcpy(header.magic, OpeningBook::MAGIC, sizeof(header.magic));
+	header.version = OpeningBook::VERSION;
+	header.entryCount = table.size();
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	if (!file.is_open()) return false;
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)table.data(), (std::streamsize)(table.size() * sizeof(OpeningBook::Entry)));
+	return file.good();
+}
+//******************************************* Private methods ************************************
+
+void BookBuilder::_addEntry(const OpeningBook::Entry& entry) {
+	auto inserted = this->_entries.emplace(std::make_pair(entry.hash, entry.cellIndex), entry);
+	if (inserted.second) return;
+	auto& statistics = inserted.first->second;
+	statistics.games += entry.games;
+	statistics.wins += entry.wins;
+	statistics.ply = (std::min)(statistics.ply, entry.ply);
+}
+//*************************************** BookReader ****************************************
+
+void BookReader::close(void) {
+	this->_file.close();
+	this->_entries = nullptr;
+	this->_entryCount = 0;
+}
+std::pair<const OpeningBook::Entry*, const OpeningBook::Entry*> BookReader::findEntries(uint64_t hash) const {
+	const OpeningBook::Entry* begin = this->_entries;
+	const OpeningBook::Entry* end = this->_entries + this->_entryCount;
+	const OpeningBook::Entry* first = std::lower_bound(begin, end, hash, [](const OpeningBook::Entry& entry, uint64_t value) { return entry.hash < value; });
+	const OpeningBook::Entry* last = std::upper_bound(first, end, hash, [](uint64_t value, const OpeningBook::Entry& entry) { return value < entry.hash; });
+	return { first, last };
+}
+bool BookReader::findMove(const GameEngine& game, uint32_t& cellIndex) const {
+	std::vector<OpeningBook::BookMove> moves;
+	if (!this->findMoves(game, moves)) return false;
+	cellIndex = moves.front().cellIndex;
+	return true;
+}
+bool BookReader::findMoves(const GameEngine& game, std::vector<OpeningBook::BookMove>& moves) const {
+	moves.clear();
+	if (!this->_entryCount || game.hasGameEnded() || game.hasPendingBlast()) return false;
+	unsigned int symmetry;
+	const auto range = this->findEntries(BoardSymmetry::getCanonicalHash(game, symmetry));
+	for (const OpeningBook::Entry* entry = range.first; entry != range.second; entry++) {
+		const uint32_t cellIndex = BoardSymmetry::unmapCell(entry->cellIndex, game.getNumberOfRows(), game.getNumberOfColumns(), symmetry);
+		//Guards against a hash collision with a position of another configuration.
+		if (!game.isLegalMove(cellIndex)) continue;
+		moves.push_back({ cellIndex, entry->games, entry->wins });
+	}
+	std::sort(moves.begin(), moves.end(), [](const OpeningBook::BookMove& a, const OpeningBook::BookMove& b) {
+		if (a.games != b.games) return a.games > b.games;
+		return a.wins != b.wins ? a.wins > b.wins : a.cellIndex < b.cellIndex;
+	});
+	return !moves.empty();
+}
+bool BookReader::open(const std::string& path) {
+	this->close();
+	if (!this->_file.open(path)) return false;
+	OpeningBook::Header header;
+	const uint64_t fileSize = this->_file.getSize();
+	if (fileSize < sizeof(header)) {
+		this->close();
+		return false;
+	}
+	std::memcpy(&header, this->_file.getData(), sizeof(header));
+	if (std::memcmp(header.magic, OpeningBook::MAGIC, sizeof(header.magic)) || header.version != OpeningBook::VERSION || header.entryCount > fileSize || sizeof(header) + header.entryCount * sizeof(OpeningBook::Entry) != fileSize) {
+		this->close();
+		return false;
+	}
+	this->_entries = (const OpeningBook::Entry*)(this->_file.getData() + sizeof(header));
+	this->_entryCount = header.entryCount;
+	return true;
+}
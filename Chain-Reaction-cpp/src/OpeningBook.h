@@ -0,0 +1,160 @@
+#pragma once
+#ifndef OPENING_BOOK_H
+#define OPENING_BOOK_H
+
+/* The opening book is part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+ A book file holds the statistics of the moves played in the opening positions of many games:
+	1. Book header (see `Header`).
+	2. One entry (see `Entry`) per (position, move) pair, sorted by position hash and then by cell index.
+ Positions are keyed by the hash of their canonical image (see BoardSymmetry.h) and moves by their cell in that image, hence the 4 mirror images
+ of a position (8 images on a square board) share their entries. The hash includes the board dimension and the number of players, so that a single book can hold several configurations.
+ The book is memory-mapped for lookups: finding the moves of a position is a single binary search in the table. Numbers are stored in the byte order of
+ the machine (little endian on every supported platform).
+*/
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "GameEngine.h"
+#include "GameRecord.h"
+#include "MappedFile.h"
+
+namespace OpeningBook {
+	const uint8_t MAGIC[4] = { 'C', 'R', 'B', 'K' };
+	const uint32_t VERSION = 2; //Version 2 folds the rotations and diagonal mirrors of square boards as well.
+	/*
+	* @brief Header of a book file.
+	* @brief Member variables:
+	* @brief	1. {uint8_t[4]} magic: "CRBK".
+	* @brief	2. {uint32_t} version: format version of the book.
+	* @brief	3. {uint64_t} entryCount: number of entries in the table.
+	*/
+	typedef struct Header {
+		uint8_t magic[4];
+		uint32_t version;
+		uint64_t entryCount;
+	} Header;
+	/*
+	* @brief Statistics of a move played in a position.
+	* @brief Member variables:
+	* @brief	1. {uint64_t} hash: hash of the canonical image of the position (see `BoardSymmetry::getCanonicalHash`).
+	* @brief	2. {uint32_t} cellIndex: cell index of the move in the canonical image.
+	* @brief	3. {uint32_t} games: number of finished games in which the move was played.
+	* @brief	4. {uint32_t} wins: number of those games won by the player who made the move.
+	* @brief	5. {uint32_t} ply: smallest number of moves after which the position was reached.
+	*/
+	typedef struct Entry {
+		uint64_t hash;
+		uint32_t cellIndex;
+		uint32_t games;
+		uint32_t wins;
+		uint32_t ply;
+	} Entry;
+	/*
+	* @brief A move suggested by the book for the current position.
+	* @brief Member variables:
+	* @brief	1. {uint32_t} cellIndex: index of the board-cell of the move in the current position (i.e., mapped back from the canonical image).
+	* @brief	2. {uint32_t} games: number of games in which the move was played.
+	* @brief	3. {uint32_t} wins: number of those games won by the player who made the move.
+	*/
+	typedef struct BookMove {
+		uint32_t cellIndex;
+		uint32_t games;
+		uint32_t wins;
+	} BookMove;
+}
+/*
+* @brief Collects move statistics from finished games and writes them as a book file. The statistics are kept in memory until `write` is called.
+*/
+class BookBuilder {
+public:
+	/*
+	* @param {unsigned int} maxPly: only the positions reached within this many moves from the start of a game are collected.
+	*/
+	BookBuilder(unsigned int maxPly = 16);
+	/*
+	* @brief Adds the opening of a finished game. Abandoned games (winnerIndex 0) do not count.
+	* @param {unsigned int} numberOfRows, numberOfColumns: board dimension of the game.
+	* @param {uint8_t} numberOfPlayers: number of players of the game.
+	* @param {vector<uint32_t>} moves: cell indices of the moves in the order of play.
+	* @param {unsigned int} winnerIndex: (1-based) index of the winner of the game.
+	* @returns {bool} true if the game was added, false if it was abandoned or contains an illegal move.
+	*/
+	bool addGame(unsigned int numberOfRows, unsigned int numberOfColumns, uint8_t numberOfPlayers, const std::vector<uint32_t>& moves, unsigned int winnerIndex);
+	/*
+	* @brief Adds every finished game of a buffer in the binary game-record format (e.g., the records of the GUI or of the tournament runner).
+	* @returns {uint64_t} number of games that were added.
+	*/
+	uint64_t addRecords(const uint8_t* data, size_t size);
+	inline uint64_t getGameCount() const { return this->_gameCount; }
+	inline size_t getEntryCount() const { return this->_entries.size(); }
+	/*
+	* @brief Adds the entries of an existing book file, e.g., for extending a book with more games.
+	* @returns {bool} true if the book was read, false otherwise.
+	*/
+	bool load(const std::string& path);
+	/*
+	* @brief Adds the statistics collected by another builder, e.g., by a builder of another worker thread.
+	*/
+	void merge(const BookBuilder& other);
+	/*
+	* @brief Writes the collected statistics as a book file. The file is overwritten.
+	* @param {string} path: path to the book file.
+	* @param {uint32_t} minGames: moves played in fewer games are left out of the book.
+	* @returns {bool} true if the book was written, false otherwise.
+	*/
+	bool write(const std::string& path, uint32_t minGames = 1) const;
+private:
+	/*
+	* @brief Hash functor of the (position hash, cell index) keys.
+	*/
+	typedef struct KeyHash {
+		inline size_t operator()(const std::pair<uint64_t, uint32_t>& key) const { return (size_t)(key.first ^ ((uint64_t)key.second * 0x9E3779B97F4A7C15ULL)); }
+	} KeyHash;
+	GameEngine _engine; //Engine used for replaying the games.
+	std::unordered_map<std::pair<uint64_t, uint32_t>, OpeningBook::Entry, KeyHash> _entries; //Maps (canonical hash, canonical cell) to the statistics of the move.
+	uint64_t _gameCount = 0;
+	unsigned int _maxPly;
+
+	void _addEntry(const OpeningBook::Entry& entry);
+};
+/*
+* @brief Looks up the moves of a position in a book file. The book is memory-mapped, hence opening it costs nothing and a lookup is a single binary search.
+*/
+class BookReader {
+public:
+	BookReader() = default;
+	void close(void);
+	/*
+	* @brief Returns the entries of a canonical position hash, sorted by cell index.
+	*/
+	std::pair<const OpeningBook::Entry*, const OpeningBook::Entry*> findEntries(uint64_t hash) const;
+	/*
+	* @brief Finds the most played book move of the current position.
+	* @returns {bool} true if the position is in the book, false otherwise.
+	*/
+	bool findMove(const GameEngine& game, uint32_t& cellIndex) const;
+	/*
+	* @brief Finds the book moves of the current position, ordered by the number of games (most played first).
+	* @param {const GameEngine&} game: the position. The player who is to make the next move is the one the moves are suggested for.
+	* @param {vector<BookMove>&} moves: receives the moves in the coordinates of the given position.
+	* @returns {bool} true if the position is in the book, false otherwise.
+	*/
+	bool findMoves(const GameEngine& game, std::vector<OpeningBook::BookMove>& moves) const;
+	/*
+	* @brief Returns the table of the book, i.e., `getEntryCount` entries sorted by position hash and cell index.
+	*/
+	inline const OpeningBook::Entry* getEntries() const { return this->_entries; }
+	inline uint64_t getEntryCount() const { return this->_entryCount; }
+	inline bool isOpen() const { return this->_file.isOpen(); }
+	/*
+	* @brief Maps a book file into memory. A previously opened book is closed.
+	* @returns {bool} true if the file is a valid book, false otherwise.
+	*/
+	bool open(const std::string& path);
+private:
+	const OpeningBook::Entry* _entries = nullptr;
+	uint64_t _entryCount = 0;
+	MappedFile _file;
+};
+#endif //!OPENING_BOOK_H
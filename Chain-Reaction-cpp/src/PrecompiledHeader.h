@@ -42,6 +42,10 @@
 #include <vector>
 #endif //!_VECTOR_
 
+#ifndef _LIST_
+#include <list>
+#endif //!_LIST_
+
 #ifndef _UNORDERED_MAP_
 #include <unordered_map>
 #endif //!_UNORDERED_MAP_
@@ -56,6 +60,36 @@
 #define _ALGORITHM_
 #endif //!_ALGORITHM_
 
+#ifndef _FUTURE_
+#include <future>
+#define _FUTURE_
+#endif //!_FUTURE_
+
+#ifndef _CHRONO_
+#include <chrono>
+#define _CHRONO_
+#endif //!_CHRONO_
+
+#ifndef _THREAD_
+#include <thread>
+#define _THREAD_
+#endif //!_THREAD_
+
+#ifndef _ATOMIC_
+#include <atomic>
+#define _ATOMIC_
+#endif //!_ATOMIC_
+
+#ifndef _SEMAPHORE_
+#include <semaphore>
+#define _SEMAPHORE_
+#endif //!_SEMAPHORE_
+
+#ifndef _MEMORY_
+#include <memory>
+#define _MEMORY_
+#endif //!_MEMORY_
+
 #ifndef _CTIME_
 #include <ctime>
 #define _CTIME_
@@ -144,11 +178,21 @@
 #include <wx/sound.h>
 #endif //!WX_SOUND_H
 
+#ifndef WX_SPINCTRL_H
+#include <wx/spinctrl.h>
+#define WX_SPINCTRL_H
+#endif //!WX_SPINCTRL_H
+
 #ifndef WX_PROGDLG_H
 #include <wx/progdlg.h>
 #define WX_PROGDLG_H
 #endif //!WX_PROGDLG_H
 
+#ifndef WX_STDPATHS_H
+#include <wx/stdpaths.h>
+#define WX_STDPATHS_H
+#endif //!WX_STDPATHS_H
+
 #endif //!WX_PREC_H
 #if defined (_WIN32) //include windows header only in windows environment.
 #ifndef WINDOWS_H
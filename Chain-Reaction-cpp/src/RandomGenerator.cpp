@@ -0,0 +1,29 @@
+#include "RandomGenerator.h"
+#include <chrono>
+
+//*************************************** Public methods ****************************************
+
+RandomGenerator::RandomGenerator() {
+	this->seed((uint64_t)std::chrono::high_resolution_clock::now().time_since_epoch().count());
+}
+void RandomGenerator::jump(void) {
+	static const uint64_t JUMP[] = { 0x180EC6D33CFD0ABAULL, 0xD5A61266F0C9392CULL, 0xA9582618E03FC9AAULL, 0x39ABDC4529B1661CULL };
+	uint64_t state[4] = { 0, 0, 0, 0 };
+	for (const auto& word : JUMP) {
+		for (int bit = 0; bit < 64; bit++) {
+			if (word & (1ULL << bit)) {
+				for (int i = 0; i < 4; i++) state[i] ^= this->_state[i];
+			}
+			this->next();
+		}
+	}
+	for (int i = 0; i < 4; i++) this->_state[i] = state[i];
+}
+void RandomGenerator::seed(uint64_t value) {
+	for (int i = 0; i < 4; i++) {
+		uint64_t z = (value += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		this->_state[i] = z ^ (z >> 31);
+	}
+}
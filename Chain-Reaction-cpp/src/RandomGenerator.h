@@ -0,0 +1,62 @@
+#pragma once
+#ifndef RANDOM_GENERATOR_H
+#define RANDOM_GENERATOR_H
+
+/* The random number generator is part of the headless engine library (it is used by the computer players) and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+*/
+#include <cstdint>
+#include <limits>
+
+/*
+* @brief A seedable pseudo random number generator (xoshiro256**). Every instance owns its state, i.e., there is no hidden global state as with `rand`.
+* @brief Equal seeds yield equal sequences on every platform, which makes replays and benchmarks reproducible. Instances are cheap to copy, so every thread can own one.
+* @brief It satisfies the UniformRandomBitGenerator requirements and can therefore also be used with the distributions of <random>.
+*/
+class RandomGenerator {
+public:
+	typedef uint64_t result_type;
+	/*
+	* @brief Creates a generator with a seed derived from the current time, i.e., with a different sequence on every run.
+	*/
+	RandomGenerator();
+	/*
+	* @param {uint64_t} seed: seed of the generator.
+	*/
+	explicit RandomGenerator(uint64_t seed) { this->seed(seed); }
+	//The names are parenthesized to prevent expansion of the min/max macros of <Windows.h>.
+	static constexpr result_type (min)() { return 0; }
+	static constexpr result_type (max)() { return (std::numeric_limits<result_type>::max)(); }
+	inline result_type operator()(void) { return this->next(); }
+	/*
+	* @brief Returns a uniformly distributed integer in [0, bound). Uses a multiply-shift reduction instead of a (slow) modulo.
+	*/
+	inline uint32_t below(uint32_t bound) { return (uint32_t)(((this->next() >> 32) * bound) >> 32); }
+	/*
+	* @brief Advances the state by 2^128 steps. Calling it k times on copies of one generator yields k non-overlapping sequences, e.g., one per worker thread.
+	*/
+	void jump(void);
+	inline uint64_t next(void) {
+		const uint64_t result = RandomGenerator::_rotateLeft(this->_state[1] * 5, 7) * 9;
+		const uint64_t t = this->_state[1] << 17;
+		this->_state[2] ^= this->_state[0];
+		this->_state[3] ^= this->_state[1];
+		this->_state[1] ^= this->_state[2];
+		this->_state[0] ^= this->_state[3];
+		this->_state[2] ^= t;
+		this->_state[3] = RandomGenerator::_rotateLeft(this->_state[3], 45);
+		return result;
+	}
+	/*
+	* @brief Returns a uniformly distributed real number in [a, b). Replaces the former `Random::random(a, b)`.
+	*/
+	inline double random(double a, double b) { return a + (b - a) * ((this->next() >> 11) * (1.0 / 9007199254740992.0)); }
+	/*
+	* @brief Resets the state of the generator. The state is expanded from the seed with splitmix64, hence any seed (including 0) is valid.
+	*/
+	void seed(uint64_t value);
+private:
+	uint64_t _state[4];
+
+	static inline uint64_t _rotateLeft(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+};
+#endif //!RANDOM_GENERATOR_H
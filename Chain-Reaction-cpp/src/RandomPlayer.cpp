@@ -0,0 +1,16 @@
+#include "RandomPlayer.h"
+
+//*************************************** Public methods ****************************************
+
+RandomPlayer::RandomPlayer(uint64_t seed) {
+	this->seed(seed);
+}
+bool RandomPlayer::findMove(const GameEngine& game, uint32_t& cellIndex) {
+	this->_moves.clear();
+	for (uint32_t index = 0; index < (uint32_t)game.getBoard().size(); index++) {
+		if (game.isLegalMove(index)) this->_moves.push_back(index);
+	}
+	if (this->_moves.empty()) return false;
+	cellIndex = this->_moves[this->_random.below((uint32_t)this->_moves.size())];
+	return true;
+}
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef RANDOM_PLAYER_H
+#define RANDOM_PLAYER_H
+
+#include <vector>
+#include "ComputerPlayer.h"
+
+/*
+* @brief A computer player choosing uniformly among the legal moves. Used as a baseline for evaluating other players.
+*/
+class RandomPlayer : public ComputerPlayer {
+public:
+	/*
+	* @param {uint64_t} seed: seed of the pseudo random number generator. Equal seeds yield equal sequences of moves.
+	*/
+	RandomPlayer(uint64_t seed = 0);
+	bool findMove(const GameEngine& game, uint32_t& cellIndex) override;
+private:
+	std::vector<uint32_t> _moves; //Scratch buffer for the legal moves of a position.
+};
+#endif //!RANDOM_PLAYER_H
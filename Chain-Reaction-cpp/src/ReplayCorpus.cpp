@@ -0,0 +1,228 @@
+#include "ReplayCorpus.h"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <unordered_map>
+
+//*************************************** CorpusWriter ****************************************
+
+CorpusWriter::~CorpusWriter() {
+	this->close();
+}
+uint64_t CorpusWriter::addGames(const uint8_t* data, size_t size) {
+	if (!this->_file.is_open() || this->_hasError) return 0;
+	GameRecordReader reader;
+	reader.open(data, size);
+	uint64_t addedGames = 0;
+	while (reader.nextGame()) {
+		const uint64_t gameOffset = this->_segmentStart + sizeof(ReplayCorpus::SegmentHeader) + this->_gameBytes;
+		if (gameOffset > ReplayCorpus::OFFSET_MASK) {
+			this->_hasError = true;
+			break;
+		}
+		//Replay the game and collect an index entry for the position before every move and for the final position.
+		this->_gameEntries.clear();
+		bool isValid = reader.seek(this->_engine, 0);
+		const uint32_t columns = reader.getHeader().columns;
+		while (isValid) {
+			ReplayCorpus::IndexEntry entry;
+			entry.hash = this->_engine.getHash();
+			entry.game = gameOffset | ((uint64_t)this->_engine.getCurrentPlayer() << 56);
+			entry.ply = reader.getPly();
+			entry.reply = ReplayCorpus::NO_REPLY;
+			uint32_t cellIndex;
+			const bool hasMove = reader.nextMove(cellIndex);
+			if (hasMove) entry.reply = cellIndex;
+			this->_gameEntries.push_back(entry);
+			if (!hasMove) break;
+			isValid = this->_engine.processPlayerInput(cellIndex % columns, cellIndex / columns);
+			this->_engine.resolveChainReaction();
+		}
+		if (reader.hasError()) {
+			this->_skippedGameCount++;
+			break;
+		}
+		if (!isValid) {
+			this->_skippedGameCount++;
+			continue;
+		}
+		const uint64_t winnerIndex = reader.getWinnerIndex();
+		for (auto& entry : this->_gameEntries) entry.game |= winnerIndex << 48;
+		//The header of a segment is only a placeholder until the segment is complete.
+		if (!this->_gameCount) {
+			const ReplayCorpus::SegmentHeader placeholder = {};
+			this->_file.seekp((std::streamoff)this->_segmentStart);
+			this->_file.write((const char*)&placeholder, sizeof(placeholder));
+		}
+		const size_t gameSize = reader.getOffset() - reader.getGameOffset();
+		this->_file.write((const char*)data + reader.getGameOffset(), (std::streamsize)gameSize);
+		this->_gameBytes += gameSize;
+		this->_gameCount++;
+		this->_entries.insert(this->_entries.end(), this->_gameEntries.begin(), this->_gameEntries.end());
+		addedGames++;
+		if (this->_entries.size() >= this->_maxEntries && !this->_finishSegment()) break;
+	}
+	if (!this->_file.good()) this->_hasError = true;
+	return addedGames;
+}
+bool CorpusWriter::close(void) {
+	if (!this->_file.is_open()) return false;
+	const bool isWritten = this->_finishSegment();
+	this->_file.close();
+	this->_entries.clear();
+	this->_entries.shrink_to_fit();
+	return isWritten;
+}
+bool CorpusWriter::open(const std::string& path, size_t maxEntries) {
+	this->close();
+	this->_maxEntries = (std::max)((size_t)1, maxEntries);
+	this->_hasError = false;
+	this->_skippedGameCount = 0;
+	//Find the end of the last complete segment and discard anything after it.
+	uint64_t validEnd = 0;
+	std::ifstream existing(path, std::ios::binary | std::ios::ate);
+	if (existing.is_open()) {
+		const uint64_t fileSize = (uint64_t)existing.tellg();
+		ReplayCorpus::SegmentHeader header;
+		while (fileSize - validEnd >= sizeof(header)) {
+			existing.seekg((std::streamoff)validEnd);
+			if (!existing.read((char*)&header, sizeof(header))) break;
+			const uint64_t segmentSize = ReplayCorpus::getSegmentSize(header, fileSize - validEnd);
+			if (!segmentSize) break;
+			validEnd += segmentSize;
+		}
+		existing.close();
+		std::error_code error;
+		if (validEnd != fileSize) std::filesystem::resize_file(path, validEnd, error);
+		if (error) return false;
+	}
+	else {
+		std::ofstream created(path, std::ios::binary);
+		if (!created.is_open()) return false;
+	}
+	this->_file.open(path, std::ios::in | std::ios::out | std::ios::binary);
+	if (!this->_file.is_open()) return false;
+	this->_segmentStart = validEnd;
+	this->_gameBytes = 0;
+	this->_gameCount = 0;
+	this->_entries.clear();
+	this->_entries.reserve((std::min)(this->_maxEntries, (size_t)1024 * 1024));
+	return true;
+}
+//******************************************* Private methods ************************************
+
+bool CorpusWriter::_finishSegment(void) {
+	if (this->_hasError) return false;
+	if (!this->_gameCount) return true;
+	const char padding[8] = {};
+	this->_file.write(padding, (std::streamsize)(ReplayCorpus::getPaddedSize(this->_gameBytes) - this->_gameBytes));
+	std::sort(this->_entries.begin(), this->_entries.end(), [](const ReplayCorpus::IndexEntry& a, const ReplayCorpus::IndexEntry& b) {
+		if (a.hash != b.hash) return a.hash < b.hash;
+		if (a.getGameOffset() != b.getGameOffset()) return a.getGameOffset() < b.getGameOffset();
+		return a.ply < b.ply;
+	});
+	this->_file.write((const char*)this->_entries.data(), (std::streamsize)(this->_entries.size() * sizeof(ReplayCorpus::IndexEntry)));
+	this->_file.flush();
+	//The header completes the segment, hence it is written after everything else has reached the file.
+	ReplayCorpus::SegmentHeader header;
+	std::memcpy(header.magic, ReplayCorpus::MAGIC, sizeof(header.magic));
+	header.version = ReplayCorpus::VERSION;
+	header.gameBytes = this->_gameBytes;
+	header.gameCount = this->_gameCount;
+	header.entryCount = this->_entries.size();
+	const uint64_t segmentEnd = this->_segmentStart + sizeof(header) + ReplayCorpus::getPaddedSize(this->_gameBytes) + this->_entries.size() * sizeof(ReplayCorpus::IndexEntry);
+	this->_file.seekp((std::streamoff)this->_segmentStart);
+	this->_file.write((const char*)&header, sizeof(header));
+	this->_file.flush();
+	this->_file.seekp((std::streamoff)segmentEnd);
+	this->_segmentStart = segmentEnd;
+	this->_gameBytes = 0;
+	this->_gameCount = 0;
+	this->_entries.clear();
+	if (!this->_file.good()) this->_hasError = true;
+	return !this->_hasError;
+}
+//*************************************** CorpusReader ****************************************
+
+void CorpusReader::close(void) {
+	this->_file.close();
+	this->_segments.clear();
+	this->_entryCount = 0;
+	this->_gameCount = 0;
+}
+size_t CorpusReader::findPosition(uint64_t hash, std::vector<ReplayCorpus::IndexEntry>& entries) const {
+	size_t count = 0;
+	for (const auto& segment : this->_segments) {
+		const auto range = CorpusReader::_findRange(segment, hash);
+		entries.insert(entries.end(), range.first, range.second);
+		count += range.second - range.first;
+	}
+	return count;
+}
+uint64_t CorpusReader::getPositionCount(uint64_t hash) const {
+	uint64_t count = 0;
+	for (const auto& segment : this->_segments) {
+		const auto range = CorpusReader::_findRange(segment, hash);
+		count += range.second - range.first;
+	}
+	return count;
+}
+std::vector<ReplayCorpus::ReplyStatistics> CorpusReader::getReplyStatistics(uint64_t hash) const {
+	std::vector<ReplayCorpus::ReplyStatistics> statistics;
+	std::unordered_map<uint32_t, size_t> replyIndex; //Maps the cell index of a reply to its position in the statistics.
+	for (const auto& segment : this->_segments) {
+		const auto range = CorpusReader::_findRange(segment, hash);
+		for (const ReplayCorpus::IndexEntry* entry = range.first; entry != range.second; entry++) {
+			if (entry->reply == ReplayCorpus::NO_REPLY || !entry->getWinnerIndex()) continue;
+			auto inserted = replyIndex.emplace(entry->reply, statistics.size());
+			if (inserted.second) statistics.push_back({ entry->reply, 0, 0 });
+			auto& reply = statistics[inserted.first->second];
+			reply.games++;
+			if (entry->getWinnerIndex() == entry->getPlayer() + 1u) reply.wins++;
+		}
+	}
+	std::sort(statistics.begin(), statistics.end(), [](const ReplayCorpus::ReplyStatistics& a, const ReplayCorpus::ReplyStatistics& b) {
+		return a.games != b.games ? a.games > b.games : a.cellIndex < b.cellIndex;
+	});
+	return statistics;
+}
+bool CorpusReader::open(const std::string& path) {
+	this->close();
+	if (!this->_file.open(path)) return false;
+	const uint8_t* data = this->_file.getData();
+	const uint64_t fileSize = this->_file.getSize();
+	uint64_t offset = 0;
+	while (fileSize - offset >= sizeof(ReplayCorpus::SegmentHeader)) {
+		ReplayCorpus::SegmentHeader header;
+		std::memcpy(&header, data + offset, sizeof(header));
+		const uint64_t segmentSize = ReplayCorpus::getSegmentSize(header, fileSize - offset);
+		if (!segmentSize) break;
+		Segment segment;
+		segment.gameBegin = offset + sizeof(header);
+		segment.gameEnd = segment.gameBegin + header.gameBytes;
+		segment.entries = (const ReplayCorpus::IndexEntry*)(data + segment.gameBegin + ReplayCorpus::getPaddedSize(header.gameBytes));
+		segment.entryCount = header.entryCount;
+		this->_segments.push_back(segment);
+		this->_entryCount += header.entryCount;
+		this->_gameCount += header.gameCount;
+		offset += segmentSize;
+	}
+	return true;
+}
+bool CorpusReader::openGame(uint64_t gameOffset, GameRecordReader& reader) const {
+	for (const auto& segment : this->_segments) {
+		if (gameOffset < segment.gameBegin || gameOffset >= segment.gameEnd) continue;
+		reader.open(this->_file.getData() + gameOffset, (size_t)(segment.gameEnd - gameOffset));
+		return true;
+	}
+	return false;
+}
+//******************************************* Private methods ************************************
+
+std::pair<const ReplayCorpus::IndexEntry*, const ReplayCorpus::IndexEntry*> CorpusReader::_findRange(const Segment& segment, uint64_t hash) {
+	const ReplayCorpus::IndexEntry* begin = segment.entries;
+	const ReplayCorpus::IndexEntry* end = segment.entries + segment.entryCount;
+	const ReplayCorpus::IndexEntry* first = std::lower_bound(begin, end, hash, [](const ReplayCorpus::IndexEntry& entry, uint64_t value) { return entry.hash < value; });
+	const ReplayCorpus::IndexEntry* last = std::upper_bound(first, end, hash, [](uint64_t value, const ReplayCorpus::IndexEntry& entry) { return value < entry.hash; });
+	return { first, last };
+}
@@ -0,0 +1,192 @@
+#pragma once
+#ifndef REPLAY_CORPUS_H
+#define REPLAY_CORPUS_H
+
+/* The replay corpus is part of the headless engine library and must therefore not depend on wxWidgets, OpenGL or OpenAL.
+ A corpus is a single append-only file of segments. Every segment holds a batch of games and a sorted index of the positions reached in them:
+	1. Segment header (see `SegmentHeader`).
+	2. The games in the binary game-record format (see GameRecord.h), zero padded to a multiple of 8 bytes.
+	3. One index entry (see `IndexEntry`) per position of every game, sorted by position hash.
+ Ingesting games only appends segments; the header of a segment is written last, so an interrupted ingest leaves an incomplete segment that is discarded on the next open.
+ The size of a segment is bounded by the number of index entries kept in memory while ingesting. Queries map the file into memory and binary search the index of every segment,
+ hence they only touch the pages of the matching entries, whatever the size of the corpus. Numbers are stored in the byte order of the machine (little endian on every supported platform).
+*/
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "GameRecord.h"
+#include "MappedFile.h"
+
+namespace ReplayCorpus {
+	const uint8_t MAGIC[4] = { 'C', 'R', 'C', 'P' };
+	const uint32_t VERSION = 1;
+	const uint32_t NO_REPLY = UINT32_MAX; //Reply of the final position of a game.
+	const uint64_t OFFSET_MASK = (1ULL << 48) - 1;
+	/*
+	* @brief Header of a segment.
+	* @brief Member variables:
+	* @brief	1. {uint8_t[4]} magic: "CRCP".
+	* @brief	2. {uint32_t} version: format version of the segment.
+	* @brief	3. {uint64_t} gameBytes: size of the encoded games (without padding).
+	* @brief	4. {uint64_t} gameCount: number of games in the segment.
+	* @brief	5. {uint64_t} entryCount: number of index entries in the segment.
+	*/
+	typedef struct SegmentHeader {
+		uint8_t magic[4];
+		uint32_t version;
+		uint64_t gameBytes;
+		uint64_t gameCount;
+		uint64_t entryCount;
+	} SegmentHeader;
+	/*
+	* @brief Index entry of a position reached in a game, i.e., of the position after `ply` moves.
+	* @brief Member variables:
+	* @brief	1. {uint64_t} hash: Zobrist hash of the position (see `GameEngine::getHash`). It includes the board dimension and the number of players.
+	* @brief	2. {uint64_t} game: bits 0 to 47 hold the offset of the game record in the corpus file, bits 48 to 55 the (1-based) winner of the game (0 if it was abandoned)
+	* @brief	   and bits 56 to 63 the (0-based) id of the player to move in the position. Use the accessors for reading them.
+	* @brief	3. {uint32_t} ply: number of moves made before the position.
+	* @brief	4. {uint32_t} reply: cell index of the move that was played in the position, or NO_REPLY for the final position of the game.
+	*/
+	typedef struct IndexEntry {
+		uint64_t hash;
+		uint64_t game;
+		uint32_t ply;
+		uint32_t reply;
+		inline uint64_t getGameOffset() const { return this->game & OFFSET_MASK; }
+		inline uint8_t getPlayer() const { return (uint8_t)(this->game >> 56); }
+		inline unsigned int getWinnerIndex() const { return (unsigned int)((this->game >> 48) & 0xFF); }
+	} IndexEntry;
+	/*
+	* @brief Statistics of a move played in a position.
+	* @brief Member variables:
+	* @brief	1. {uint32_t} cellIndex: cell index of the move.
+	* @brief	2. {uint64_t} games: number of finished games in which the move was played. Abandoned games are not counted.
+	* @brief	3. {uint64_t} wins: number of those games won by the player who made the move.
+	*/
+	typedef struct ReplyStatistics {
+		uint32_t cellIndex;
+		uint64_t games;
+		uint64_t wins;
+	} ReplyStatistics;
+
+	inline uint64_t getPaddedSize(uint64_t size) { return (size + 7) & ~7ULL; }
+	/*
+	* @brief Returns the size of the segment starting at some offset of a corpus file, or 0 if there is no complete segment at that offset.
+	* @param {SegmentHeader} header: header read at the offset.
+	* @param {uint64_t} available: number of bytes from the offset to the end of the file.
+	*/
+	inline uint64_t getSegmentSize(const SegmentHeader& header, uint64_t available) {
+		if (available < sizeof(SegmentHeader) || header.magic[0] != MAGIC[0] || header.magic[1] != MAGIC[1] || header.magic[2] != MAGIC[2] || header.magic[3] != MAGIC[3] || header.version != VERSION) return 0;
+		//Guard against overflow with a corrupted header.
+		if (header.gameBytes > available || header.entryCount > available / sizeof(IndexEntry)) return 0;
+		const uint64_t size = sizeof(SegmentHeader) + getPaddedSize(header.gameBytes) + header.entryCount * sizeof(IndexEntry);
+		return size <= available ? size : 0;
+	}
+}
+/*
+* @brief Appends games to a replay corpus. Memory use is bounded: games are streamed to the file and at most `maxEntries` index entries are kept in memory;
+* @brief once that many are collected, they are sorted and written as the index of the current segment and a new segment is started.
+*/
+class CorpusWriter {
+public:
+	CorpusWriter() = default;
+	/*
+	* @brief Completes the current segment and closes the corpus file.
+	*/
+	~CorpusWriter();
+	/*
+	* @brief Adds every game of a buffer in the binary game-record format. Every game is replayed through the engine for indexing its positions.
+	* @brief Games with an illegal move or malformed data are skipped (see `getSkippedGameCount`).
+	* @returns {uint64_t} number of games that were added.
+	*/
+	uint64_t addGames(const uint8_t* data, size_t size);
+	/*
+	* @brief Completes the current segment and closes the corpus file.
+	* @returns {bool} true if every segment was written, false if writing failed.
+	*/
+	bool close(void);
+	inline uint64_t getSkippedGameCount() const { return this->_skippedGameCount; }
+	inline bool isOpen() const { return this->_file.is_open(); }
+	/*
+	* @brief Opens a corpus file for appending games. The file is created if it does not exist; an incomplete segment at its end is discarded.
+	* @param {string} path: path to the corpus file.
+	* @param {size_t} maxEntries: maximum number of index entries kept in memory, i.e., the size of the largest segment index.
+	* @returns {bool} true if the file is open, false otherwise.
+	*/
+	bool open(const std::string& path, size_t maxEntries = 8 * 1024 * 1024);
+private:
+	GameEngine _engine; //Engine used for replaying the games.
+	std::vector<ReplayCorpus::IndexEntry> _entries; //Index entries of the current segment.
+	std::fstream _file;
+	uint64_t _gameBytes = 0; //Size of the games written to the current segment.
+	uint64_t _gameCount = 0; //Number of games in the current segment.
+	std::vector<ReplayCorpus::IndexEntry> _gameEntries; //Index entries of the game being replayed. They are only kept if the whole game is valid.
+	bool _hasError = false;
+	size_t _maxEntries = 0;
+	uint64_t _segmentStart = 0; //Offset of the current segment in the file.
+	uint64_t _skippedGameCount = 0;
+
+	/*
+	* @brief Sorts the collected index entries, writes them and then the header of the current segment. Does nothing if the segment has no game.
+	*/
+	bool _finishSegment(void);
+};
+/*
+* @brief Answers position queries on a replay corpus. The corpus file is memory-mapped, hence opening it only reads the segment headers.
+*/
+class CorpusReader {
+public:
+	CorpusReader() = default;
+	void close(void);
+	/*
+	* @brief Appends the index entries of every occurrence of a position, i.e., one entry per game (and ply) that reached it.
+	* @param {uint64_t} hash: Zobrist hash of the position (see `GameEngine::getHash`).
+	* @param {vector<IndexEntry>&} entries: receives the entries, ordered by segment and then by game.
+	* @returns {size_t} number of appended entries.
+	*/
+	size_t findPosition(uint64_t hash, std::vector<ReplayCorpus::IndexEntry>& entries) const;
+	/*
+	* @brief Counts the occurrences of a position without collecting them.
+	*/
+	uint64_t getPositionCount(uint64_t hash) const;
+	inline uint64_t getEntryCount() const { return this->_entryCount; }
+	inline uint64_t getGameCount() const { return this->_gameCount; }
+	/*
+	* @brief Computes the statistics of every move played in a position, ordered by the number of games (most played first).
+	*/
+	std::vector<ReplayCorpus::ReplyStatistics> getReplyStatistics(uint64_t hash) const;
+	inline size_t getSegmentCount() const { return this->_segments.size(); }
+	/*
+	* @brief Maps a corpus file into memory and reads its segment headers. An incomplete segment at the end of the file is ignored.
+	* @returns {bool} true if the corpus was opened, false otherwise.
+	*/
+	bool open(const std::string& path);
+	/*
+	* @brief Prepares a game record reader for reading a game of the corpus, e.g., the game of an index entry. `nextGame` must be called on the reader afterwards.
+	* @param {uint64_t} gameOffset: offset of the game record in the corpus file (see `IndexEntry::getGameOffset`).
+	* @param {GameRecordReader&} reader: reader that is opened on the games of the segment, starting at the given game.
+	* @returns {bool} true if the offset lies in a segment, false otherwise.
+	*/
+	bool openGame(uint64_t gameOffset, GameRecordReader& reader) const;
+private:
+	/*
+	* @brief Location of a segment in the mapped file.
+	*/
+	typedef struct Segment {
+		uint64_t gameBegin; //Offset of the first game.
+		uint64_t gameEnd; //Offset after the last game.
+		const ReplayCorpus::IndexEntry* entries;
+		uint64_t entryCount;
+	} Segment;
+	uint64_t _entryCount = 0;
+	MappedFile _file;
+	uint64_t _gameCount = 0;
+	std::vector<Segment> _segments;
+
+	/*
+	* @brief Returns the range of the index entries of a position in a segment.
+	*/
+	static std::pair<const ReplayCorpus::IndexEntry*, const ReplayCorpus::IndexEntry*> _findRange(const Segment& segment, uint64_t hash);
+};
+#endif //!REPLAY_CORPUS_H
@@ -10,6 +10,13 @@ Shaders::~Shaders() {
 		glDeleteProgram(_programID);
 	}
 }
+void Shaders::deleteProgram() {
+	if (_programID != 0) {
+		glDeleteProgram(_programID);
+		_programID = 0;
+		_uniformList.clear();
+	}
+}
 bool Shaders::compileShaders(const char* VertSource, const char* FragSource, bool rawSource) {
 	if (rawSource) {  //VertSource and FragSource are raw source code
 		_VertexShader = std::string(VertSource);
@@ -132,6 +139,7 @@ bool Shaders::compileShaders(const char* VertSource, const char* FragSource, boo
 	glDeleteShader(_fragID);
 
 	this->_detectUniforms();
+	this->_bindFrameState();
 	wxLogDebug(wxString::Format("[Chain-Reaction] Created shader program %d at address %p ...", _programID, &_programID));
 	return true;
 }
@@ -166,17 +174,24 @@ GLint Shaders::getUniformLocation(const char* uniformName) const {
 		return -1;
 	}
 }
+void Shaders::_bindFrameState() {
+	GLuint blockIndex = glGetUniformBlockIndex(this->_programID, "FrameState");
+	if (blockIndex != GL_INVALID_INDEX) glUniformBlockBinding(this->_programID, blockIndex, Shaders::FRAME_STATE_BINDING);
+}
 void Shaders::_detectUniforms() {
 	GLint totalUniforms = 0;
 	GLint maxLength = 0;
 	glGetProgramiv(this->_programID, GL_ACTIVE_UNIFORMS, &totalUniforms);
 	glGetProgramiv(this->_programID, GL_ACTIVE_UNIFORM_MAX_LENGTH, &maxLength);
-	std::string uniformName;
+	this->_uniformList.clear(); //Locations of a previously compiled program are stale.
+	std::vector<GLchar> uniformName((size_t)(std::max)(maxLength, 1));
 	for (int i = 0; i < totalUniforms; i++) {
-		glGetActiveUniformName(this->_programID, i, maxLength, NULL, &uniformName[0]);
-		GLint location = glGetUniformLocation(_programID, uniformName.c_str());
-		if (location < 0) continue;
-		_uniformList[uniformName.c_str()] = location;
+		GLsizei length = 0;
+		glGetActiveUniformName(this->_programID, i, (GLsizei)uniformName.size(), &length, &uniformName[0]);
+		std::string name(&uniformName[0], (size_t)length);
+		GLint location = glGetUniformLocation(_programID, name.c_str());
+		if (location < 0) continue; //Members of uniform blocks have no location.
+		_uniformList[name] = location;
 	}
 }
 void Shaders::use() const {
@@ -6,6 +6,37 @@
 
 class Shaders{
 public:
+	/*
+	* @brief Per-frame state (camera and light) shared by all shader programs through the uniform block `FrameState`, which is declared with std140 layout:
+	* layout(std140) uniform FrameState { mat4 projectionView; vec3 cameraPosition; vec3 lightDirection; };
+	* Each vec3 is padded to 16 bytes in that layout.
+	*/
+	typedef struct FrameState {
+		glm::mat4 projectionView = glm::mat4(1.0f);
+		glm::vec3 cameraPosition = glm::vec3(0.0f);
+		GLfloat paddingAfterCameraPosition = 0.0f;
+		glm::vec3 lightDirection = glm::vec3(0.0f, 0.0f, -1.0f);
+		GLfloat paddingAfterLightDirection = 0.0f;
+	} FrameState;
+	static const GLuint FRAME_STATE_BINDING = 0; //Uniform buffer binding point of the uniform block `FrameState` in every program.
+	/*
+	* @brief Typed handle to a uniform variable of a shader program. It is resolved once (see `getUniform`), hence setting its value
+	* needs no lookup by name. Setting a uniform that is not active in the program (location -1) does nothing.
+	* The program must be in use while a value is set.
+	*/
+	class Uniform {
+	public:
+		Uniform(GLint location = -1) : _location(location) {}
+		inline bool isActive() const { return _location != -1; }
+		inline GLint getLocation() const { return _location; }
+		inline void set(GLfloat value) const { if (_location != -1) glUniform1f(_location, value); }
+		inline void set(const glm::vec3& value) const { if (_location != -1) glUniform3fv(_location, 1, &value[0]); }
+		inline void set(const glm::vec4& value) const { if (_location != -1) glUniform4fv(_location, 1, &value[0]); }
+		inline void set(const glm::mat4& value) const { if (_location != -1) glUniformMatrix4fv(_location, 1, GL_FALSE, &value[0][0]); }
+		inline void set(const glm::vec4* values, GLsizei count) const { if (_location != -1 && count > 0) glUniform4fv(_location, count, &values[0][0]); }
+	private:
+		GLint _location;
+	};
 	/*
 	* @brief Default constructor of Shaders object. It only supports vertex and fragment shaders.
 	*/
@@ -38,16 +69,26 @@ public:
 	//Unbinds the shader program.
 	void unuse() const;
 	/*
+	* @brief Frees the shader program. It must be called on the thread whose OpenGL context created the program. The program can be compiled again afterwards.
+	*/
+	void deleteProgram();
+	/*
 	* @brief Searches for the <GLint> location of a uniform variable in the shader program.
 	* @param {const char*} uniformName: name of the uniform variable.
 	* @returns {GLint} location of the uniform variable if found, -1 otherwise.
 	*/
 	GLint getUniformLocation(const char* uniformName) const;
+	/*
+	* @brief Resolves a typed handle to a uniform variable of the shader program. Handles stay valid until the program is compiled again.
+	* @param {const char*} uniformName: name of the uniform variable (for arrays, name of the first element, e.g., "palette[0]").
+	* @returns {Uniform} handle to the uniform variable. It is inactive if the variable is not found.
+	*/
+	inline Uniform getUniform(const char* uniformName) const { return Uniform(this->getUniformLocation(uniformName)); }
 	// Returns the program ID.
 	inline GLuint getID() const { return _programID; }
 
 private:
-	std::unordered_map<std::string, GLuint> _uniformList; // A private map containing name of the uniform variables and their locations.
+	std::unordered_map<std::string, GLint> _uniformList; // A private map containing name of the uniform variables and their locations.
 	std::string _VertexShader, _FragmentShader;
 	GLuint _programID;
 	objl::Material _currentMaterial;
@@ -55,5 +96,9 @@ private:
 	* @brief Collects all uniform variable names from the program and store them in a private map <name, location> for handy usage.
 	*/
 	void _detectUniforms();
+	/*
+	* @brief Attaches the uniform block `FrameState`, if the program declares it, to the binding point FRAME_STATE_BINDING.
+	*/
+	void _bindFrameState();
 };
 #endif //!SHADERS_H
\ No newline at end of file
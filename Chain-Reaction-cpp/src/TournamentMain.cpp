@@ -0,0 +1,293 @@
+/* Command-line self-play tournament between the built-in computer players. It only depends on the headless engine library,
+ hence it does not include the precompiled header and runs on machines without a display.
+ Usage: Chain-Reaction-cpp-Tournament [--games N] [--rows R] [--columns C] [--players P] [--threads T] [--policies random,greedy,lookahead]
+                                      [--time MS] [--seed S] [--csv FILE] [--json FILE] [--record FILE] [--checkpoints N]
+*/
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include "AlphaBetaPlayer.h"
+#include "GameRecord.h"
+#include "GreedyPlayer.h"
+#include "MctsPlayer.h"
+#include "RandomPlayer.h"
+
+namespace Tournament {
+	/*
+	* @brief Settings of a tournament, parsed from the command line.
+	*/
+	typedef struct Settings {
+		unsigned int games = 100;
+		unsigned int rows = 8;
+		unsigned int columns = 6;
+		unsigned int players = 2;
+		unsigned int threads = 0; //0 selects one worker per hardware thread.
+		unsigned int timeBudget = 100; //Time budget (in milliseconds) of the alphabeta and mcts policies.
+		uint64_t seed = 1;
+		std::vector<std::string> policies = { "random", "greedy", "lookahead" };
+		std::string csvPath, jsonPath;
+		std::string recordPath; //Games are appended to this file in the binary game-record format.
+		unsigned int checkpointInterval = 0; //Number of moves between two position checkpoints in the game record.
+	} Settings;
+	/*
+	* @brief Result of a single game.
+	*/
+	typedef struct GameResult {
+		unsigned int gameIndex = 0;
+		std::vector<unsigned int> seats; //Policy index of each player in the order of play.
+		unsigned int winner = 0; //(0-based) id of the winning player. Only meaningful if the game was not abandoned.
+		bool abandoned = false; //A player found no move before the game ended, hence the game has no winner.
+		unsigned int moves = 0;
+		double wallMilliseconds = 0.0;
+		uint64_t nodes = 0;
+	} GameResult;
+
+	/*
+	* @brief Creates a computer player for a policy name. Returns null for an unknown name.
+	*/
+	std::unique_ptr<ComputerPlayer> createPlayer(const std::string& policy, const Settings& settings, uint64_t seed) {
+		if (policy == "random") return std::make_unique<RandomPlayer>(seed);
+		if (policy == "greedy") return std::make_unique<GreedyPlayer>(seed);
+		//Shallow lookahead: a two-ply alpha-beta search which is bounded by depth rather than by time.
+		if (policy == "lookahead") return std::make_unique<AlphaBetaPlayer>(60000, 1024 * 1024, 2);
+		if (policy == "alphabeta") return std::make_unique<AlphaBetaPlayer>(settings.timeBudget, 16 * 1024 * 1024);
+		if (policy == "mcts") return std::make_unique<MctsPlayer>(settings.timeBudget, 1, 16 * 1024 * 1024);
+		return nullptr;
+	}
+	GameUtilities::PlayerType getPlayerType(const std::string& policy) {
+		if (policy == "random") return GameUtilities::RANDOM_PLAYER;
+		if (policy == "greedy") return GameUtilities::GREEDY_PLAYER;
+		if (policy == "mcts") return GameUtilities::MCTS_PLAYER;
+		return GameUtilities::ALPHA_BETA_PLAYER;
+	}
+	/*
+	* @brief Plays a single game. Seats are rotated over the policies, so that every policy plays every position in the order of play equally often.
+	* @brief If a record writer is given, the game is recorded with it (the writer is not flushed to a file, see `main`).
+	*/
+	GameResult playGame(unsigned int gameIndex, const Settings& settings, std::vector<std::unique_ptr<ComputerPlayer>>& players, GameRecordWriter* recordWriter) {
+		GameResult result;
+		result.gameIndex = gameIndex;
+		const uint64_t gameSeed = settings.seed * 0x9E3779B97F4A7C15ULL + gameIndex;
+		for (unsigned int seat = 0; seat < settings.players; seat++) {
+			const unsigned int policy = (gameIndex + seat) % (unsigned int)settings.policies.size();
+			result.seats.push_back(policy);
+			players[policy]->seed(gameSeed + seat);
+		}
+		GameEngine game;
+		game.setAttribute(settings.rows, settings.columns, (uint8_t)settings.players);
+		if (recordWriter != nullptr) {
+			GameRecord::Header header;
+			header.rows = settings.rows;
+			header.columns = settings.columns;
+			for (const auto& policy : result.seats) {
+				header.playerTypes.push_back((uint8_t)getPlayerType(settings.policies[policy]));
+				header.playerNames.push_back(settings.policies[policy]);
+			}
+			header.seed = gameSeed;
+			header.checkpointInterval = settings.checkpointInterval;
+			recordWriter->beginGame(header);
+		}
+		const auto start = std::chrono::steady_clock::now();
+		while (!game.hasGameEnded()) {
+			ComputerPlayer* player = players[result.seats[game.getCurrentPlayer()]].get();
+			uint32_t cellIndex;
+			if (!player->findMove(game, cellIndex)) break;
+			result.nodes += player->getNodeCount();
+			if (recordWriter != nullptr) recordWriter->recordMove(game, cellIndex);
+			game.processPlayerInput(cellIndex % settings.columns, cellIndex / settings.columns);
+			game.resolveChainReaction();
+			result.moves++;
+		}
+		result.wallMilliseconds = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+		result.abandoned = !game.hasGameEnded();
+		result.winner = game.getWinnerIndex() ? game.getWinnerIndex() - 1 : 0;
+		if (recordWriter != nullptr) recordWriter->endGame(game.getWinnerIndex());
+		return result;
+	}
+	/*
+	* @brief Estimates Elo ratings from the results with the Bradley-Terry model. The winner of a game beats every other seat; seats of the same policy and abandoned games are skipped.
+	* @brief Every pair of policies additionally gets one virtual draw, which keeps the ratings finite if a policy wins (or loses) every game.
+	* @returns {vector<double>} rating of each policy; the ratings are centered at 0.
+	*/
+	std::vector<double> estimateElo(const std::vector<GameResult>& results, size_t numberOfPolicies) {
+		std::vector<std::vector<double>> wins(numberOfPolicies, std::vector<double>(numberOfPolicies, 0.0));
+		for (size_t i = 0; i < numberOfPolicies; i++) {
+			for (size_t j = 0; j < numberOfPolicies; j++) if (i != j) wins[i][j] = 0.5;
+		}
+		for (const auto& result : results) {
+			if (result.abandoned) continue;
+			const unsigned int winner = result.seats[result.winner];
+			for (const auto& loser : result.seats) {
+				if (loser != winner) wins[winner][loser] += 1.0;
+			}
+		}
+		//Minorization-maximization iterations of the Bradley-Terry strengths.
+		std::vector<double> strength(numberOfPolicies, 1.0);
+		for (int iteration = 0; iteration < 1000; iteration++) {
+			std::vector<double> next(numberOfPolicies, 0.0);
+			for (size_t i = 0; i < numberOfPolicies; i++) {
+				double totalWins = 0.0, denominator = 0.0;
+				for (size_t j = 0; j < numberOfPolicies; j++) {
+					if (i == j) continue;
+					totalWins += wins[i][j];
+					denominator += (wins[i][j] + wins[j][i]) / (strength[i] + strength[j]);
+				}
+				next[i] = denominator > 0.0 ? totalWins / denominator : 1.0;
+			}
+			strength = next;
+		}
+		std::vector<double> elo(numberOfPolicies, 0.0);
+		double mean = 0.0;
+		for (size_t i = 0; i < numberOfPolicies; i++) {
+			elo[i] = 400.0 * std::log10(strength[i]);
+			mean += elo[i] / numberOfPolicies;
+		}
+		for (auto& rating : elo) rating -= mean;
+		return elo;
+	}
+	std::string joinSeats(const GameResult& result, const Settings& settings, char separator) {
+		std::string text;
+		for (size_t seat = 0; seat < result.seats.size(); seat++) {
+			if (seat) text += separator;
+			text += settings.policies[result.seats[seat]];
+		}
+		return text;
+	}
+	void writeCsv(std::ostream& stream, const std::vector<GameResult>& results, const Settings& settings) {
+		stream << "game,rows,columns,players,seats,winner_seat,winner_policy,abandoned,moves,wall_ms,nodes\n";
+		for (const auto& result : results) {
+			//An abandoned game has the winner seat 0 and no winner policy.
+			stream << result.gameIndex << ',' << settings.rows << ',' << settings.columns << ',' << settings.players << ',' << joinSeats(result, settings, ';') << ','
+				<< (result.abandoned ? 0 : result.winner + 1) << ',' << (result.abandoned ? "" : settings.policies[result.seats[result.winner]]) << ',' << (result.abandoned ? 1 : 0) << ','
+				<< result.moves << ',' << result.wallMilliseconds << ',' << result.nodes << '\n';
+		}
+	}
+	void writeJson(std::ostream& stream, const std::vector<GameResult>& results, const std::vector<double>& elo, const Settings& settings) {
+		stream << "{\n  \"rows\": " << settings.rows << ",\n  \"columns\": " << settings.columns << ",\n  \"players\": " << settings.players << ",\n  \"seed\": " << settings.seed << ",\n  \"elo\": {";
+		for (size_t i = 0; i < settings.policies.size(); i++) stream << (i ? ", " : "") << '"' << settings.policies[i] << "\": " << elo[i];
+		stream << "},\n  \"games\": [\n";
+		for (size_t k = 0; k < results.size(); k++) {
+			const auto& result = results[k];
+			stream << "    {\"game\": " << result.gameIndex << ", \"seats\": [";
+			for (size_t seat = 0; seat < result.seats.size(); seat++) stream << (seat ? ", " : "") << '"' << settings.policies[result.seats[seat]] << '"';
+			if (result.abandoned) stream << "], \"winner_seat\": 0, \"winner_policy\": null, \"abandoned\": true";
+			else stream << "], \"winner_seat\": " << result.winner + 1 << ", \"winner_policy\": \"" << settings.policies[result.seats[result.winner]] << "\", \"abandoned\": false";
+			stream << ", \"moves\": " << result.moves
+				<< ", \"wall_ms\": " << result.wallMilliseconds << ", \"nodes\": " << result.nodes << '}' << (k + 1 < results.size() ? ",\n" : "\n");
+		}
+		stream << "  ]\n}\n";
+	}
+	bool parseArguments(int argc, char** argv, Settings& settings) {
+		for (int i = 1; i < argc; i++) {
+			const std::string option = argv[i];
+			if (i + 1 >= argc) {
+				std::fprintf(stderr, "Missing value of option %s\n", option.c_str());
+				return false;
+			}
+			const char* value = argv[++i];
+			if (option == "--games") settings.games = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--rows") settings.rows = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--columns") settings.columns = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--players") settings.players = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--threads") settings.threads = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--time") settings.timeBudget = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--seed") settings.seed = std::strtoull(value, nullptr, 10);
+			else if (option == "--csv") settings.csvPath = value;
+			else if (option == "--json") settings.jsonPath = value;
+			else if (option == "--record") settings.recordPath = value;
+			else if (option == "--checkpoints") settings.checkpointInterval = (unsigned int)std::strtoul(value, nullptr, 10);
+			else if (option == "--policies") {
+				settings.policies.clear();
+				std::stringstream list(value);
+				std::string policy;
+				while (std::getline(list, policy, ',')) if (!policy.empty()) settings.policies.push_back(policy);
+			}
+			else {
+				std::fprintf(stderr, "Unknown option %s\n", option.c_str());
+				return false;
+			}
+		}
+		if (settings.players < 2 || (uint64_t)settings.rows * settings.columns < settings.players || settings.players > 255 || settings.policies.empty()) {
+			std::fprintf(stderr, "Invalid board dimension, number of players or list of policies\n");
+			return false;
+		}
+		for (const auto& policy : settings.policies) {
+			if (!createPlayer(policy, settings, 0)) {
+				std::fprintf(stderr, "Unknown policy %s (expected random, greedy, lookahead, alphabeta or mcts)\n", policy.c_str());
+				return false;
+			}
+		}
+		return true;
+	}
+}
+int main(int argc, char** argv) {
+	Tournament::Settings settings;
+	if (!Tournament::parseArguments(argc, argv, settings)) return 1;
+	unsigned int numberOfThreads = settings.threads ? settings.threads : std::max(1u, std::thread::hardware_concurrency());
+	numberOfThreads = std::min(numberOfThreads, std::max(1u, settings.games));
+	//Games are handed out to the workers through a shared counter; every worker owns one player per policy.
+	std::vector<Tournament::GameResult> results(settings.games);
+	std::atomic<unsigned int> nextGame = 0;
+	//Every worker records into its own writer; finished games are appended to the shared record file one at a time.
+	std::ofstream recordFile;
+	std::mutex recordMutex;
+	if (!settings.recordPath.empty()) {
+		recordFile.open(settings.recordPath, std::ios::binary | std::ios::app);
+		if (!recordFile.is_open()) {
+			std::fprintf(stderr, "Could not open the record file %s\n", settings.recordPath.c_str());
+			return 1;
+		}
+	}
+	std::vector<std::thread> workers;
+	const auto start = std::chrono::steady_clock::now();
+	for (unsigned int t = 0; t < numberOfThreads; t++) {
+		workers.emplace_back([&settings, &results, &nextGame, &recordFile, &recordMutex, t]() {
+			std::vector<std::unique_ptr<ComputerPlayer>> players;
+			for (const auto& policy : settings.policies) players.push_back(Tournament::createPlayer(policy, settings, settings.seed + t));
+			GameRecordWriter recordWriter;
+			GameRecordWriter* writer = recordFile.is_open() ? &recordWriter : nullptr;
+			for (unsigned int gameIndex = nextGame++; gameIndex < settings.games; gameIndex = nextGame++) {
+				results[gameIndex] = Tournament::playGame(gameIndex, settings, players, writer);
+				if (writer == nullptr) continue;
+				const auto& data = recordWriter.getGameData();
+				std::lock_guard<std::mutex> lock(recordMutex);
+				recordFile.write((const char*)data.data(), (std::streamsize)data.size());
+			}
+		});
+	}
+	for (auto& worker : workers) worker.join();
+	const double totalSeconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	const std::vector<double> elo = Tournament::estimateElo(results, settings.policies.size());
+	if (!settings.csvPath.empty()) {
+		std::ofstream file(settings.csvPath);
+		Tournament::writeCsv(file, results, settings);
+	}
+	if (!settings.jsonPath.empty()) {
+		std::ofstream file(settings.jsonPath);
+		Tournament::writeJson(file, results, elo, settings);
+	}
+	//Summary on the standard output.
+	std::vector<unsigned int> wins(settings.policies.size(), 0), seats(settings.policies.size(), 0);
+	unsigned int abandonedGames = 0;
+	for (const auto& result : results) {
+		if (result.abandoned) abandonedGames++;
+		else wins[result.seats[result.winner]]++;
+		for (const auto& policy : result.seats) seats[policy]++;
+	}
+	std::printf("%u games on a %u x %u board with %u players in %.2f s using %u threads\n", settings.games, settings.rows, settings.columns, settings.players, totalSeconds, numberOfThreads);
+	if (abandonedGames) std::printf("%u games were abandoned because a player found no move; they count for no policy\n", abandonedGames);
+	std::printf("%-12s %8s %8s %8s\n", "policy", "seats", "wins", "elo");
+	for (size_t i = 0; i < settings.policies.size(); i++) std::printf("%-12s %8u %8u %8.1f\n", settings.policies[i].c_str(), seats[i], wins[i], elo[i]);
+	return 0;
+}
@@ -0,0 +1,42 @@
+#include "PrecompiledHeader.h" //precompiled header
+#include "UniformBufferObject.h"
+
+UniformBufferObject::UniformBufferObject() : _uboID(0), _size(0) {}
+UniformBufferObject::~UniformBufferObject() {
+	if (_uboID != 0) {
+		wxLogDebug(wxString::Format("[Chain-Reaction] Freed memory allocated to OpenGL uniform buffer %d at address %p ...", _uboID, &_uboID));
+		glDeleteBuffers(1, &_uboID);
+	}
+}
+
+void UniformBufferObject::bind() const {
+	glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
+}
+void UniformBufferObject::unbind() const {
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+}
+void UniformBufferObject::bindBase(GLuint bindingPoint) const {
+	glBindBufferBase(GL_UNIFORM_BUFFER, bindingPoint, _uboID);
+}
+void UniformBufferObject::deleteBuffer() {
+	if (_uboID != 0) {
+		glDeleteBuffers(1, &_uboID);
+		_uboID = 0;
+		_size = 0;
+	}
+}
+bool UniformBufferObject::isEmpty() {
+	if (_uboID != 0) return false;
+	else return true;
+}
+void UniformBufferObject::loadData(const void* data, unsigned int size) {
+	if (_uboID == 0) {
+		glGenBuffers(1, &_uboID);
+		wxLogDebug(wxString::Format("[Chain-Reaction] Created OpenGL uniform buffer %d at address %p ...", _uboID, &_uboID));
+	}
+	glBindBuffer(GL_UNIFORM_BUFFER, _uboID);
+	if (size == _size) glBufferSubData(GL_UNIFORM_BUFFER, 0, size, data);
+	else glBufferData(GL_UNIFORM_BUFFER, size, data, GL_DYNAMIC_DRAW);
+	glBindBuffer(GL_UNIFORM_BUFFER, 0);
+	_size = size;
+}
@@ -0,0 +1,22 @@
+#ifndef UBO_H
+#define UBO_H
+
+#include "PrecompiledHeader.h"
+
+class UniformBufferObject{
+public:
+	UniformBufferObject();
+	~UniformBufferObject();
+
+	void bind() const;
+	void unbind() const;
+	void bindBase(GLuint bindingPoint) const; //attach the buffer to a uniform block binding point (see Shaders::FRAME_STATE_BINDING)
+	void deleteBuffer();
+	bool isEmpty();
+	inline unsigned int getSize() { return _size; }
+	void loadData(const void* data, unsigned int size); //create the buffer on first use, afterwards overwrite its content in place
+private:
+	GLuint _uboID;
+	unsigned int _size;
+};
+#endif //!UBO_H
@@ -45,6 +45,16 @@ namespace VertexStructure {
 		Color color;
 		Vertex() : position(0, 0, 0), normal(0, 1, 0), texCoord(0, 0), color(255, 255, 255, 255) {};
 	} Vertex;
+	/*
+	* @brief A structure to contain the per-instance attributes of the orbs of a board-cell, which are drawn by instanced rendering.
+	* @brief It has a layout: vec3, vec4, float, vec2; Total byte size of an instance: (3 + 4 + 1 + 2) * 4 = 40 bytes.
+	*/
+	typedef struct OrbInstance {
+		Position center; //Center of the orbs.
+		GLfloat rotation[4]; //Rotation axis (x, y, z) and angle (w, in radians) of the orbs.
+		GLfloat colorIndex; //(0-based) id of the player owning the orbs, i.e., index of the orb color in the palette of the orb shader.
+		GLfloat direction[2]; //Direction (x, y) in which the orbs fly during a blast, scaled by the uniform `blastDisplacement` of the orb shader. Zero for orbs at rest.
+	} OrbInstance;
 }
 namespace ResourceUtilities {
 	/**
@@ -111,13 +121,6 @@ namespace ResourceUtilities {
 }
 namespace GameUtilities {
 	typedef uint64_t BoardKey;
-	typedef struct BoardValue {
-		unsigned int level;
-		std::string color;
-		glm::vec3 rotationAxes;
-		std::pair<uint32_t, uint32_t> boardCoordinate; //stores the board coordinate to which this value belongs.
-		BoardValue() : level(1), color(""), rotationAxes(0.0f, 0.0f, 0.0f), boardCoordinate(0, 0) {};
-	} BoardValue;
 	/**
 	* @file AppGLCanvas.h
 	* @brief A structure for storing runtime game information.
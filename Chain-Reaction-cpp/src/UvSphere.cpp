@@ -6,8 +6,12 @@ UvSphere::UvSphere() : _x(0), _y(0), _z(0), _radius(1), _elementCount(0), _vao(n
 }
 
 UvSphere::~UvSphere() {
+	this->deleteBuffers();
+}
+void UvSphere::deleteBuffers() {
 	if (this->_vao!= nullptr) delete this->_vao;
 	this->_vao = nullptr;
+	this->_vbo.deleteBuffer();
 }
 
 void UvSphere::init(float center_x, float center_y, float center_z, float radius, VertexStructure::Color color, unsigned int lats, unsigned int longs) {
@@ -20,6 +20,10 @@ public:
 	inline glm::vec3 getCenter() const { return glm::vec3(this->_x, this->_y, this->_z); }
 	inline const char* getColor() const { return _currentColor.c_str(); }
 	inline void setColor(const char* color) { _currentColor = std::string(color); }
+	/*
+	* @brief Frees the vertex array and the vertex buffer. It must be called on the thread whose OpenGL context created them. The sphere can be initialized again afterwards.
+	*/
+	void deleteBuffers();
 private:
 	float _x, _y, _z, _radius;
 	std::string _currentColor;
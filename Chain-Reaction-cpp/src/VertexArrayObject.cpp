@@ -1,7 +1,7 @@
 #include "PrecompiledHeader.h" //precompiled header
 #include "VertexArrayObject.h"
 
-VertexArrayObject::VertexArrayObject(): _vaoID(0), _numAttributes(1), _numIndices(0) {
+VertexArrayObject::VertexArrayObject(): _vaoID(0), _numAttributes(1), _numIndices(0), _numInstanceAttributes(0) {
 	glGenVertexArrays(1, &_vaoID);
 	wxLogDebug(wxString::Format("[Chain-Reaction] Created OpenGL vertex array %d at address %p ...", _vaoID, &_vaoID));
 }
@@ -30,6 +30,20 @@ void VertexArrayObject::setVertexBuffer(const VertexBufferObject& vb, VertexLayo
 	unbind();
 	vb.unbind();
 }
+void VertexArrayObject::setInstanceBuffer(const VertexBufferObject& vb, VertexLayout layout, GLuint64 offset) {
+	bind();
+	vb.bind();
+	_numInstanceAttributes = layout.getNumLayout();
+	const auto& layoutList = layout.getLayouts();
+	for (GLuint i = 0; i < layoutList.size(); i++) {
+		Layout l = layoutList[i];
+		glVertexAttribPointer(_numAttributes + i, l.count, l.type, l.normalize, layout.getStride(), (void *) offset);
+		glVertexAttribDivisor(_numAttributes + i, 1);
+		offset += l.count * Layout::GetSize(l.type);
+	}
+	unbind();
+	vb.unbind();
+}
 void VertexArrayObject::setIndexBuffer(const IndexBufferObject& ib) {
 	bind();
 	ib.bind();
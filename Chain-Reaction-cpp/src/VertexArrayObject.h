@@ -15,11 +15,17 @@ public:
 	inline void bind() const { glBindVertexArray(_vaoID); }
 	inline void unbind() const { glBindVertexArray(0); }
 	inline GLuint numIndices() const { return _numIndices; }
-	inline GLuint numAttr() const { return _numAttributes; }
+	inline GLuint numAttr() const { return _numAttributes + _numInstanceAttributes; }
 	void setVertexBuffer(const VertexBufferObject& vb, VertexLayout layout);
+	/*
+	* @brief Attaches a buffer of per-instance attributes (attribute divisor 1) for instanced draw calls. The attributes are numbered after those of the vertex buffer.
+	* @param {GLuint64} offset: byte offset of the first instance in the buffer. Calling this again with another offset selects another range of instances.
+	*/
+	void setInstanceBuffer(const VertexBufferObject& vb, VertexLayout layout, GLuint64 offset = 0);
 	void setIndexBuffer(const IndexBufferObject& ib);
 private:
 	GLuint _vaoID;
 	GLuint _numAttributes, _numIndices;
+	GLuint _numInstanceAttributes;
 };
 #endif
\ No newline at end of file
@@ -33,6 +33,13 @@ bool VertexBufferObject::isEmpty() {
 	if (_vboID != 0) return false;
 	else return true;
 }
+void VertexBufferObject::streamData(const void* data, unsigned int size) {
+	if (_vboID == 0) glGenBuffers(1, &_vboID);
+	glBindBuffer(GL_ARRAY_BUFFER, _vboID);
+	glBufferData(GL_ARRAY_BUFFER, size, data, GL_STREAM_DRAW); //The old data store is orphaned, hence the driver need not wait for draw calls still using it.
+	glBindBuffer(GL_ARRAY_BUFFER, 0);
+	_size = size;
+}
 void VertexBufferObject::loadNewBuffer(const void* data, unsigned int size) {
 	glDeleteBuffers(1, &_vboID);
 	glGenBuffers(1, &_vboID);
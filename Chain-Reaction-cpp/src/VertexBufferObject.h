@@ -15,6 +15,7 @@ public:
 	bool isEmpty();
 	inline unsigned int getSize() { return _size; }
 	void loadNewBuffer(const void* data, unsigned int size); //delete old data and then store
+	void streamData(const void* data, unsigned int size); //replace the data (e.g. per-instance data of every frame) while keeping the buffer id, hence vertex arrays referring to the buffer stay valid
 private:
 	GLuint _vboID;
 	unsigned int _size;
@@ -218,6 +218,13 @@ bool wxAppInstance::loadZipResource(){
 		this->_offlineGameObject.reset(new MainGame(audioData->data, audioData->size, shaderData["vertex-shader-gridlines.txt"].c_str(), shaderData["fragment-shader-gridlines.txt"].c_str(), shaderData["vertex-shader-orbs.txt"].c_str(), shaderData["fragment-shader-orbs.txt"].c_str())); //Create offline game object.		
 		this->_offlineGameObject->setFrame(this->_mainFrame); //Inform game object about the current GUI frame to maintain back and forth communication.
 		this->_offlineGameObject->setPixelScaling(pixelScalingFactor); //Inform game object about the pixel scaling factor of the current OpenGL canvas.
+		//If 'Record games' is checked in the setup panel, games are appended to a record file in the user data directory, e.g., for building an archive of played games.
+		wxString recordDirectory = wxStandardPaths::Get().GetUserDataDir();
+		if (!wxDirExists(recordDirectory)) wxMkdir(recordDirectory);
+		this->_mainFrame->SetRecordPath(recordDirectory + wxFILE_SEP_PATH + "games.crg");
+		//The move hints are looked up in an opening book in the same directory (see the book tool), if there is one.
+		wxString bookPath = recordDirectory + wxFILE_SEP_PATH + "book.crb";
+		if (wxFileExists(bookPath) && !this->_offlineGameObject->openBook(bookPath.ToStdString())) wxLogDebug(wxString::Format("[Chain-Reaction] Error: '%s' is not a valid opening book ...", bookPath));
 		this->_gameInformation.reset(new GameUtilities::GameState()); //Create object containing runtime game information
 		this->_gameInformation->mouse_data_processed = 1;
 		this->_gameInformation->game = this->_offlineGameObject.get(); //Attach offline game object
@@ -226,6 +233,7 @@ bool wxAppInstance::loadZipResource(){
 			//Pass the object containing game info to the OpenGL canvas.
 			wxLogDebug(wxString::Format("[Chain-Reaction] Passing game information to the wxGLCanvas object %p ...", this->_mainFrame->canvas_panel));
 			this->_mainFrame->canvas_panel->SetClientData(this->_gameInformation.get());
+			this->_mainFrame->canvas_panel->StartRenderThread(); //The canvas is drawn from now on.
 		}
 		currentValue = progressDialog->GetValue();
 		wxLogDebug("[Chain-Reaction] All resources were processed successfully! Clearing memory allocated to the resource storage ...");